@@ -45,6 +45,8 @@
 #ifndef APE_MAIN_H
 #define APE_MAIN_H
 
+#include <APE_SHM.h>
+#include <Network.h>
 #include <types.h>
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -54,6 +56,25 @@ void RMU_init(void);
 
 void RMU_resetBadPacket(void);
 
+void RMU_initFlowControl(void);
+void RMU_updateFlowControl(void); /* Samples the RMU fifos, call once per housekeeping tick. */
+
+////////////////////////////////////////////////////////////////////////////////
+// Power Policy
+////////////////////////////////////////////////////////////////////////////////
+void Power_init(NetworkPort_t *port);
+void Power_update(NetworkPort_t *port, bool host_running); /* Switches EEE and clock profiles with the passthrough traffic, call once per housekeeping tick. */
+
+////////////////////////////////////////////////////////////////////////////////
+// Packet Handling
+////////////////////////////////////////////////////////////////////////////////
+bool handleBMCPacket(bool passthrough); /* Returns true if a frame from the BMC was consumed. */
+void drainBMCPackets(RegSHMDrainBudget_t budget);
+void drainNetworkPackets(RegSHMDrainBudget_t budget);
+
+void wait_for_all_rx(void);
+
+#ifndef CXX_SIMULATOR
 ////////////////////////////////////////////////////////////////////////////////
 // ISR
 ////////////////////////////////////////////////////////////////////////////////
@@ -84,10 +105,14 @@ void __attribute__((interrupt)) IRQ_Debug(void);
 void __attribute__((interrupt)) IRQ_PendSV(void);
 void __attribute__((interrupt)) IRQ_Systick(void);
 
+void __attribute__((interrupt)) IRQ_HostToBmc(void);
 void __attribute__((interrupt)) IRQ_RxPacketEven(void);
 void __attribute__((interrupt)) IRQ_RxPacketOdd(void);
 void __attribute__((interrupt)) IRQ_RMU(void);
 void __attribute__((interrupt)) IRQ_VoltageSource(void);
 void __attribute__((interrupt)) IRQ_PowerStatusChanged(void);
+void __attribute__((interrupt)) IRQ_LinkStatusEven(void);
+void __attribute__((interrupt)) IRQ_LinkStatusOdd(void);
+#endif /* !CXX_SIMULATOR */
 
 #endif /* APE_MAIN_H */
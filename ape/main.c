@@ -54,6 +54,7 @@
 #include <APE_SHM2.h>
 #include <APE_SHM3.h>
 #include <Ethernet.h>
+#include <MII.h>
 #include <NCSI.h>
 #include <NVRam.h>
 #include <Timer.h>
@@ -64,13 +65,51 @@
 #include <printf.h>
 #endif
 
-#define RMU_WATCHDOG_TIMEOUT_MS (10)
 #define RX_CPU_RESET_TIMEOUT_MS (1000) /* Wait up to 1 second for each RX CPU to start */
 #define GRC_RESET_TIMEOUT_MS (150)     /* Wait 150ms for the GRC reset to settle */
 
+#ifndef APE_EVENT_DRIVEN
+#define APE_EVENT_DRIVEN (1) /* Sleep with WFI until an interrupt signals pending work */
+#endif
+
+#ifndef APE_DRAIN_BUDGET_FRAMES
+#define APE_DRAIN_BUDGET_FRAMES (16) /* Frames handled per direction before servicing housekeeping */
+#endif
+
+#ifndef APE_DRAIN_BUDGET_US
+#define APE_DRAIN_BUDGET_US (500) /* Microseconds spent per direction before servicing housekeeping */
+#endif
+
+#define APE_EVENT_TICK_DIVIDER (10) /* SysTick calibration is for 10ms, run the housekeeping tick every 1ms */
+
+#ifndef APE_LINK_POLL_MS
+#define APE_LINK_POLL_MS (1000) /* Recheck every port's link state this often in case a link interrupt was missed */
+#endif
+
+// Events use the NVIC interrupt bits directly so that they can be re-armed with a single write.
+#define APE_EVENT_HOST       (NVIC_INTERRUPT_SET_ENABLE_SETENA_H2B)
+#define APE_EVENT_BMC_PACKET (NVIC_INTERRUPT_SET_ENABLE_SETENA_RMU_EGRESS)
+#define APE_EVENT_NETWORK_RX (NVIC_INTERRUPT_SET_ENABLE_SETENA_RX_PACKET_EVEN | NVIC_INTERRUPT_SET_ENABLE_SETENA_RX_PACKET_ODD)
+#define APE_EVENT_LINK       (NVIC_INTERRUPT_SET_ENABLE_SETENA_LINK_STATE_EVEN | NVIC_INTERRUPT_SET_ENABLE_SETENA_LINK_STATE_ODD)
+#define APE_EVENT_IRQS       (APE_EVENT_HOST | APE_EVENT_BMC_PACKET | APE_EVENT_NETWORK_RX | APE_EVENT_LINK)
+#define APE_EVENT_TICK       (1u << 31) /* Not an NVIC interrupt, the APE only has 30 external interrupts. */
+#define APE_EVENT_MDIO       (1u << 30) /* Not an NVIC interrupt, queued MDIO requests are pending. */
+#define APE_EVENT_ALL        (APE_EVENT_IRQS | APE_EVENT_TICK | APE_EVENT_MDIO)
+
+// The link status interrupts are shared by every other port.
+#define APE_LINK_PORTS_EVEN (0x5u) /* Ports 0 and 2 */
+#define APE_LINK_PORTS_ODD  (0xAu) /* Ports 1 and 3 */
+
 static NetworkPort_t *gPort;
 static uint32_t gResetTime;
 
+// Host driver shared memory of the function that owns each port.
+static volatile SHM_t *const gPortSHM[NETWORK_NUM_PORTS] = { &SHM, &SHM1, &SHM2, &SHM3 };
+#if APE_EVENT_DRIVEN
+static volatile uint32_t gPendingEvents;
+static uint32_t gLinkPollTime;
+#endif
+
 void handleCommand(volatile SHM_t *shm)
 {
     uint32_t command = shm->LoaderCommand.bits.Command;
@@ -141,7 +180,7 @@ void wait_for_rx(const volatile DEVICE_t *device, const volatile SHM_t *shm)
     } while (waiting);
 }
 
-void wait_for_all_rx()
+void wait_for_all_rx(void)
 {
     wait_for_rx(&DEVICE, &SHM);
     wait_for_rx(&DEVICE1, &SHM1);
@@ -149,107 +188,6 @@ void wait_for_all_rx()
     wait_for_rx(&DEVICE3, &SHM3);
 }
 
-void handleBMCPacket(bool passthrough)
-{
-    static bool packetInProgress = false;
-    static uint32_t inProgressStartTime = 0;
-    uint32_t buffer[1024];
-
-    RegAPE_PERIBmcToNcRxStatus_t stat;
-    stat.r32 = APE_PERI.BmcToNcRxStatus.r32;
-
-    if (stat.bits.New)
-    {
-        packetInProgress = false;
-        if (stat.bits.Bad)
-        {
-            // ACK bad packet.
-            RMU_resetBadPacket();
-        }
-        else
-        {
-            uint32_t bytes = stat.bits.PacketLength;
-            if (!stat.bits.Passthru)
-            {
-                uint32_t words = DIVIDE_RND_UP(bytes, sizeof(uint32_t));
-                if (words > ARRAY_ELEMENTS(buffer))
-                {
-                    // This should never happen...
-                    printf("Dropping NCSI packet\n");
-                    while (words--)
-                    {
-                        // Read out the packet, but drop it.
-                        uint32_t word = APE_PERI.BmcToNcReadBuffer.r32;
-                        (void)word;
-                    }
-                }
-                else
-                {
-                    int i = 0;
-                    while (words--)
-                    {
-                        uint32_t word = (APE_PERI.BmcToNcReadBuffer.r32);
-                        buffer[i] = word;
-                        i++;
-                    }
-
-                    NetworkFrame_t *frame = ((NetworkFrame_t *)buffer);
-
-                    handleNCSIFrame(frame);
-                }
-            }
-            else
-            {
-                // Pass through to network
-                NetworkPort_t *port = gPort;
-                ++port->shm_channel->NcsiChannelNcsiRx.r32;
-                if (port->shm_channel->NcsiChannelInfo.bits.Enabled && passthrough)
-                {
-                    if (!Network_TX_transmitPassthroughPacket(bytes, port))
-                    {
-                        printf("Resetting TX...\n");
-                        // Reset, as it's likely locked up now.
-                        wait_for_all_rx();
-                        NCSI_reload(AS_NEEDED);
-                    }
-                }
-                else
-                {
-                    printf("Dropping PT\n");
-                    uint32_t words = DIVIDE_RND_UP(bytes, sizeof(uint32_t));
-                    while (words--)
-                    {
-                        // Read out the packet, but drop it.
-                        uint32_t word = APE_PERI.BmcToNcReadBuffer.r32;
-                        (void)word;
-                    }
-                }
-            }
-        }
-    }
-    else if (stat.bits.InProgress)
-    {
-        if (packetInProgress)
-        {
-            // In some cases (RMU reset during startup w/ active communication)
-            // the RMU state machine can enter a stuck state.
-            // This can be seen as an InProgress for an unreasonable amount of time.
-            // In such a case, reset the RMU to recover.
-            if (Timer_didTimeElapsed1KHz(inProgressStartTime, RMU_WATCHDOG_TIMEOUT_MS))
-            {
-                printf("RMU Hang detected, resetting.\n");
-                RMU_init();
-                packetInProgress = false;
-            }
-        }
-        else
-        {
-            packetInProgress = true;
-            inProgressStartTime = Timer_getCurrentTime1KHz();
-        }
-    }
-}
-
 void __attribute__((interrupt)) IRQ_VoltageSource()
 {
     NVIC.InterruptClearPending.r32 = NVIC_INTERRUPT_CLEAR_PENDING_CLRPEND_VMAIN;
@@ -318,6 +256,186 @@ void __attribute__((interrupt)) IRQ_PowerStatusChanged(void)
     }
 }
 
+#if APE_EVENT_DRIVEN
+static inline void queueEvent(uint32_t event)
+{
+    // Mask the source until the main loop has serviced it, otherwise level
+    // triggered sources would immediately re-enter the handler.
+    NVIC.InterruptClearEnable.r32 = event;
+    NVIC.InterruptClearPending.r32 = event;
+
+    gPendingEvents |= event;
+}
+
+void __attribute__((interrupt)) IRQ_HostToBmc(void)
+{
+    queueEvent(APE_EVENT_HOST);
+}
+
+void __attribute__((interrupt)) IRQ_RMU(void)
+{
+    queueEvent(APE_EVENT_BMC_PACKET);
+}
+
+void __attribute__((interrupt)) IRQ_RxPacketEven(void)
+{
+    queueEvent(NVIC_INTERRUPT_SET_ENABLE_SETENA_RX_PACKET_EVEN);
+}
+
+void __attribute__((interrupt)) IRQ_RxPacketOdd(void)
+{
+    queueEvent(NVIC_INTERRUPT_SET_ENABLE_SETENA_RX_PACKET_ODD);
+}
+
+void __attribute__((interrupt)) IRQ_LinkStatusEven(void)
+{
+    queueEvent(NVIC_INTERRUPT_SET_ENABLE_SETENA_LINK_STATE_EVEN);
+}
+
+void __attribute__((interrupt)) IRQ_LinkStatusOdd(void)
+{
+    queueEvent(NVIC_INTERRUPT_SET_ENABLE_SETENA_LINK_STATE_ODD);
+}
+
+void __attribute__((interrupt)) IRQ_Systick(void)
+{
+    // The housekeeping tick catches anything without a dedicated interrupt:
+    // mailbox commands, APE mode changes and the RMU watchdog.
+    gPendingEvents |= APE_EVENT_TICK;
+}
+
+void initEvents(void)
+{
+    RegNVICSystickControlAndStatus_t systick;
+    uint32_t reload = NVIC.SystickCalibrationValue.bits.TENMS / APE_EVENT_TICK_DIVIDER;
+    if (!reload)
+    {
+        // No calibration value, use the longest period available.
+        reload = NVIC_SYSTICK_RELOAD_VALUE_RELOAD_MASK;
+    }
+
+    NVIC.SystickReloadValue.r32 = reload;
+    NVIC.SystickCurrentValue.r32 = 0;
+
+    systick.r32 = 0;
+    systick.bits.CLKSOURCE = 1;
+    systick.bits.TICKINT = 1;
+    systick.bits.ENABLE = 1;
+    NVIC.SystickControlAndStatus.r32 = systick.r32;
+
+    gPendingEvents = APE_EVENT_ALL;
+    gLinkPollTime = Timer_getCurrentTime1KHz();
+    NVIC.InterruptClearPending.r32 = APE_EVENT_IRQS;
+}
+
+uint32_t waitForEvents(void)
+{
+    uint32_t events;
+
+    __asm__ volatile("cpsid i" ::: "memory");
+    if (!gPendingEvents)
+    {
+        // Any pending interrupt wakes the core, even while masked.
+        __asm__ volatile("wfi" ::: "memory");
+    }
+    __asm__ volatile("cpsie i" ::: "memory");
+
+    // Let the pending ISR(s) run before sampling the event mask.
+    __asm__ volatile("cpsid i" ::: "memory");
+    events = gPendingEvents;
+    gPendingEvents = 0;
+    __asm__ volatile("cpsie i" ::: "memory");
+
+    if (events & APE_EVENT_TICK)
+    {
+        // Link changes have their own interrupts, only fall back to polling them occasionally.
+        events |= APE_EVENT_ALL & ~APE_EVENT_LINK;
+
+        if (Timer_didTimeElapsed1KHz(gLinkPollTime, APE_LINK_POLL_MS))
+        {
+            gLinkPollTime = Timer_getCurrentTime1KHz();
+            events |= APE_EVENT_LINK;
+        }
+    }
+
+    return events;
+}
+
+void rearmEvents(uint32_t events)
+{
+    uint32_t busy = 0;
+
+    // Keep polling sources that still have work queued instead of sleeping.
+    if ((events & APE_EVENT_BMC_PACKET) && APE_PERI.BmcToNcRxStatus.bits.New)
+    {
+        busy |= APE_EVENT_BMC_PACKET;
+    }
+
+    // Frames for channels the BMC has not readied stay in their pool, they are not work.
+    if ((events & APE_EVENT_NETWORK_RX) && NCSI_passthroughPending())
+    {
+        busy |= (events & APE_EVENT_NETWORK_RX);
+    }
+
+    if (!MII_isIdle())
+    {
+        // MDIO transactions complete without an interrupt, keep polling until the queue drains.
+        busy |= APE_EVENT_MDIO;
+    }
+
+    if (busy)
+    {
+        __asm__ volatile("cpsid i" ::: "memory");
+        gPendingEvents |= busy;
+        __asm__ volatile("cpsie i" ::: "memory");
+    }
+
+    NVIC.InterruptSetEnable.r32 = events & ~busy & APE_EVENT_IRQS;
+}
+#else
+void initEvents(void)
+{
+}
+
+uint32_t waitForEvents(void)
+{
+    return APE_EVENT_ALL;
+}
+
+void rearmEvents(uint32_t events)
+{
+    (void)events;
+}
+#endif
+
+void handleLinkEvents(uint32_t events)
+{
+    uint32_t pending = 0;
+
+    if (events & NVIC_INTERRUPT_SET_ENABLE_SETENA_LINK_STATE_EVEN)
+    {
+        pending |= APE_LINK_PORTS_EVEN;
+    }
+
+    if (events & NVIC_INTERRUPT_SET_ENABLE_SETENA_LINK_STATE_ODD)
+    {
+        pending |= APE_LINK_PORTS_ODD;
+    }
+
+    // Only touch the EMAC status of ports that share the interrupt that fired.
+    for (int i = 0; i < NETWORK_NUM_PORTS; i++)
+    {
+        if (pending & (1u << i))
+        {
+            NetworkPort_t *port = Network_getPort(i);
+            if (Network_checkPortState(port))
+            {
+                NCSI_sendLinkStatusAEN(port);
+            }
+        }
+    }
+}
+
 void initSHM(volatile SHM_t *shm)
 {
     RegSHMFwStatus_t status;
@@ -335,10 +453,65 @@ void initSHM(volatile SHM_t *shm)
     shm->SegSig.r32 = 'APE!'; //lint !e742
 }
 
+static bool isHostRunning(int i)
+{
+    return SHM_HOST_DRIVER_STATE_STATE_START == gPortSHM[i]->HostDriverState.bits.State;
+}
+
+static void handleHostState(int i, uint32_t *host_state, bool *reset_allowed)
+{
+    NetworkPort_t *port = Network_getPort(i);
+    uint32_t state = gPortSHM[i]->HostDriverState.bits.State;
+
+    if (*host_state != state)
+    {
+        *host_state = state;
+
+        if (SHM_HOST_DRIVER_STATE_STATE_START == state)
+        {
+            printf("[port %d] host started\n", i);
+
+            *reset_allowed = true;
+            NCSI_sendHostDriverStatusAEN(port, true);
+        }
+        else
+        {
+            if (SHM_HOST_DRIVER_STATE_STATE_UNLOAD == state)
+            {
+                printf("[port %d] host unloaded.\n", i);
+            }
+            else
+            {
+                printf("[port %d] wol?\n", i);
+            }
+
+            *reset_allowed = false;
+            NCSI_sendHostDriverStatusAEN(port, false);
+        }
+    }
+    else if (*reset_allowed && !Network_checkEnableState(port) && !gResetTime)
+    {
+        printf("[port %d] APE mode change, resetting.\n", i);
+        wait_for_rx(port->device, gPortSHM[i]);
+        NCSI_reloadPort(port, AS_NEEDED);
+
+        // Update host state to make sure we don't reset twice if it's changed.
+        *host_state = gPortSHM[i]->HostDriverState.bits.State;
+
+        *reset_allowed = false;
+    }
+}
+
 void __attribute__((noreturn)) loaderLoop(void)
 {
-    uint32_t host_state = SHM.HostDriverState.bits.State;
-    bool reset_allowed = host_state == SHM_HOST_DRIVER_STATE_STATE_START;
+    uint32_t host_state[NETWORK_NUM_PORTS];
+    bool reset_allowed[NETWORK_NUM_PORTS];
+
+    for (int i = 0; i < NETWORK_NUM_PORTS; i++)
+    {
+        host_state[i] = gPortSHM[i]->HostDriverState.bits.State;
+        reset_allowed[i] = isHostRunning(i);
+    }
 
     // Update SHM.Sig to signal ready.
     SHM.SegSig.bits.Sig = SHM_SEG_SIG_SIG_LOADER;
@@ -347,13 +520,28 @@ void __attribute__((noreturn)) loaderLoop(void)
     initSHM(&SHM2);
     initSHM(&SHM3);
 
+    RegSHMDrainBudget_t budget;
+    budget.r32 = 0;
+    budget.bits.Frames = APE_DRAIN_BUDGET_FRAMES;
+    budget.bits.Time = APE_DRAIN_BUDGET_US;
+    SHM.DrainBudget.r32 = budget.r32;
+    SHM.DrainBmcExhausted.r32 = 0;
+    SHM.DrainNetworkExhausted.r32 = 0;
+    RMU_initFlowControl();
+    Power_init(gPort);
+
+    initEvents();
+
     // Enable GRC Reset / Power Status Changed and Vsrc interrupts
     NVIC.InterruptSetEnable.r32 = NVIC_INTERRUPT_SET_ENABLE_SETENA_VMAIN | NVIC_INTERRUPT_SET_ENABLE_SETENA_GENERAL_RESET;
 
     for (;;)
     {
+        uint32_t events;
         if (gResetTime)
         {
+            // Poll until the reset has settled.
+            events = APE_EVENT_ALL;
             RegAPEStatus_t status = APE.Status;
             RegAPEStatus2_t status2 = APE.Status2;
 
@@ -388,56 +576,67 @@ void __attribute__((noreturn)) loaderLoop(void)
                 NVIC.InterruptSetEnable.r32 = NVIC_INTERRUPT_SET_ENABLE_SETENA_GENERAL_RESET;
             }
 
-            handleBMCPacket(false);
+            (void)handleBMCPacket(false);
         }
         else
         {
-            Network_checkPortState(gPort);
+            events = waitForEvents();
+
+            if (events & APE_EVENT_LINK)
+            {
+                handleLinkEvents(events);
+            }
 
-            handleBMCPacket(true);
-            NCSI_handlePassthrough();
+            // Re-read every pass so the host can tune the budget at runtime.
+            RegSHMDrainBudget_t budget = SHM.DrainBudget;
 
-            if (host_state != SHM.HostDriverState.bits.State)
+            if (events & APE_EVENT_BMC_PACKET)
             {
-                host_state = SHM.HostDriverState.bits.State;
+                drainBMCPackets(budget);
+            }
 
-                if (SHM_HOST_DRIVER_STATE_STATE_START == host_state)
-                {
-                    printf("host started\n");
+            if (events & APE_EVENT_NETWORK_RX)
+            {
+                drainNetworkPackets(budget);
+            }
 
-                    reset_allowed = true;
-                }
-                else
+            if (events & APE_EVENT_TICK)
+            {
+                // Prefetch TX blocks while idle so transmits skip the allocator round trips.
+                for (int i = 0; i < NETWORK_NUM_PORTS; i++)
                 {
-                    if (SHM_HOST_DRIVER_STATE_STATE_UNLOAD == host_state)
-                    {
-                        printf("host unloaded.\n");
-                    }
-                    else
-                    {
-                        printf("wol?\n");
-                    }
-
-                    reset_allowed = false;
+                    Network_TX_refillBlocks(Network_getPort(i));
                 }
+
+                RMU_updateFlowControl();
+                Power_update(gPort, SHM_HOST_DRIVER_STATE_STATE_START == host_state[NETWORK_PORT]);
             }
-            else if (reset_allowed && !Network_checkEnableState(gPort) && !gResetTime)
+
+            if (events & APE_EVENT_HOST)
             {
-                printf("APE mode change, resetting.\n");
-                wait_for_all_rx();
-                NCSI_reload(AS_NEEDED);
+                // Each function's host driver only owns its own port, the other channels carry on undisturbed.
+                for (int i = 0; i < NETWORK_NUM_PORTS; i++)
+                {
+                    handleHostState(i, &host_state[i], &reset_allowed[i]);
+                }
+            }
+        }
 
-                // Update host state to make sure we don't reset twice if it's changed.
-                host_state = SHM.HostDriverState.bits.State;
+        if (events & APE_EVENT_MDIO)
+        {
+            // Advance queued PHY accesses such as link resets without blocking packet passthrough.
+            (void)MII_processQueue();
+        }
 
-                reset_allowed = false;
-            }
+        if (events & APE_EVENT_HOST)
+        {
+            handleCommand(&SHM);
+            handleCommand(&SHM1);
+            handleCommand(&SHM2);
+            handleCommand(&SHM3);
         }
 
-        handleCommand(&SHM);
-        handleCommand(&SHM1);
-        handleCommand(&SHM2);
-        handleCommand(&SHM3);
+        rearmEvents(events);
     }
 }
 
@@ -450,6 +649,13 @@ bool handle_reset(void)
         RegAPEGpio_t apegpio;
         apegpio.r32 = APE.Gpio.r32;
 
+        // Stop queued PHY accesses first, they would otherwise carry on without the lock.
+        MII_abortQueue();
+        for (int i = 0; i < NETWORK_NUM_PORTS; i++)
+        {
+            Network_abortLinkReset(Network_getPort(i));
+        }
+
         // Release all locks to ensure that the RX CPU will be able to boot up
         NVRam_releaseAllLocks();
         APE_releaseAllLocks();
@@ -520,7 +726,11 @@ void __attribute__((noreturn)) __start()
     printf("APE v" STRINGIFY(VERSION_MAJOR) "." STRINGIFY(VERSION_MINOR) "." STRINGIFY(VERSION_PATCH) " NCSI Port " STRINGIFY(NETWORK_PORT) "\n");
     gPort = Network_getPort(NETWORK_PORT);
 
-    NCSI_usePort(gPort);
+    // Each port is exposed as the NC-SI channel with the same number.
+    for (int i = 0; i < NETWORK_NUM_PORTS; i++)
+    {
+        NCSI_usePort(Network_getPort(i));
+    }
 
     RMU_init();
 
@@ -532,7 +742,20 @@ void __attribute__((noreturn)) __start()
     else
     {
         printf("APE Reload.\n");
-        NCSI_reload(SHM_HOST_DRIVER_STATE_STATE_START != SHM.HostDriverState.bits.State ? AS_NEEDED : NEVER_RESET);
+    }
+
+    // Leave the PHY alone on ports whose host driver is running.
+    for (int i = 0; i < NETWORK_NUM_PORTS; i++)
+    {
+        reload_type_t reset_phy = isHostRunning(i) ? NEVER_RESET : AS_NEEDED;
+        if (full_init)
+        {
+            NCSI_initPort(Network_getPort(i), reset_phy);
+        }
+        else
+        {
+            NCSI_reloadPort(Network_getPort(i), reset_phy);
+        }
     }
 
     loaderLoop();
@@ -0,0 +1,229 @@
+////////////////////////////////////////////////////////////////////////////////
+///
+/// @file       packet.c
+///
+/// @project
+///
+/// @brief      Packet handling between the BMC and the network ports.
+///
+////////////////////////////////////////////////////////////////////////////////
+///
+////////////////////////////////////////////////////////////////////////////////
+///
+/// @copyright Copyright (c) 2018-2020, Evan Lojewski
+/// @cond
+///
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+/// 1. Redistributions of source code must retain the above copyright notice,
+/// this list of conditions and the following disclaimer.
+/// 2. Redistributions in binary form must reproduce the above copyright notice,
+/// this list of conditions and the following disclaimer in the documentation
+/// and/or other materials provided with the distribution.
+/// 3. Neither the name of the copyright holder nor the
+/// names of its contributors may be used to endorse or promote products
+/// derived from this software without specific prior written permission.
+///
+////////////////////////////////////////////////////////////////////////////////
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+/// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+/// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+/// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+/// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+/// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+/// POSSIBILITY OF SUCH DAMAGE.
+/// @endcond
+////////////////////////////////////////////////////////////////////////////////
+
+#include <APE_APE_PERI.h>
+#include <APE_SHM.h>
+#include <Ethernet.h>
+#include <NCSI.h>
+#include <Network.h>
+#include <Timer.h>
+#include <ape_main.h>
+
+#ifdef CXX_SIMULATOR
+#include <stdio.h>
+#else
+#include <printf.h>
+#endif
+
+#define RMU_WATCHDOG_TIMEOUT_MS (10)
+
+bool handleBMCPacket(bool passthrough)
+{
+    static bool packetInProgress = false;
+    static uint32_t inProgressStartTime = 0;
+    uint32_t buffer[DIVIDE_RND_UP(NCSI_MAX_COMMAND_LENGTH, sizeof(uint32_t))];
+    bool handled = false;
+
+    RegAPE_PERIBmcToNcRxStatus_t stat;
+    stat.r32 = APE_PERI.BmcToNcRxStatus.r32;
+
+    if (stat.bits.New)
+    {
+        // The command trace measures from when the frame was seen, not from when it was read in.
+        uint32_t start = Timer_getCurrentTime1MHz();
+        handled = true;
+        packetInProgress = false;
+        if (stat.bits.Bad)
+        {
+            // ACK bad packet.
+            RMU_resetBadPacket();
+        }
+        else
+        {
+            uint32_t bytes = stat.bits.PacketLength;
+            if (!stat.bits.Passthru)
+            {
+                uint32_t words = DIVIDE_RND_UP(bytes, sizeof(uint32_t));
+                uint32_t needed = MIN(words, NCSI_HEADER_WORDS);
+                uint32_t i = 0;
+                NetworkFrame_t *frame = ((NetworkFrame_t *)buffer);
+
+                // Read the header first, it determines how much of the payload is used.
+                while (i < needed)
+                {
+                    buffer[i++] = APE_PERI.BmcToNcReadBuffer.r32;
+                }
+
+                if (i == NCSI_HEADER_WORDS)
+                {
+                    needed = MIN(words, DIVIDE_RND_UP(NCSI_getCommandLength(frame), sizeof(uint32_t)));
+                    while (i < needed)
+                    {
+                        buffer[i++] = APE_PERI.BmcToNcReadBuffer.r32;
+                    }
+                }
+
+                while (i < words)
+                {
+                    // Drain the remainder (padding, checksum, FCS) without storing it.
+                    uint32_t word = APE_PERI.BmcToNcReadBuffer.r32;
+                    (void)word;
+                    i++;
+                }
+
+                if (needed >= NCSI_HEADER_WORDS)
+                {
+                    handleNCSIFrame(frame, start);
+                }
+                else
+                {
+                    printf("Dropping NCSI packet\n");
+                }
+            }
+            else
+            {
+                // Pass through to network
+                NetworkPort_t *port = NCSI_getPassthroughPort();
+                if (port)
+                {
+                    ++port->shm_channel->NcsiChannelNcsiRx.r32;
+                }
+
+                // PacketLength is 11 bits, every frame the RMU can report fits in the TX pool.
+                if (port && passthrough)
+                {
+                    if (TX_PASSTHROUGH_LOCKED_UP == Network_TX_transmitPassthroughPacket(bytes, port))
+                    {
+                        printf("Resetting TX...\n");
+                        // Only the TX pool of this port is stuck, running out of blocks is not a lockup.
+                        Network_resetTX(port, ALWAYS_RESET);
+                    }
+                }
+                else
+                {
+                    printf("Dropping PT\n");
+                    if (port)
+                    {
+                        ++port->shm_channel->NcsiChannelNcsiDropped.r32;
+                    }
+                    uint32_t words = DIVIDE_RND_UP(bytes, sizeof(uint32_t));
+                    while (words--)
+                    {
+                        // Read out the packet, but drop it.
+                        uint32_t word = APE_PERI.BmcToNcReadBuffer.r32;
+                        (void)word;
+                    }
+                }
+            }
+        }
+    }
+    else if (stat.bits.InProgress)
+    {
+        if (packetInProgress)
+        {
+            // In some cases (RMU reset during startup w/ active communication)
+            // the RMU state machine can enter a stuck state.
+            // This can be seen as an InProgress for an unreasonable amount of time.
+            // In such a case, reset the RMU to recover.
+            if (Timer_didTimeElapsed1KHz(inProgressStartTime, RMU_WATCHDOG_TIMEOUT_MS))
+            {
+                printf("RMU Hang detected, resetting.\n");
+                RMU_init();
+                packetInProgress = false;
+            }
+        }
+        else
+        {
+            packetInProgress = true;
+            inProgressStartTime = Timer_getCurrentTime1KHz();
+        }
+    }
+
+    return handled;
+}
+
+static inline bool drainBudgetExhausted(RegSHMDrainBudget_t budget, uint32_t frames, uint32_t start)
+{
+    return (frames >= budget.bits.Frames) || ((Timer_getCurrentTime1MHz() - start) >= budget.bits.Time);
+}
+
+void drainBMCPackets(RegSHMDrainBudget_t budget)
+{
+    uint32_t start = Timer_getCurrentTime1MHz();
+    uint32_t frames = 0;
+
+    while (handleBMCPacket(true))
+    {
+        if (drainBudgetExhausted(budget, ++frames, start))
+        {
+            if (APE_PERI.BmcToNcRxStatus.bits.New)
+            {
+                // Work left over, the next pass picks it up after housekeeping.
+                ++SHM.DrainBmcExhausted.r32;
+            }
+            break;
+        }
+    }
+}
+
+void drainNetworkPackets(RegSHMDrainBudget_t budget)
+{
+    uint32_t start = Timer_getCurrentTime1MHz();
+    uint32_t frames = 0;
+    unsigned int delivered;
+
+    while ((delivered = NCSI_handlePassthrough()))
+    {
+        frames += delivered;
+        if (drainBudgetExhausted(budget, frames, start))
+        {
+            if (NCSI_passthroughPending())
+            {
+                // Work left over, the next pass picks it up after housekeeping.
+                ++SHM.DrainNetworkExhausted.r32;
+            }
+            break;
+        }
+    }
+}
@@ -0,0 +1,181 @@
+////////////////////////////////////////////////////////////////////////////////
+///
+/// @file       power.c
+///
+/// @project
+///
+/// @brief      EEE and clock policy for the management port.
+///
+////////////////////////////////////////////////////////////////////////////////
+///
+////////////////////////////////////////////////////////////////////////////////
+///
+/// @copyright Copyright (c) 2018-2020, Evan Lojewski
+/// @cond
+///
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+/// 1. Redistributions of source code must retain the above copyright notice,
+/// this list of conditions and the following disclaimer.
+/// 2. Redistributions in binary form must reproduce the above copyright notice,
+/// this list of conditions and the following disclaimer in the documentation
+/// and/or other materials provided with the distribution.
+/// 3. Neither the name of the copyright holder nor the
+/// names of its contributors may be used to endorse or promote products
+/// derived from this software without specific prior written permission.
+///
+////////////////////////////////////////////////////////////////////////////////
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+/// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+/// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+/// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+/// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+/// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+/// POSSIBILITY OF SUCH DAMAGE.
+/// @endcond
+////////////////////////////////////////////////////////////////////////////////
+
+#include <APE_SHM.h>
+#include <Network.h>
+#include <Timer.h>
+#include <ape_main.h>
+
+#define POWER_SAMPLE_MS     (100)  /* Passthrough traffic is sampled over this window. */
+#define POWER_ACTIVE_FRAMES (4)    /* Frames per sample that select the low latency profile. */
+#define POWER_IDLE_MS       (2000) /* Time below POWER_ACTIVE_FRAMES before saving power again. */
+
+/*
+ * Like the SHM.PowerPolicy registers, the policy covers the NC-SI port only. The other channels keep the
+ * Network_InitPort profile (NETWORK_POWER_IDLE), which is safe at any link speed.
+ */
+static network_power_profile_t gPowerProfile = NETWORK_POWER_IDLE;
+static uint32_t gPowerSampleTime;
+static uint32_t gPowerActiveTime;
+static uint32_t gPowerFrames;
+
+static uint32_t Power_getFrames(NetworkPort_t *port)
+{
+    return port->shm_channel->NcsiChannelNetworkRx.r32 + port->shm_channel->NcsiChannelNetworkTx.r32;
+}
+
+static bool Power_isGigabit(NetworkPort_t *port)
+{
+    RegMIIAuxiliaryStatusSummary_t status;
+    int32_t reg = Network_getLinkStatus(port);
+    if (reg < 0)
+    {
+        // Unknown, assume the link may come up at 1000Mb/s.
+        return true;
+    }
+
+    status.r16 = (uint16_t)reg;
+    switch ((uint8_t)status.bits.AutoNegotiationHCD)
+    {
+        case MII_AUXILIARY_STATUS_SUMMARY_AUTO_NEGOTIATION_HCD_10BASE_T_HALF_DUPLEX:
+        case MII_AUXILIARY_STATUS_SUMMARY_AUTO_NEGOTIATION_HCD_10BASE_T_FULL_DUPLEX:
+        case MII_AUXILIARY_STATUS_SUMMARY_AUTO_NEGOTIATION_HCD_100BASE_TX_HALF_DUPLEX:
+        case MII_AUXILIARY_STATUS_SUMMARY_AUTO_NEGOTIATION_HCD_100BASE_T4:
+        case MII_AUXILIARY_STATUS_SUMMARY_AUTO_NEGOTIATION_HCD_100BASE_TX_FULL_DUPLEX:
+            return false;
+
+        default:
+            // 1000Mb/s, or no link yet. Autonegotiation may pick 1000Mb/s at any time.
+            return true;
+    }
+}
+
+static void Power_exportPolicy(bool manual)
+{
+    RegSHMPowerPolicy_t policy;
+    policy.r32 = 0;
+    policy.bits.Profile = gPowerProfile;
+    policy.bits.Manual = manual;
+    SHM.PowerPolicy.r32 = policy.r32;
+}
+
+static void Power_setProfile(NetworkPort_t *port, network_power_profile_t profile)
+{
+    if (NETWORK_POWER_DEEP == profile && Power_isGigabit(port))
+    {
+        // 1000Mb/s mode only works if D0u is 0 when the host is off.
+        profile = NETWORK_POWER_IDLE;
+    }
+
+    if (profile != gPowerProfile)
+    {
+        gPowerProfile = profile;
+        Network_setPowerProfile(port, profile);
+        ++SHM.PowerPolicySwitches.r32;
+    }
+}
+
+void Power_init(NetworkPort_t *port)
+{
+    // Network_InitPort always starts with EEE LPI on and the full D0u clock.
+    gPowerProfile = NETWORK_POWER_IDLE;
+    gPowerSampleTime = Timer_getCurrentTime1KHz();
+    gPowerActiveTime = gPowerSampleTime;
+    gPowerFrames = Power_getFrames(port);
+
+    Power_exportPolicy(false);
+    SHM.PowerPolicySwitches.r32 = 0;
+    for (int i = 0; i < (int)ARRAY_ELEMENTS(SHM.PowerPolicyTime); i++)
+    {
+        SHM.PowerPolicyTime[i].r32 = 0;
+    }
+}
+
+void Power_update(NetworkPort_t *port, bool host_running)
+{
+    if (!Timer_didTimeElapsed1KHz(gPowerSampleTime, POWER_SAMPLE_MS))
+    {
+        return;
+    }
+
+    uint32_t now = Timer_getCurrentTime1KHz();
+    SHM.PowerPolicyTime[gPowerProfile].r32 += now - gPowerSampleTime;
+    gPowerSampleTime = now;
+
+    uint32_t frames = Power_getFrames(port);
+    // The counters restart from 0 when the channel is reset.
+    uint32_t sample = (frames >= gPowerFrames) ? (frames - gPowerFrames) : frames;
+    gPowerFrames = frames;
+
+    if (sample >= POWER_ACTIVE_FRAMES)
+    {
+        gPowerActiveTime = now;
+    }
+
+    RegSHMPowerPolicy_t policy;
+    policy.r32 = SHM.PowerPolicy.r32;
+    if (policy.bits.Manual)
+    {
+        uint32_t profile = policy.bits.Profile;
+        Power_setProfile(port, (network_power_profile_t)(profile > NETWORK_POWER_DEEP ? NETWORK_POWER_DEEP : profile));
+    }
+    else if (host_running)
+    {
+        // Hand the port back in the Network_InitPort state, the host driver programs EEE itself while it is loaded.
+        // Only changes are written, so the driver's own settings are left alone afterwards.
+        Power_setProfile(port, NETWORK_POWER_IDLE);
+    }
+    else if (sample >= POWER_ACTIVE_FRAMES)
+    {
+        // Passthrough traffic, avoid the LPI exit time on every frame.
+        Power_setProfile(port, NETWORK_POWER_ACTIVE);
+    }
+    else if (Timer_didTimeElapsed1KHz(gPowerActiveTime, POWER_IDLE_MS))
+    {
+        // Re-evaluated every sample, so a link that renegotiates at 1000Mb/s drops back to the full D0u clock.
+        Power_setProfile(port, NETWORK_POWER_DEEP);
+    }
+
+    Power_exportPolicy(policy.bits.Manual);
+}
@@ -44,17 +44,127 @@
 
 #include <APE_APE.h>
 #include <APE_APE_PERI.h>
+#include <APE_SHM.h>
 #include <Network.h>
 #include <Timer.h>
 #include <ape_main.h>
 
-#ifndef CXX_SIMULATOR
+#ifdef CXX_SIMULATOR
+#include <stdio.h>
+#else
 #include <ape_console.h>
 #include <printf.h>
 #endif
 
 #define RMU_RESET_TIMEOUT_MS (2000) /* Allow up to two seconds for a bad packet to be reset. */
 
+#define RMU_RX_CONTROL_XON_SHIFT (11) /* Undocumented XON_THRESHOLD field in BmcToNcRxControl */
+
+#define RMU_FLOW_HWM_DEFAULT (0x240)
+#define RMU_FLOW_XON_DEFAULT (0x1F)   /* Historically written as 0x201F << 11, the top bit landed on FlowControl. */
+#define RMU_FLOW_HWM_MIN     (0x100)
+#define RMU_FLOW_HWM_MAX     (0x600)  /* Keep room for a full frame above the HWM. */
+#define RMU_FLOW_HWM_STEP    (0x40)
+#define RMU_FLOW_XON_MIN     (0x10)
+#define RMU_FLOW_WINDOW      (100)    /* Housekeeping samples per adjustment, 100ms */
+#define RMU_FLOW_PRESSURE    (RMU_FLOW_WINDOW / 4) /* Backlog samples per window that count as sustained pressure */
+
+static uint32_t gFlowHWM = RMU_FLOW_HWM_DEFAULT;
+static uint32_t gFlowXON = RMU_FLOW_XON_DEFAULT;
+static uint32_t gFlowSamples;
+static uint32_t gFlowBacklog;
+static uint32_t gFlowTxMinFree = 0xFFFFFFFF;
+
+static void RMU_programFlowControl(void)
+{
+    RegAPE_PERIBmcToNcRxControl_t rxControl;
+    rxControl.r32 = 0;
+    rxControl.bits.FlowControl = 1;
+    rxControl.bits.HWM = gFlowHWM;
+    rxControl.r32 |= (gFlowXON << RMU_RX_CONTROL_XON_SHIFT); /* XON_THRESHOLD */
+    APE_PERI.BmcToNcRxControl = rxControl;
+}
+
+static void RMU_exportFlowControl(bool manual)
+{
+    RegSHMRmuFlowControl_t flow;
+    flow.r32 = 0;
+    flow.bits.HWM = gFlowHWM;
+    flow.bits.XON = gFlowXON;
+    flow.bits.Manual = manual;
+    SHM.RmuFlowControl.r32 = flow.r32;
+}
+
+/* XON for an automatically selected HWM, keeping the default XON to HWM ratio. */
+static inline uint32_t RMU_flowXON(uint32_t hwm)
+{
+    return (hwm * RMU_FLOW_XON_DEFAULT) / RMU_FLOW_HWM_DEFAULT;
+}
+
+static void RMU_setFlowControl(uint32_t hwm, uint32_t xon)
+{
+    hwm = MIN(MAX(hwm, RMU_FLOW_HWM_MIN), RMU_FLOW_HWM_MAX);
+    // XON may be at most half of the HWM, so PAUSE does not toggle on every frame.
+    xon = MIN(MAX(xon, RMU_FLOW_XON_MIN), hwm / 2);
+
+    if (hwm != gFlowHWM || xon != gFlowXON)
+    {
+        gFlowHWM = hwm;
+        gFlowXON = xon;
+        RMU_programFlowControl();
+        ++SHM.RmuFlowAdjustments.r32;
+    }
+}
+
+void RMU_initFlowControl(void)
+{
+    RMU_exportFlowControl(false);
+    SHM.RmuRxBacklog.r32 = 0;
+    SHM.RmuFlowAdjustments.r32 = 0;
+    SHM.RmuTxFifoMinFree.r32 = APE_PERI.BmcToNcTxStatus.bits.InFifo;
+}
+
+void RMU_updateFlowControl(void)
+{
+    if (APE_PERI.BmcToNcRxStatus.bits.New)
+    {
+        // A frame is still queued after the drain, the BMC is ahead of us.
+        ++gFlowBacklog;
+        ++SHM.RmuRxBacklog.r32;
+    }
+    gFlowTxMinFree = MIN(gFlowTxMinFree, (uint32_t)APE_PERI.BmcToNcTxStatus.bits.InFifo);
+
+    if (++gFlowSamples < RMU_FLOW_WINDOW)
+    {
+        return;
+    }
+
+    RegSHMRmuFlowControl_t flow;
+    flow.r32 = SHM.RmuFlowControl.r32;
+    if (flow.bits.Manual)
+    {
+        RMU_setFlowControl(flow.bits.HWM, flow.bits.XON);
+    }
+    else if (gFlowBacklog >= RMU_FLOW_PRESSURE)
+    {
+        // Sustained backlog keeps the fifo near the HWM. Raise it so PAUSE is sent less often.
+        RMU_setFlowControl(gFlowHWM + RMU_FLOW_HWM_STEP, RMU_flowXON(gFlowHWM + RMU_FLOW_HWM_STEP));
+    }
+    else if (!gFlowBacklog && gFlowHWM > RMU_FLOW_HWM_DEFAULT)
+    {
+        // Idle window, drift back to the conservative default.
+        uint32_t hwm = MAX(gFlowHWM - RMU_FLOW_HWM_STEP, RMU_FLOW_HWM_DEFAULT);
+        RMU_setFlowControl(hwm, RMU_flowXON(hwm));
+    }
+
+    RMU_exportFlowControl(flow.bits.Manual);
+    SHM.RmuTxFifoMinFree.r32 = gFlowTxMinFree;
+
+    gFlowSamples = 0;
+    gFlowBacklog = 0;
+    gFlowTxMinFree = 0xFFFFFFFF;
+}
+
 void RMU_init(void)
 {
     RegAPEMode_t mode;
@@ -84,17 +194,13 @@ void RMU_init(void)
     rmuControl.r32 |= (1 << 19) | (1 << 20);
     APE_PERI.RmuControl = rmuControl;
 
-    // Set REG_APE__BMC_NC_RX_CONTROL to FLOW_CONTROL=0 or 1, HWM=0x240,
-    // XON_THRESHOLD=0x201F. Note: FLOW_CONTROL=1 enables the hardware to
+    // Set REG_APE__BMC_NC_RX_CONTROL to FLOW_CONTROL=0 or 1, HWM and
+    // XON_THRESHOLD. Note: FLOW_CONTROL=1 enables the hardware to
     // automatically send PAUSE frames to the BMC. tcpdump can detect these, so
     // keeping flow control on gives you a way to detect when the RX state
-    // machine has gotten wedged.
-    RegAPE_PERIBmcToNcRxControl_t rxControl;
-    rxControl.r32 = 0;
-    rxControl.bits.FlowControl = 1;
-    rxControl.bits.HWM = 0x240;
-    rxControl.r32 |= (0x201F << 11); /* XON_THRESHOLD */
-    APE_PERI.BmcToNcRxControl = rxControl;
+    // machine has gotten wedged. The thresholds start at HWM=0x240, XON=0x1F
+    // and are adapted by RMU_updateFlowControl.
+    RMU_programFlowControl();
 
     // Set REG_APE__NC_BMC_TX_CONTROL to 0.
     RegAPE_PERIBmcToNcTxControl_t txControl;
@@ -66,11 +66,14 @@ void __attribute__((interrupt)) IRQ_Debug(void) __attribute__((weak, alias("IRQ_
 void __attribute__((interrupt)) IRQ_PendSV(void) __attribute__((weak, alias("IRQ_Default")));               //lint !e762
 void __attribute__((interrupt)) IRQ_Systick(void) __attribute__((weak, alias("IRQ_Default")));              //lint !e762
 
+void __attribute__((interrupt)) IRQ_HostToBmc(void) __attribute__((weak, alias("IRQ_Default")));          //lint !e762
 void __attribute__((interrupt)) IRQ_RxPacketEven(void) __attribute__((weak, alias("IRQ_Default")));       //lint !e762
 void __attribute__((interrupt)) IRQ_RxPacketOdd(void) __attribute__((weak, alias("IRQ_Default")));        //lint !e762
 void __attribute__((interrupt)) IRQ_RMU(void) __attribute__((weak, alias("IRQ_Default")));                //lint !e762
 void __attribute__((interrupt)) IRQ_VoltageSource(void) __attribute__((weak, alias("IRQ_Default")));      //lint !e762
 void __attribute__((interrupt)) IRQ_PowerStatusChanged(void) __attribute__((weak, alias("IRQ_Default"))); //lint !e762
+void __attribute__((interrupt)) IRQ_LinkStatusEven(void) __attribute__((weak, alias("IRQ_Default")));     //lint !e762
+void __attribute__((interrupt)) IRQ_LinkStatusOdd(void) __attribute__((weak, alias("IRQ_Default")));      //lint !e762
 
 //lint -esym(714, gVectors) // Referenced by linker script
 vector_table_t gVectors __attribute__((section(".init"))) = {
@@ -101,7 +104,7 @@ vector_table_t gVectors __attribute__((section(".init"))) = {
         [0x13] = IRQ_Default,               /* -- */
         [0x14] = IRQ_Default,               /* -- */
         [0x15] = IRQ_Default,               /* -- */
-        [0x16] = IRQ_Default,               /* Host to BMC */
+        [0x16] = IRQ_HostToBmc,             /* Host to BMC */
         [0x17] = IRQ_Default,               /* -- */
         [0x18] = IRQ_Default,               /* TX Error */
         [0x19] = IRQ_RxPacketEven,          /* RX Packet - Even ports */
@@ -118,8 +121,8 @@ vector_table_t gVectors __attribute__((section(".init"))) = {
         [0x24] = IRQ_Default,               /* -- */
         [0x25] = IRQ_Default,               /* -- */
         [0x26] = IRQ_VoltageSource,         /* Voltage Source Changed */
-        [0x27] = IRQ_Default,               /* Link Status Changed (Even Ports) */
-        [0x28] = IRQ_Default,               /* Link Status Changed (Odd Ports) */
+        [0x27] = IRQ_LinkStatusEven,        /* Link Status Changed (Even Ports) */
+        [0x28] = IRQ_LinkStatusOdd,         /* Link Status Changed (Odd Ports) */
         [0x29] = IRQ_RxPacketOdd,           /* RX Packet (Odd ports) */
         [0x2A] = IRQ_Default,               /* -- */
         [0x2B] = IRQ_Default,               /* -- */
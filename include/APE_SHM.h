@@ -561,6 +561,361 @@ typedef register_container RegSHMLoaderArg1_t {
 #endif /* CXX_SIMULATOR */
 } RegSHMLoaderArg1_t;
 
+#define REG_SHM_DRAIN_BUDGET ((volatile APE_SHM_H_uint32_t*)0x60220044) /* Per direction packet budget for each main loop pass. Initialized from the build configuration, may be changed by the host. */
+#define     SHM_DRAIN_BUDGET_FRAMES_SHIFT 0u
+#define     SHM_DRAIN_BUDGET_FRAMES_MASK  0xffffu
+#define GET_SHM_DRAIN_BUDGET_FRAMES(__reg__)  (((__reg__) & 0xffff) >> 0u)
+#define SET_SHM_DRAIN_BUDGET_FRAMES(__val__)  (((__val__) << 0u) & 0xffffu)
+#define     SHM_DRAIN_BUDGET_TIME_SHIFT 16u
+#define     SHM_DRAIN_BUDGET_TIME_MASK  0xffff0000u
+#define GET_SHM_DRAIN_BUDGET_TIME(__reg__)  (((__reg__) & 0xffff0000) >> 16u)
+#define SET_SHM_DRAIN_BUDGET_TIME(__val__)  (((__val__) << 16u) & 0xffff0000u)
+
+/** @brief Register definition for @ref SHM_t.DrainBudget. */
+typedef register_container RegSHMDrainBudget_t {
+    /** @brief 32bit direct register access. */
+    APE_SHM_H_uint32_t r32;
+
+    BITFIELD_BEGIN(APE_SHM_H_uint32_t, bits)
+#if defined(__LITTLE_ENDIAN__)
+        /** @brief Maximum number of frames handled per direction before servicing housekeeping. */
+        BITFIELD_MEMBER(APE_SHM_H_uint32_t, Frames, 0, 16)
+        /** @brief Maximum time in microseconds spent per direction before servicing housekeeping. */
+        BITFIELD_MEMBER(APE_SHM_H_uint32_t, Time, 16, 16)
+#elif defined(__BIG_ENDIAN__)
+        /** @brief Maximum time in microseconds spent per direction before servicing housekeeping. */
+        BITFIELD_MEMBER(APE_SHM_H_uint32_t, Time, 16, 16)
+        /** @brief Maximum number of frames handled per direction before servicing housekeeping. */
+        BITFIELD_MEMBER(APE_SHM_H_uint32_t, Frames, 0, 16)
+#else
+#error Unknown Endian
+#endif
+    BITFIELD_END(APE_SHM_H_uint32_t, bits)
+#ifdef CXX_SIMULATOR
+    /** @brief Register name for use with the simulator. */
+    const char* getName(void) { return "DrainBudget"; }
+
+    /** @brief Print register value. */
+    void print(void) { r32.print(); }
+
+    RegSHMDrainBudget_t()
+    {
+        /** @brief constructor for @ref SHM_t.DrainBudget. */
+        r32.setName("DrainBudget");
+        bits.Frames.setBaseRegister(&r32);
+        bits.Frames.setName("Frames");
+        bits.Time.setBaseRegister(&r32);
+        bits.Time.setName("Time");
+    }
+    RegSHMDrainBudget_t& operator=(const RegSHMDrainBudget_t& other)
+    {
+        r32 = other.r32;
+        return *this;
+    }
+#endif /* CXX_SIMULATOR */
+} RegSHMDrainBudget_t;
+
+#define REG_SHM_DRAIN_BMC_EXHAUSTED ((volatile APE_SHM_H_uint32_t*)0x60220048) /* Number of passes where the BMC to network drain stopped with the budget exhausted. */
+/** @brief Register definition for @ref SHM_t.DrainBmcExhausted. */
+typedef register_container RegSHMDrainBmcExhausted_t {
+    /** @brief 32bit direct register access. */
+    APE_SHM_H_uint32_t r32;
+#ifdef CXX_SIMULATOR
+    /** @brief Register name for use with the simulator. */
+    const char* getName(void) { return "DrainBmcExhausted"; }
+
+    /** @brief Print register value. */
+    void print(void) { r32.print(); }
+
+    RegSHMDrainBmcExhausted_t()
+    {
+        /** @brief constructor for @ref SHM_t.DrainBmcExhausted. */
+        r32.setName("DrainBmcExhausted");
+    }
+    RegSHMDrainBmcExhausted_t& operator=(const RegSHMDrainBmcExhausted_t& other)
+    {
+        r32 = other.r32;
+        return *this;
+    }
+#endif /* CXX_SIMULATOR */
+} RegSHMDrainBmcExhausted_t;
+
+#define REG_SHM_DRAIN_NETWORK_EXHAUSTED ((volatile APE_SHM_H_uint32_t*)0x6022004c) /* Number of passes where the network to BMC drain stopped with the budget exhausted. */
+/** @brief Register definition for @ref SHM_t.DrainNetworkExhausted. */
+typedef register_container RegSHMDrainNetworkExhausted_t {
+    /** @brief 32bit direct register access. */
+    APE_SHM_H_uint32_t r32;
+#ifdef CXX_SIMULATOR
+    /** @brief Register name for use with the simulator. */
+    const char* getName(void) { return "DrainNetworkExhausted"; }
+
+    /** @brief Print register value. */
+    void print(void) { r32.print(); }
+
+    RegSHMDrainNetworkExhausted_t()
+    {
+        /** @brief constructor for @ref SHM_t.DrainNetworkExhausted. */
+        r32.setName("DrainNetworkExhausted");
+    }
+    RegSHMDrainNetworkExhausted_t& operator=(const RegSHMDrainNetworkExhausted_t& other)
+    {
+        r32 = other.r32;
+        return *this;
+    }
+#endif /* CXX_SIMULATOR */
+} RegSHMDrainNetworkExhausted_t;
+
+#define REG_SHM_RMU_FLOW_CONTROL ((volatile APE_SHM_H_uint32_t*)0x60220050) /* RMU flow control thresholds currently programmed into BmcToNcRxControl. */
+#define     SHM_RMU_FLOW_CONTROL_HWM_SHIFT 0u
+#define     SHM_RMU_FLOW_CONTROL_HWM_MASK  0x7ffu
+#define GET_SHM_RMU_FLOW_CONTROL_HWM(__reg__)  (((__reg__) & 0x7ff) >> 0u)
+#define SET_SHM_RMU_FLOW_CONTROL_HWM(__val__)  (((__val__) << 0u) & 0x7ffu)
+#define     SHM_RMU_FLOW_CONTROL_XON_SHIFT 11u
+#define     SHM_RMU_FLOW_CONTROL_XON_MASK  0xfff800u
+#define GET_SHM_RMU_FLOW_CONTROL_XON(__reg__)  (((__reg__) & 0xfff800) >> 11u)
+#define SET_SHM_RMU_FLOW_CONTROL_XON(__val__)  (((__val__) << 11u) & 0xfff800u)
+#define     SHM_RMU_FLOW_CONTROL_MANUAL_SHIFT 31u
+#define     SHM_RMU_FLOW_CONTROL_MANUAL_MASK  0x80000000u
+#define GET_SHM_RMU_FLOW_CONTROL_MANUAL(__reg__)  (((__reg__) & 0x80000000) >> 31u)
+#define SET_SHM_RMU_FLOW_CONTROL_MANUAL(__val__)  (((__val__) << 31u) & 0x80000000u)
+
+/** @brief Register definition for @ref SHM_t.RmuFlowControl. */
+typedef register_container RegSHMRmuFlowControl_t {
+    /** @brief 32bit direct register access. */
+    APE_SHM_H_uint32_t r32;
+
+    BITFIELD_BEGIN(APE_SHM_H_uint32_t, bits)
+#if defined(__LITTLE_ENDIAN__)
+        /** @brief High water mark, PAUSE frames are sent to the BMC above this level. */
+        BITFIELD_MEMBER(APE_SHM_H_uint32_t, HWM, 0, 11)
+        /** @brief XON threshold, PAUSE is released below this level. */
+        BITFIELD_MEMBER(APE_SHM_H_uint32_t, XON, 11, 13)
+        /** @brief Padding */
+        BITFIELD_MEMBER(APE_SHM_H_uint32_t, reserved_30_24, 24, 7)
+        /** @brief Set by the host to stop the firmware from adapting the thresholds. The HWM and XON written by the host are applied within the safe bounds. */
+        BITFIELD_MEMBER(APE_SHM_H_uint32_t, Manual, 31, 1)
+#elif defined(__BIG_ENDIAN__)
+        /** @brief Set by the host to stop the firmware from adapting the thresholds. The HWM and XON written by the host are applied within the safe bounds. */
+        BITFIELD_MEMBER(APE_SHM_H_uint32_t, Manual, 31, 1)
+        /** @brief Padding */
+        BITFIELD_MEMBER(APE_SHM_H_uint32_t, reserved_30_24, 24, 7)
+        /** @brief XON threshold, PAUSE is released below this level. */
+        BITFIELD_MEMBER(APE_SHM_H_uint32_t, XON, 11, 13)
+        /** @brief High water mark, PAUSE frames are sent to the BMC above this level. */
+        BITFIELD_MEMBER(APE_SHM_H_uint32_t, HWM, 0, 11)
+#else
+#error Unknown Endian
+#endif
+    BITFIELD_END(APE_SHM_H_uint32_t, bits)
+#ifdef CXX_SIMULATOR
+    /** @brief Register name for use with the simulator. */
+    const char* getName(void) { return "RmuFlowControl"; }
+
+    /** @brief Print register value. */
+    void print(void) { r32.print(); }
+
+    RegSHMRmuFlowControl_t()
+    {
+        /** @brief constructor for @ref SHM_t.RmuFlowControl. */
+        r32.setName("RmuFlowControl");
+        bits.HWM.setBaseRegister(&r32);
+        bits.HWM.setName("HWM");
+        bits.XON.setBaseRegister(&r32);
+        bits.XON.setName("XON");
+        bits.Manual.setBaseRegister(&r32);
+        bits.Manual.setName("Manual");
+    }
+    RegSHMRmuFlowControl_t& operator=(const RegSHMRmuFlowControl_t& other)
+    {
+        r32 = other.r32;
+        return *this;
+    }
+#endif /* CXX_SIMULATOR */
+} RegSHMRmuFlowControl_t;
+
+#define REG_SHM_RMU_RX_BACKLOG ((volatile APE_SHM_H_uint32_t*)0x60220054) /* Number of housekeeping samples that found a BMC frame still waiting in the RMU RX fifo. The RMU has no PAUSE counter, this approximates the time spent under flow control pressure. */
+/** @brief Register definition for @ref SHM_t.RmuRxBacklog. */
+typedef register_container RegSHMRmuRxBacklog_t {
+    /** @brief 32bit direct register access. */
+    APE_SHM_H_uint32_t r32;
+#ifdef CXX_SIMULATOR
+    /** @brief Register name for use with the simulator. */
+    const char* getName(void) { return "RmuRxBacklog"; }
+
+    /** @brief Print register value. */
+    void print(void) { r32.print(); }
+
+    RegSHMRmuRxBacklog_t()
+    {
+        /** @brief constructor for @ref SHM_t.RmuRxBacklog. */
+        r32.setName("RmuRxBacklog");
+    }
+    RegSHMRmuRxBacklog_t& operator=(const RegSHMRmuRxBacklog_t& other)
+    {
+        r32 = other.r32;
+        return *this;
+    }
+#endif /* CXX_SIMULATOR */
+} RegSHMRmuRxBacklog_t;
+
+#define REG_SHM_RMU_FLOW_ADJUSTMENTS ((volatile APE_SHM_H_uint32_t*)0x60220058) /* Number of times the RMU flow control thresholds were changed. */
+/** @brief Register definition for @ref SHM_t.RmuFlowAdjustments. */
+typedef register_container RegSHMRmuFlowAdjustments_t {
+    /** @brief 32bit direct register access. */
+    APE_SHM_H_uint32_t r32;
+#ifdef CXX_SIMULATOR
+    /** @brief Register name for use with the simulator. */
+    const char* getName(void) { return "RmuFlowAdjustments"; }
+
+    /** @brief Print register value. */
+    void print(void) { r32.print(); }
+
+    RegSHMRmuFlowAdjustments_t()
+    {
+        /** @brief constructor for @ref SHM_t.RmuFlowAdjustments. */
+        r32.setName("RmuFlowAdjustments");
+    }
+    RegSHMRmuFlowAdjustments_t& operator=(const RegSHMRmuFlowAdjustments_t& other)
+    {
+        r32 = other.r32;
+        return *this;
+    }
+#endif /* CXX_SIMULATOR */
+} RegSHMRmuFlowAdjustments_t;
+
+#define REG_SHM_RMU_TX_FIFO_MIN_FREE ((volatile APE_SHM_H_uint32_t*)0x6022005c) /* Lowest BmcToNcTxStatus.InFifo seen during the last flow control window. */
+/** @brief Register definition for @ref SHM_t.RmuTxFifoMinFree. */
+typedef register_container RegSHMRmuTxFifoMinFree_t {
+    /** @brief 32bit direct register access. */
+    APE_SHM_H_uint32_t r32;
+#ifdef CXX_SIMULATOR
+    /** @brief Register name for use with the simulator. */
+    const char* getName(void) { return "RmuTxFifoMinFree"; }
+
+    /** @brief Print register value. */
+    void print(void) { r32.print(); }
+
+    RegSHMRmuTxFifoMinFree_t()
+    {
+        /** @brief constructor for @ref SHM_t.RmuTxFifoMinFree. */
+        r32.setName("RmuTxFifoMinFree");
+    }
+    RegSHMRmuTxFifoMinFree_t& operator=(const RegSHMRmuTxFifoMinFree_t& other)
+    {
+        r32 = other.r32;
+        return *this;
+    }
+#endif /* CXX_SIMULATOR */
+} RegSHMRmuTxFifoMinFree_t;
+
+#define REG_SHM_POWER_POLICY ((volatile APE_SHM_H_uint32_t*)0x60220060) /* EEE and clock profile of the management port. */
+#define     SHM_POWER_POLICY_PROFILE_SHIFT 0u
+#define     SHM_POWER_POLICY_PROFILE_MASK  0x3u
+#define GET_SHM_POWER_POLICY_PROFILE(__reg__)  (((__reg__) & 0x3) >> 0u)
+#define SET_SHM_POWER_POLICY_PROFILE(__val__)  (((__val__) << 0u) & 0x3u)
+#define     SHM_POWER_POLICY_MANUAL_SHIFT 31u
+#define     SHM_POWER_POLICY_MANUAL_MASK  0x80000000u
+#define GET_SHM_POWER_POLICY_MANUAL(__reg__)  (((__reg__) & 0x80000000) >> 31u)
+#define SET_SHM_POWER_POLICY_MANUAL(__val__)  (((__val__) << 31u) & 0x80000000u)
+
+/** @brief Register definition for @ref SHM_t.PowerPolicy. */
+typedef register_container RegSHMPowerPolicy_t {
+    /** @brief 32bit direct register access. */
+    APE_SHM_H_uint32_t r32;
+
+    BITFIELD_BEGIN(APE_SHM_H_uint32_t, bits)
+#if defined(__LITTLE_ENDIAN__)
+        /** @brief 0: EEE LPI off, full MAC clock. 1: EEE LPI on. 2: EEE LPI on, reduced D0u MAC clock. */
+        BITFIELD_MEMBER(APE_SHM_H_uint32_t, Profile, 0, 2)
+        /** @brief Padding */
+        BITFIELD_MEMBER(APE_SHM_H_uint32_t, reserved_30_2, 2, 29)
+        /** @brief Set by the host to select Profile instead of following the passthrough traffic. */
+        BITFIELD_MEMBER(APE_SHM_H_uint32_t, Manual, 31, 1)
+#elif defined(__BIG_ENDIAN__)
+        /** @brief Set by the host to select Profile instead of following the passthrough traffic. */
+        BITFIELD_MEMBER(APE_SHM_H_uint32_t, Manual, 31, 1)
+        /** @brief Padding */
+        BITFIELD_MEMBER(APE_SHM_H_uint32_t, reserved_30_2, 2, 29)
+        /** @brief 0: EEE LPI off, full MAC clock. 1: EEE LPI on. 2: EEE LPI on, reduced D0u MAC clock. */
+        BITFIELD_MEMBER(APE_SHM_H_uint32_t, Profile, 0, 2)
+#else
+#error Unknown Endian
+#endif
+    BITFIELD_END(APE_SHM_H_uint32_t, bits)
+#ifdef CXX_SIMULATOR
+    /** @brief Register name for use with the simulator. */
+    const char* getName(void) { return "PowerPolicy"; }
+
+    /** @brief Print register value. */
+    void print(void) { r32.print(); }
+
+    RegSHMPowerPolicy_t()
+    {
+        /** @brief constructor for @ref SHM_t.PowerPolicy. */
+        r32.setName("PowerPolicy");
+        bits.Profile.setBaseRegister(&r32);
+        bits.Profile.setName("Profile");
+        bits.Manual.setBaseRegister(&r32);
+        bits.Manual.setName("Manual");
+    }
+    RegSHMPowerPolicy_t& operator=(const RegSHMPowerPolicy_t& other)
+    {
+        r32 = other.r32;
+        return *this;
+    }
+#endif /* CXX_SIMULATOR */
+} RegSHMPowerPolicy_t;
+
+#define REG_SHM_POWER_POLICY_SWITCHES ((volatile APE_SHM_H_uint32_t*)0x60220064) /* Number of times the power policy changed the profile. */
+/** @brief Register definition for @ref SHM_t.PowerPolicySwitches. */
+typedef register_container RegSHMPowerPolicySwitches_t {
+    /** @brief 32bit direct register access. */
+    APE_SHM_H_uint32_t r32;
+#ifdef CXX_SIMULATOR
+    /** @brief Register name for use with the simulator. */
+    const char* getName(void) { return "PowerPolicySwitches"; }
+
+    /** @brief Print register value. */
+    void print(void) { r32.print(); }
+
+    RegSHMPowerPolicySwitches_t()
+    {
+        /** @brief constructor for @ref SHM_t.PowerPolicySwitches. */
+        r32.setName("PowerPolicySwitches");
+    }
+    RegSHMPowerPolicySwitches_t& operator=(const RegSHMPowerPolicySwitches_t& other)
+    {
+        r32 = other.r32;
+        return *this;
+    }
+#endif /* CXX_SIMULATOR */
+} RegSHMPowerPolicySwitches_t;
+
+#define REG_SHM_POWER_POLICY_TIME ((volatile APE_SHM_H_uint32_t*)0x60220068) /* Milliseconds spent in each power policy profile. */
+/** @brief Register definition for @ref SHM_t.PowerPolicyTime. */
+typedef register_container RegSHMPowerPolicyTime_t {
+    /** @brief 32bit direct register access. */
+    APE_SHM_H_uint32_t r32;
+#ifdef CXX_SIMULATOR
+    /** @brief Register name for use with the simulator. */
+    const char* getName(void) { return "PowerPolicyTime"; }
+
+    /** @brief Print register value. */
+    void print(void) { r32.print(); }
+
+    RegSHMPowerPolicyTime_t()
+    {
+        /** @brief constructor for @ref SHM_t.PowerPolicyTime. */
+        r32.setName("PowerPolicyTime");
+    }
+    RegSHMPowerPolicyTime_t& operator=(const RegSHMPowerPolicyTime_t& other)
+    {
+        r32 = other.r32;
+        return *this;
+    }
+#endif /* CXX_SIMULATOR */
+} RegSHMPowerPolicyTime_t;
+
 #define REG_SHM_RCPU_SEG_SIG ((volatile APE_SHM_H_uint32_t*)0x60220100) /* Set to APE_RCPU_MAGIC ('RCPU') by RX CPU. */
 #define     SHM_RCPU_SEG_SIG_SIG_SHIFT 0u
 #define     SHM_RCPU_SEG_SIG_SIG_MASK  0xffffffffu
@@ -1000,6 +1355,155 @@ typedef register_container RegSHMRcpuCpmuStatus_t {
 #endif /* CXX_SIMULATOR */
 } RegSHMRcpuCpmuStatus_t;
 
+#define REG_SHM_NCSI_TRACE_INDEX ((volatile APE_SHM_H_uint32_t*)0x60220134) /* Number of NC-SI commands recorded in the trace ring. The most recent entry is at (index - 1) modulo the ring size. */
+/** @brief Register definition for @ref SHM_t.NcsiTraceIndex. */
+typedef register_container RegSHMNcsiTraceIndex_t {
+    /** @brief 32bit direct register access. */
+    APE_SHM_H_uint32_t r32;
+#ifdef CXX_SIMULATOR
+    /** @brief Register name for use with the simulator. */
+    const char* getName(void) { return "NcsiTraceIndex"; }
+
+    /** @brief Print register value. */
+    void print(void) { r32.print(); }
+
+    RegSHMNcsiTraceIndex_t()
+    {
+        /** @brief constructor for @ref SHM_t.NcsiTraceIndex. */
+        r32.setName("NcsiTraceIndex");
+    }
+    RegSHMNcsiTraceIndex_t& operator=(const RegSHMNcsiTraceIndex_t& other)
+    {
+        r32 = other.r32;
+        return *this;
+    }
+#endif /* CXX_SIMULATOR */
+} RegSHMNcsiTraceIndex_t;
+
+#define REG_SHM_NCSI_TRACE_COMMAND ((volatile APE_SHM_H_uint32_t*)0x60220140) /* NC-SI command trace ring entry. */
+#define     SHM_NCSI_TRACE_COMMAND_COMMAND_SHIFT 0u
+#define     SHM_NCSI_TRACE_COMMAND_COMMAND_MASK  0xffu
+#define GET_SHM_NCSI_TRACE_COMMAND_COMMAND(__reg__)  (((__reg__) & 0xff) >> 0u)
+#define SET_SHM_NCSI_TRACE_COMMAND_COMMAND(__val__)  (((__val__) << 0u) & 0xffu)
+#define     SHM_NCSI_TRACE_COMMAND_CHANNEL_SHIFT 8u
+#define     SHM_NCSI_TRACE_COMMAND_CHANNEL_MASK  0xff00u
+#define GET_SHM_NCSI_TRACE_COMMAND_CHANNEL(__reg__)  (((__reg__) & 0xff00) >> 8u)
+#define SET_SHM_NCSI_TRACE_COMMAND_CHANNEL(__val__)  (((__val__) << 8u) & 0xff00u)
+#define     SHM_NCSI_TRACE_COMMAND_INSTANCE_ID_SHIFT 16u
+#define     SHM_NCSI_TRACE_COMMAND_INSTANCE_ID_MASK  0xff0000u
+#define GET_SHM_NCSI_TRACE_COMMAND_INSTANCE_ID(__reg__)  (((__reg__) & 0xff0000) >> 16u)
+#define SET_SHM_NCSI_TRACE_COMMAND_INSTANCE_ID(__val__)  (((__val__) << 16u) & 0xff0000u)
+#define     SHM_NCSI_TRACE_COMMAND_RESPONSE_CODE_SHIFT 24u
+#define     SHM_NCSI_TRACE_COMMAND_RESPONSE_CODE_MASK  0xff000000u
+#define GET_SHM_NCSI_TRACE_COMMAND_RESPONSE_CODE(__reg__)  (((__reg__) & 0xff000000) >> 24u)
+#define SET_SHM_NCSI_TRACE_COMMAND_RESPONSE_CODE(__val__)  (((__val__) << 24u) & 0xff000000u)
+
+/** @brief Register definition for @ref SHM_t.NcsiTraceCommand. */
+typedef register_container RegSHMNcsiTraceCommand_t {
+    /** @brief 32bit direct register access. */
+    APE_SHM_H_uint32_t r32;
+
+    BITFIELD_BEGIN(APE_SHM_H_uint32_t, bits)
+#if defined(__LITTLE_ENDIAN__)
+        /** @brief NC-SI command type. */
+        BITFIELD_MEMBER(APE_SHM_H_uint32_t, Command, 0, 8)
+        /** @brief Channel ID the command was addressed to. */
+        BITFIELD_MEMBER(APE_SHM_H_uint32_t, Channel, 8, 8)
+        /** @brief Instance ID of the command. */
+        BITFIELD_MEMBER(APE_SHM_H_uint32_t, InstanceID, 16, 8)
+        /** @brief Response code returned, 0xFF if no response was sent. */
+        BITFIELD_MEMBER(APE_SHM_H_uint32_t, ResponseCode, 24, 8)
+#elif defined(__BIG_ENDIAN__)
+        /** @brief Response code returned, 0xFF if no response was sent. */
+        BITFIELD_MEMBER(APE_SHM_H_uint32_t, ResponseCode, 24, 8)
+        /** @brief Instance ID of the command. */
+        BITFIELD_MEMBER(APE_SHM_H_uint32_t, InstanceID, 16, 8)
+        /** @brief Channel ID the command was addressed to. */
+        BITFIELD_MEMBER(APE_SHM_H_uint32_t, Channel, 8, 8)
+        /** @brief NC-SI command type. */
+        BITFIELD_MEMBER(APE_SHM_H_uint32_t, Command, 0, 8)
+#else
+#error Unknown Endian
+#endif
+    BITFIELD_END(APE_SHM_H_uint32_t, bits)
+#ifdef CXX_SIMULATOR
+    /** @brief Register name for use with the simulator. */
+    const char* getName(void) { return "NcsiTraceCommand"; }
+
+    /** @brief Print register value. */
+    void print(void) { r32.print(); }
+
+    RegSHMNcsiTraceCommand_t()
+    {
+        /** @brief constructor for @ref SHM_t.NcsiTraceCommand. */
+        r32.setName("NcsiTraceCommand");
+        bits.Command.setBaseRegister(&r32);
+        bits.Command.setName("Command");
+        bits.Channel.setBaseRegister(&r32);
+        bits.Channel.setName("Channel");
+        bits.InstanceID.setBaseRegister(&r32);
+        bits.InstanceID.setName("InstanceID");
+        bits.ResponseCode.setBaseRegister(&r32);
+        bits.ResponseCode.setName("ResponseCode");
+    }
+    RegSHMNcsiTraceCommand_t& operator=(const RegSHMNcsiTraceCommand_t& other)
+    {
+        r32 = other.r32;
+        return *this;
+    }
+#endif /* CXX_SIMULATOR */
+} RegSHMNcsiTraceCommand_t;
+
+#define REG_SHM_NCSI_TRACE_START ((volatile APE_SHM_H_uint32_t*)0x60220180) /* 1MHz timestamp when the command was first seen by the APE. */
+/** @brief Register definition for @ref SHM_t.NcsiTraceStart. */
+typedef register_container RegSHMNcsiTraceStart_t {
+    /** @brief 32bit direct register access. */
+    APE_SHM_H_uint32_t r32;
+#ifdef CXX_SIMULATOR
+    /** @brief Register name for use with the simulator. */
+    const char* getName(void) { return "NcsiTraceStart"; }
+
+    /** @brief Print register value. */
+    void print(void) { r32.print(); }
+
+    RegSHMNcsiTraceStart_t()
+    {
+        /** @brief constructor for @ref SHM_t.NcsiTraceStart. */
+        r32.setName("NcsiTraceStart");
+    }
+    RegSHMNcsiTraceStart_t& operator=(const RegSHMNcsiTraceStart_t& other)
+    {
+        r32 = other.r32;
+        return *this;
+    }
+#endif /* CXX_SIMULATOR */
+} RegSHMNcsiTraceStart_t;
+
+#define REG_SHM_NCSI_TRACE_END ((volatile APE_SHM_H_uint32_t*)0x602201c0) /* 1MHz timestamp after the response was handed to the RMU. */
+/** @brief Register definition for @ref SHM_t.NcsiTraceEnd. */
+typedef register_container RegSHMNcsiTraceEnd_t {
+    /** @brief 32bit direct register access. */
+    APE_SHM_H_uint32_t r32;
+#ifdef CXX_SIMULATOR
+    /** @brief Register name for use with the simulator. */
+    const char* getName(void) { return "NcsiTraceEnd"; }
+
+    /** @brief Print register value. */
+    void print(void) { r32.print(); }
+
+    RegSHMNcsiTraceEnd_t()
+    {
+        /** @brief constructor for @ref SHM_t.NcsiTraceEnd. */
+        r32.setName("NcsiTraceEnd");
+    }
+    RegSHMNcsiTraceEnd_t& operator=(const RegSHMNcsiTraceEnd_t& other)
+    {
+        r32 = other.r32;
+        return *this;
+    }
+#endif /* CXX_SIMULATOR */
+} RegSHMNcsiTraceEnd_t;
+
 #define REG_SHM_HOST_SEG_SIG ((volatile APE_SHM_H_uint32_t*)0x60220200) /* Set to APE_HOST_MAGIC ('HOST') to indicate the section is valid. */
 /** @brief Register definition for @ref SHM_t.HostSegSig. */
 typedef register_container RegSHMHostSegSig_t {
@@ -1601,8 +2105,38 @@ typedef struct SHM_t {
     /** @brief Argument 1 for the APE loader. */
     RegSHMLoaderArg1_t LoaderArg1;
 
+    /** @brief Per direction packet budget for each main loop pass. Initialized from the build configuration, may be changed by the host. */
+    RegSHMDrainBudget_t DrainBudget;
+
+    /** @brief Number of passes where the BMC to network drain stopped with the budget exhausted. */
+    RegSHMDrainBmcExhausted_t DrainBmcExhausted;
+
+    /** @brief Number of passes where the network to BMC drain stopped with the budget exhausted. */
+    RegSHMDrainNetworkExhausted_t DrainNetworkExhausted;
+
+    /** @brief RMU flow control thresholds currently programmed into BmcToNcRxControl. */
+    RegSHMRmuFlowControl_t RmuFlowControl;
+
+    /** @brief Number of housekeeping samples that found a BMC frame still waiting in the RMU RX fifo. The RMU has no PAUSE counter, this approximates the time spent under flow control pressure. */
+    RegSHMRmuRxBacklog_t RmuRxBacklog;
+
+    /** @brief Number of times the RMU flow control thresholds were changed. */
+    RegSHMRmuFlowAdjustments_t RmuFlowAdjustments;
+
+    /** @brief Lowest BmcToNcTxStatus.InFifo seen during the last flow control window. */
+    RegSHMRmuTxFifoMinFree_t RmuTxFifoMinFree;
+
+    /** @brief EEE and clock profile of the management port. */
+    RegSHMPowerPolicy_t PowerPolicy;
+
+    /** @brief Number of times the power policy changed the profile. */
+    RegSHMPowerPolicySwitches_t PowerPolicySwitches;
+
+    /** @brief Milliseconds spent in each power policy profile. */
+    RegSHMPowerPolicyTime_t PowerPolicyTime[3];
+
     /** @brief Reserved bytes to pad out data structure. */
-    APE_SHM_H_uint32_t reserved_68[47];
+    APE_SHM_H_uint32_t reserved_116[35];
 
     /** @brief Set to APE_RCPU_MAGIC ('RCPU') by RX CPU. */
     RegSHMRcpuSegSig_t RcpuSegSig;
@@ -1643,8 +2177,20 @@ typedef struct SHM_t {
     /** @brief Set from  */
     RegSHMRcpuCpmuStatus_t RcpuCpmuStatus;
 
+    /** @brief Number of NC-SI commands recorded in the trace ring. The most recent entry is at (index - 1) modulo the ring size. */
+    RegSHMNcsiTraceIndex_t NcsiTraceIndex;
+
     /** @brief Reserved bytes to pad out data structure. */
-    APE_SHM_H_uint32_t reserved_308[51];
+    APE_SHM_H_uint32_t reserved_312[2];
+
+    /** @brief NC-SI command trace ring entry. */
+    RegSHMNcsiTraceCommand_t NcsiTraceCommand[16];
+
+    /** @brief 1MHz timestamp when the command was first seen by the APE. */
+    RegSHMNcsiTraceStart_t NcsiTraceStart[16];
+
+    /** @brief 1MHz timestamp after the response was handed to the RMU. */
+    RegSHMNcsiTraceEnd_t NcsiTraceEnd[16];
 
     /** @brief Set to APE_HOST_MAGIC ('HOST') to indicate the section is valid. */
     RegSHMHostSegSig_t HostSegSig;
@@ -1743,9 +2289,22 @@ typedef struct SHM_t {
         LoaderCommand.r32.setComponentOffset(0x38);
         LoaderArg0.r32.setComponentOffset(0x3c);
         LoaderArg1.r32.setComponentOffset(0x40);
-        for(int i = 0; i < 47; i++)
+        DrainBudget.r32.setComponentOffset(0x44);
+        DrainBmcExhausted.r32.setComponentOffset(0x48);
+        DrainNetworkExhausted.r32.setComponentOffset(0x4c);
+        RmuFlowControl.r32.setComponentOffset(0x50);
+        RmuRxBacklog.r32.setComponentOffset(0x54);
+        RmuFlowAdjustments.r32.setComponentOffset(0x58);
+        RmuTxFifoMinFree.r32.setComponentOffset(0x5c);
+        PowerPolicy.r32.setComponentOffset(0x60);
+        PowerPolicySwitches.r32.setComponentOffset(0x64);
+        for(int i = 0; i < 3; i++)
+        {
+            PowerPolicyTime[i].r32.setComponentOffset(0x68 + (i * 4));
+        }
+        for(int i = 0; i < 35; i++)
         {
-            reserved_68[i].setComponentOffset(0x44 + (i * 4));
+            reserved_116[i].setComponentOffset(0x74 + (i * 4));
         }
         RcpuSegSig.r32.setComponentOffset(0x100);
         RcpuSegLength.r32.setComponentOffset(0x104);
@@ -1760,9 +2319,22 @@ typedef struct SHM_t {
         RcpuCfgHw.r32.setComponentOffset(0x128);
         RcpuCfgHw2.r32.setComponentOffset(0x12c);
         RcpuCpmuStatus.r32.setComponentOffset(0x130);
-        for(int i = 0; i < 51; i++)
+        NcsiTraceIndex.r32.setComponentOffset(0x134);
+        for(int i = 0; i < 2; i++)
         {
-            reserved_308[i].setComponentOffset(0x134 + (i * 4));
+            reserved_312[i].setComponentOffset(0x138 + (i * 4));
+        }
+        for(int i = 0; i < 16; i++)
+        {
+            NcsiTraceCommand[i].r32.setComponentOffset(0x140 + (i * 4));
+        }
+        for(int i = 0; i < 16; i++)
+        {
+            NcsiTraceStart[i].r32.setComponentOffset(0x180 + (i * 4));
+        }
+        for(int i = 0; i < 16; i++)
+        {
+            NcsiTraceEnd[i].r32.setComponentOffset(0x1c0 + (i * 4));
         }
         HostSegSig.r32.setComponentOffset(0x200);
         HostSegLen.r32.setComponentOffset(0x204);
@@ -1828,9 +2400,22 @@ typedef struct SHM_t {
         LoaderCommand.print();
         LoaderArg0.print();
         LoaderArg1.print();
-        for(int i = 0; i < 47; i++)
+        DrainBudget.print();
+        DrainBmcExhausted.print();
+        DrainNetworkExhausted.print();
+        RmuFlowControl.print();
+        RmuRxBacklog.print();
+        RmuFlowAdjustments.print();
+        RmuTxFifoMinFree.print();
+        PowerPolicy.print();
+        PowerPolicySwitches.print();
+        for(int i = 0; i < 3; i++)
         {
-            reserved_68[i].print();
+            PowerPolicyTime[i].print();
+        }
+        for(int i = 0; i < 35; i++)
+        {
+            reserved_116[i].print();
         }
         RcpuSegSig.print();
         RcpuSegLength.print();
@@ -1845,9 +2430,22 @@ typedef struct SHM_t {
         RcpuCfgHw.print();
         RcpuCfgHw2.print();
         RcpuCpmuStatus.print();
-        for(int i = 0; i < 51; i++)
+        NcsiTraceIndex.print();
+        for(int i = 0; i < 2; i++)
+        {
+            reserved_312[i].print();
+        }
+        for(int i = 0; i < 16; i++)
+        {
+            NcsiTraceCommand[i].print();
+        }
+        for(int i = 0; i < 16; i++)
+        {
+            NcsiTraceStart[i].print();
+        }
+        for(int i = 0; i < 16; i++)
         {
-            reserved_308[i].print();
+            NcsiTraceEnd[i].print();
         }
         HostSegSig.print();
         HostSegLen.print();
@@ -95,6 +95,16 @@ typedef uint32_t APE_SHM2_H_uint32_t;
 #define REG_SHM2_LOADER_COMMAND ((volatile APE_SHM2_H_uint32_t*)0x60222038) /* Command sent when using the the APE loader. Zero once handled. */
 #define REG_SHM2_LOADER_ARG0 ((volatile APE_SHM2_H_uint32_t*)0x6022203c) /* Argument 0 for the APE loader. */
 #define REG_SHM2_LOADER_ARG1 ((volatile APE_SHM2_H_uint32_t*)0x60222040) /* Argument 1 for the APE loader. */
+#define REG_SHM2_DRAIN_BUDGET ((volatile APE_SHM2_H_uint32_t*)0x60222044) /* Per direction packet budget for each main loop pass. Initialized from the build configuration, may be changed by the host. */
+#define REG_SHM2_DRAIN_BMC_EXHAUSTED ((volatile APE_SHM2_H_uint32_t*)0x60222048) /* Number of passes where the BMC to network drain stopped with the budget exhausted. */
+#define REG_SHM2_DRAIN_NETWORK_EXHAUSTED ((volatile APE_SHM2_H_uint32_t*)0x6022204c) /* Number of passes where the network to BMC drain stopped with the budget exhausted. */
+#define REG_SHM2_RMU_FLOW_CONTROL ((volatile APE_SHM2_H_uint32_t*)0x60222050) /* RMU flow control thresholds currently programmed into BmcToNcRxControl. */
+#define REG_SHM2_RMU_RX_BACKLOG ((volatile APE_SHM2_H_uint32_t*)0x60222054) /* Number of housekeeping samples that found a BMC frame still waiting in the RMU RX fifo. The RMU has no PAUSE counter, this approximates the time spent under flow control pressure. */
+#define REG_SHM2_RMU_FLOW_ADJUSTMENTS ((volatile APE_SHM2_H_uint32_t*)0x60222058) /* Number of times the RMU flow control thresholds were changed. */
+#define REG_SHM2_RMU_TX_FIFO_MIN_FREE ((volatile APE_SHM2_H_uint32_t*)0x6022205c) /* Lowest BmcToNcTxStatus.InFifo seen during the last flow control window. */
+#define REG_SHM2_POWER_POLICY ((volatile APE_SHM2_H_uint32_t*)0x60222060) /* EEE and clock profile of the management port. */
+#define REG_SHM2_POWER_POLICY_SWITCHES ((volatile APE_SHM2_H_uint32_t*)0x60222064) /* Number of times the power policy changed the profile. */
+#define REG_SHM2_POWER_POLICY_TIME ((volatile APE_SHM2_H_uint32_t*)0x60222068) /* Milliseconds spent in each power policy profile. */
 #define REG_SHM2_RCPU_SEG_SIG ((volatile APE_SHM2_H_uint32_t*)0x60222100) /* Set to APE_RCPU_MAGIC ('RCPU') by RX CPU. */
 #define REG_SHM2_RCPU_SEG_LENGTH ((volatile APE_SHM2_H_uint32_t*)0x60222104) /* Set to 0x34. */
 #define REG_SHM2_RCPU_INIT_COUNT ((volatile APE_SHM2_H_uint32_t*)0x60222108) /* Incremented by RX CPU every boot. */
@@ -108,6 +118,10 @@ typedef uint32_t APE_SHM2_H_uint32_t;
 #define REG_SHM2_RCPU_CFG_HW ((volatile APE_SHM2_H_uint32_t*)0x60222128) /* Set from  */
 #define REG_SHM2_RCPU_CFG_HW_2 ((volatile APE_SHM2_H_uint32_t*)0x6022212c) /* Set from  */
 #define REG_SHM2_RCPU_CPMU_STATUS ((volatile APE_SHM2_H_uint32_t*)0x60222130) /* Set from  */
+#define REG_SHM2_NCSI_TRACE_INDEX ((volatile APE_SHM2_H_uint32_t*)0x60222134) /* Number of NC-SI commands recorded in the trace ring. The most recent entry is at (index - 1) modulo the ring size. */
+#define REG_SHM2_NCSI_TRACE_COMMAND ((volatile APE_SHM2_H_uint32_t*)0x60222140) /* NC-SI command trace ring entry. */
+#define REG_SHM2_NCSI_TRACE_START ((volatile APE_SHM2_H_uint32_t*)0x60222180) /* 1MHz timestamp when the command was first seen by the APE. */
+#define REG_SHM2_NCSI_TRACE_END ((volatile APE_SHM2_H_uint32_t*)0x602221c0) /* 1MHz timestamp after the response was handed to the RMU. */
 #define REG_SHM2_HOST_SEG_SIG ((volatile APE_SHM2_H_uint32_t*)0x60222200) /* Set to APE_HOST_MAGIC ('HOST') to indicate the section is valid. */
 #define REG_SHM2_HOST_SEG_LEN ((volatile APE_SHM2_H_uint32_t*)0x60222204) /* Set to 0x20. */
 #define REG_SHM2_HOST_INIT_COUNT ((volatile APE_SHM2_H_uint32_t*)0x60222208) /* Incremented by host on every initialization. */
@@ -95,6 +95,16 @@ typedef uint32_t APE_SHM3_H_uint32_t;
 #define REG_SHM3_LOADER_COMMAND ((volatile APE_SHM3_H_uint32_t*)0x60223038) /* Command sent when using the the APE loader. Zero once handled. */
 #define REG_SHM3_LOADER_ARG0 ((volatile APE_SHM3_H_uint32_t*)0x6022303c) /* Argument 0 for the APE loader. */
 #define REG_SHM3_LOADER_ARG1 ((volatile APE_SHM3_H_uint32_t*)0x60223040) /* Argument 1 for the APE loader. */
+#define REG_SHM3_DRAIN_BUDGET ((volatile APE_SHM3_H_uint32_t*)0x60223044) /* Per direction packet budget for each main loop pass. Initialized from the build configuration, may be changed by the host. */
+#define REG_SHM3_DRAIN_BMC_EXHAUSTED ((volatile APE_SHM3_H_uint32_t*)0x60223048) /* Number of passes where the BMC to network drain stopped with the budget exhausted. */
+#define REG_SHM3_DRAIN_NETWORK_EXHAUSTED ((volatile APE_SHM3_H_uint32_t*)0x6022304c) /* Number of passes where the network to BMC drain stopped with the budget exhausted. */
+#define REG_SHM3_RMU_FLOW_CONTROL ((volatile APE_SHM3_H_uint32_t*)0x60223050) /* RMU flow control thresholds currently programmed into BmcToNcRxControl. */
+#define REG_SHM3_RMU_RX_BACKLOG ((volatile APE_SHM3_H_uint32_t*)0x60223054) /* Number of housekeeping samples that found a BMC frame still waiting in the RMU RX fifo. The RMU has no PAUSE counter, this approximates the time spent under flow control pressure. */
+#define REG_SHM3_RMU_FLOW_ADJUSTMENTS ((volatile APE_SHM3_H_uint32_t*)0x60223058) /* Number of times the RMU flow control thresholds were changed. */
+#define REG_SHM3_RMU_TX_FIFO_MIN_FREE ((volatile APE_SHM3_H_uint32_t*)0x6022305c) /* Lowest BmcToNcTxStatus.InFifo seen during the last flow control window. */
+#define REG_SHM3_POWER_POLICY ((volatile APE_SHM3_H_uint32_t*)0x60223060) /* EEE and clock profile of the management port. */
+#define REG_SHM3_POWER_POLICY_SWITCHES ((volatile APE_SHM3_H_uint32_t*)0x60223064) /* Number of times the power policy changed the profile. */
+#define REG_SHM3_POWER_POLICY_TIME ((volatile APE_SHM3_H_uint32_t*)0x60223068) /* Milliseconds spent in each power policy profile. */
 #define REG_SHM3_RCPU_SEG_SIG ((volatile APE_SHM3_H_uint32_t*)0x60223100) /* Set to APE_RCPU_MAGIC ('RCPU') by RX CPU. */
 #define REG_SHM3_RCPU_SEG_LENGTH ((volatile APE_SHM3_H_uint32_t*)0x60223104) /* Set to 0x34. */
 #define REG_SHM3_RCPU_INIT_COUNT ((volatile APE_SHM3_H_uint32_t*)0x60223108) /* Incremented by RX CPU every boot. */
@@ -108,6 +118,10 @@ typedef uint32_t APE_SHM3_H_uint32_t;
 #define REG_SHM3_RCPU_CFG_HW ((volatile APE_SHM3_H_uint32_t*)0x60223128) /* Set from  */
 #define REG_SHM3_RCPU_CFG_HW_2 ((volatile APE_SHM3_H_uint32_t*)0x6022312c) /* Set from  */
 #define REG_SHM3_RCPU_CPMU_STATUS ((volatile APE_SHM3_H_uint32_t*)0x60223130) /* Set from  */
+#define REG_SHM3_NCSI_TRACE_INDEX ((volatile APE_SHM3_H_uint32_t*)0x60223134) /* Number of NC-SI commands recorded in the trace ring. The most recent entry is at (index - 1) modulo the ring size. */
+#define REG_SHM3_NCSI_TRACE_COMMAND ((volatile APE_SHM3_H_uint32_t*)0x60223140) /* NC-SI command trace ring entry. */
+#define REG_SHM3_NCSI_TRACE_START ((volatile APE_SHM3_H_uint32_t*)0x60223180) /* 1MHz timestamp when the command was first seen by the APE. */
+#define REG_SHM3_NCSI_TRACE_END ((volatile APE_SHM3_H_uint32_t*)0x602231c0) /* 1MHz timestamp after the response was handed to the RMU. */
 #define REG_SHM3_HOST_SEG_SIG ((volatile APE_SHM3_H_uint32_t*)0x60223200) /* Set to APE_HOST_MAGIC ('HOST') to indicate the section is valid. */
 #define REG_SHM3_HOST_SEG_LEN ((volatile APE_SHM3_H_uint32_t*)0x60223204) /* Set to 0x20. */
 #define REG_SHM3_HOST_INIT_COUNT ((volatile APE_SHM3_H_uint32_t*)0x60223208) /* Incremented by host on every initialization. */
@@ -89,18 +89,23 @@ typedef uint32_t APE_SHM_CHANNEL1_H_uint32_t;
 #define REG_SHM_CHANNEL1_NCSI_CHANNEL_SETTING_1 ((volatile APE_SHM_CHANNEL1_H_uint32_t*)0x60220a14) /* This is the "Link Settings" value from NCSI Set Link. */
 #define REG_SHM_CHANNEL1_NCSI_CHANNEL_SETTING_2 ((volatile APE_SHM_CHANNEL1_H_uint32_t*)0x60220a18) /* This is the "OEM Settings" value from NCSI Set Link. */
 #define REG_SHM_CHANNEL1_NCSI_CHANNEL_VLAN ((volatile APE_SHM_CHANNEL1_H_uint32_t*)0x60220a1c) /* Receives VLAN mode from NCSI specification "Enable VLAN" command. */
+#define REG_SHM_CHANNEL1_NCSI_CHANNEL_RELOAD_TIME ((volatile APE_SHM_CHANNEL1_H_uint32_t*)0x60220a20) /* Duration of the last port reload in microseconds. */
 #define REG_SHM_CHANNEL1_NCSI_CHANNEL_ALT_HOST_MAC_HIGH ((volatile APE_SHM_CHANNEL1_H_uint32_t*)0x60220a24) /* Lower 16 bits of this word contains upper 16 bits of the MAC. */
 #define REG_SHM_CHANNEL1_NCSI_CHANNEL_ALT_HOST_MAC_MID ((volatile APE_SHM_CHANNEL1_H_uint32_t*)0x60220a28) /* Lower 16 bits of this word contains mid 16 bits of the MAC. */
 #define REG_SHM_CHANNEL1_NCSI_CHANNEL_ALT_HOST_MAC_LOW ((volatile APE_SHM_CHANNEL1_H_uint32_t*)0x60220a2c) /* Lower 16 bits of this word contains low 16 bits of the MAC. */
+#define REG_SHM_CHANNEL1_NCSI_CHANNEL_RELOAD_MAX_TIME ((volatile APE_SHM_CHANNEL1_H_uint32_t*)0x60220a30) /* Longest port reload in microseconds since the channel was last reset. */
 #define REG_SHM_CHANNEL1_NCSI_CHANNEL_MAC0_HIGH ((volatile APE_SHM_CHANNEL1_H_uint32_t*)0x60220a34) /* Lower 16 bits of this word contains upper 16 bits of the MAC. */
 #define REG_SHM_CHANNEL1_NCSI_CHANNEL_MAC0_MID ((volatile APE_SHM_CHANNEL1_H_uint32_t*)0x60220a38) /* Lower 16 bits of this word contains mid 16 bits of the MAC. */
 #define REG_SHM_CHANNEL1_NCSI_CHANNEL_MAC0_LOW ((volatile APE_SHM_CHANNEL1_H_uint32_t*)0x60220a3c) /* Lower 16 bits of this word contains low 16 bits of the MAC. */
+#define REG_SHM_CHANNEL1_NCSI_CHANNEL_RELOAD_WRITES ((volatile APE_SHM_CHANNEL1_H_uint32_t*)0x60220a40) /* Number of port configuration and filter registers written by the last port reload. */
 #define REG_SHM_CHANNEL1_NCSI_CHANNEL_MAC1_HIGH ((volatile APE_SHM_CHANNEL1_H_uint32_t*)0x60220a44) /* Lower 16 bits of this word contains upper 16 bits of the MAC. */
 #define REG_SHM_CHANNEL1_NCSI_CHANNEL_MAC1_MID ((volatile APE_SHM_CHANNEL1_H_uint32_t*)0x60220a48) /* Lower 16 bits of this word contains mid 16 bits of the MAC. */
 #define REG_SHM_CHANNEL1_NCSI_CHANNEL_MAC1_LOW ((volatile APE_SHM_CHANNEL1_H_uint32_t*)0x60220a4c) /* Lower 16 bits of this word contains low 16 bits of the MAC. */
+#define REG_SHM_CHANNEL1_NCSI_CHANNEL_MDIO_CACHE_HITS ((volatile APE_SHM_CHANNEL1_H_uint32_t*)0x60220a50) /* Number of PHY register reads answered from the MDIO register cache. */
 #define REG_SHM_CHANNEL1_NCSI_CHANNEL_MAC2_HIGH ((volatile APE_SHM_CHANNEL1_H_uint32_t*)0x60220a54) /* Lower 16 bits of this word contains upper 16 bits of the MAC. */
 #define REG_SHM_CHANNEL1_NCSI_CHANNEL_MAC2_MID ((volatile APE_SHM_CHANNEL1_H_uint32_t*)0x60220a58) /* Lower 16 bits of this word contains mid 16 bits of the MAC. */
 #define REG_SHM_CHANNEL1_NCSI_CHANNEL_MAC2_LOW ((volatile APE_SHM_CHANNEL1_H_uint32_t*)0x60220a5c) /* Lower 16 bits of this word contains low 16 bits of the MAC. */
+#define REG_SHM_CHANNEL1_NCSI_CHANNEL_MDIO_CACHE_MISSES ((volatile APE_SHM_CHANNEL1_H_uint32_t*)0x60220a60) /* Number of cacheable PHY register reads that required an MDIO transaction. */
 #define REG_SHM_CHANNEL1_NCSI_CHANNEL_MAC3_HIGH ((volatile APE_SHM_CHANNEL1_H_uint32_t*)0x60220a64) /* Lower 16 bits of this word contains upper 16 bits of the MAC. */
 #define REG_SHM_CHANNEL1_NCSI_CHANNEL_MAC3_MID ((volatile APE_SHM_CHANNEL1_H_uint32_t*)0x60220a68) /* Lower 16 bits of this word contains mid 16 bits of the MAC. */
 #define REG_SHM_CHANNEL1_NCSI_CHANNEL_MAC3_LOW ((volatile APE_SHM_CHANNEL1_H_uint32_t*)0x60220a6c) /* Lower 16 bits of this word contains low 16 bits of the MAC. */
@@ -113,7 +118,13 @@ typedef uint32_t APE_SHM_CHANNEL1_H_uint32_t;
 #define REG_SHM_CHANNEL1_NCSI_CHANNEL_PXE ((volatile APE_SHM_CHANNEL1_H_uint32_t*)0x60220a88) /*  */
 #define REG_SHM_CHANNEL1_NCSI_CHANNEL_DROPFIL ((volatile APE_SHM_CHANNEL1_H_uint32_t*)0x60220a8c) /*  */
 #define REG_SHM_CHANNEL1_NCSI_CHANNEL_SLINK ((volatile APE_SHM_CHANNEL1_H_uint32_t*)0x60220a90) /*  */
+#define REG_SHM_CHANNEL1_NCSI_CHANNEL_NCSI_COMMANDS ((volatile APE_SHM_CHANNEL1_H_uint32_t*)0x60220a94) /* Number of NC-SI commands received from the BMC. */
+#define REG_SHM_CHANNEL1_NCSI_CHANNEL_NCSI_COMMAND_ERRORS ((volatile APE_SHM_CHANNEL1_H_uint32_t*)0x60220a98) /* Number of NC-SI commands rejected as unsupported. */
+#define REG_SHM_CHANNEL1_NCSI_CHANNEL_AEN_TX ((volatile APE_SHM_CHANNEL1_H_uint32_t*)0x60220a9c) /* Number of AEN packets sent to the management controller. */
 #define REG_SHM_CHANNEL1_NCSI_CHANNEL_DBG ((volatile APE_SHM_CHANNEL1_H_uint32_t*)0x60220aa0) /*  */
+#define REG_SHM_CHANNEL1_NCSI_CHANNEL_NETWORK_DEFERRED ((volatile APE_SHM_CHANNEL1_H_uint32_t*)0x60220aa4) /* Number of passes where a network frame for the BMC was deferred because the NCSI fifo was full. */
+#define REG_SHM_CHANNEL1_NCSI_CHANNEL_NETWORK_ERRORS ((volatile APE_SHM_CHANNEL1_H_uint32_t*)0x60220aa8) /* Number of RX pool errors seen on the external network interface. */
+#define REG_SHM_CHANNEL1_NCSI_CHANNEL_NCSI_NO_BLOCKS ((volatile APE_SHM_CHANNEL1_H_uint32_t*)0x60220aac) /* Number of packets from the BMC dropped because no TX blocks were available. */
 #define REG_SHM_CHANNEL1_NCSI_CHANNEL_NETWORK_RX ((volatile APE_SHM_CHANNEL1_H_uint32_t*)0x60220ab0) /* Number of packets received from the external network interface */
 #define REG_SHM_CHANNEL1_NCSI_CHANNEL_NETWORK_TX ((volatile APE_SHM_CHANNEL1_H_uint32_t*)0x60220ab4) /* Number of packets transmited from the BCM5719 to external network interface */
 #define REG_SHM_CHANNEL1_NCSI_CHANNEL_NCSI_RX ((volatile APE_SHM_CHANNEL1_H_uint32_t*)0x60220ab8) /* Number of packets received from the BMC via NCSI */
@@ -121,6 +132,13 @@ typedef uint32_t APE_SHM_CHANNEL1_H_uint32_t;
 #define REG_SHM_CHANNEL1_NCSI_CHANNEL_NCSI_DROPPED ((volatile APE_SHM_CHANNEL1_H_uint32_t*)0x60220ac0) /* Number of packets dropped on the NCSI interface. */
 #define REG_SHM_CHANNEL1_NCSI_CHANNEL_NETWORK_DROPPED ((volatile APE_SHM_CHANNEL1_H_uint32_t*)0x60220ac4) /* Number of packets dropped on the external network interface. */
 #define REG_SHM_CHANNEL1_NCSI_CHANNEL_AEN ((volatile APE_SHM_CHANNEL1_H_uint32_t*)0x60220ac8) /* Number of AEN packets sent via NCSI */
+#define REG_SHM_CHANNEL1_NCSI_CHANNEL_LINK_DOWN ((volatile APE_SHM_CHANNEL1_H_uint32_t*)0x60220acc) /* Number of times the link was seen going down */
+#define REG_SHM_CHANNEL1_NCSI_CHANNEL_LINK_RESTARTS ((volatile APE_SHM_CHANNEL1_H_uint32_t*)0x60220ad0) /* Number of autonegotiation restarts issued by link recovery */
+#define REG_SHM_CHANNEL1_NCSI_CHANNEL_LINK_READVERTISE ((volatile APE_SHM_CHANNEL1_H_uint32_t*)0x60220ad4) /* Number of advertisement updates issued by link recovery */
+#define REG_SHM_CHANNEL1_NCSI_CHANNEL_LINK_RESETS ((volatile APE_SHM_CHANNEL1_H_uint32_t*)0x60220ad8) /* Number of PHY resets issued by link recovery */
+#define REG_SHM_CHANNEL1_NCSI_CHANNEL_LINK_DOWN_MAX_TIME ((volatile APE_SHM_CHANNEL1_H_uint32_t*)0x60220adc) /* Longest link down period, in milliseconds */
+#define REG_SHM_CHANNEL1_NCSI_CHANNEL_LINK_DOWN_HISTOGRAM ((volatile APE_SHM_CHANNEL1_H_uint32_t*)0x60220ae0) /* Number of link down periods lasting under 250ms, 1s, 4s, 16s, 64s and longer */
+#define REG_SHM_CHANNEL1_NCSI_CHANNEL_NCSI_COMMANDS_DROPPED ((volatile APE_SHM_CHANNEL1_H_uint32_t*)0x60220af8) /* Number of NC-SI commands rejected for an invalid payload length, an unknown channel or a channel that is not ready. */
 /** @brief Device SHM Registers, function 0 */
 extern volatile SHM_CHANNEL_t SHM_CHANNEL1;
 
@@ -136,7 +154,7 @@ extern volatile SHM_CHANNEL_t SHM_CHANNEL1;
 #undef BITFIELD_END
 
 #ifndef CXX_SIMULATOR
-_Static_assert(sizeof(SHM_CHANNEL_t) == 204, "sizeof(SHM_CHANNEL_t) must be 204");
+_Static_assert(sizeof(SHM_CHANNEL_t) == 252, "sizeof(SHM_CHANNEL_t) must be 252");
 #endif
 
 #endif /* !APE_SHM_CHANNEL1_H */
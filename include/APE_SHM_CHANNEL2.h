@@ -89,18 +89,23 @@ typedef uint32_t APE_SHM_CHANNEL2_H_uint32_t;
 #define REG_SHM_CHANNEL2_NCSI_CHANNEL_SETTING_1 ((volatile APE_SHM_CHANNEL2_H_uint32_t*)0x60220b14) /* This is the "Link Settings" value from NCSI Set Link. */
 #define REG_SHM_CHANNEL2_NCSI_CHANNEL_SETTING_2 ((volatile APE_SHM_CHANNEL2_H_uint32_t*)0x60220b18) /* This is the "OEM Settings" value from NCSI Set Link. */
 #define REG_SHM_CHANNEL2_NCSI_CHANNEL_VLAN ((volatile APE_SHM_CHANNEL2_H_uint32_t*)0x60220b1c) /* Receives VLAN mode from NCSI specification "Enable VLAN" command. */
+#define REG_SHM_CHANNEL2_NCSI_CHANNEL_RELOAD_TIME ((volatile APE_SHM_CHANNEL2_H_uint32_t*)0x60220b20) /* Duration of the last port reload in microseconds. */
 #define REG_SHM_CHANNEL2_NCSI_CHANNEL_ALT_HOST_MAC_HIGH ((volatile APE_SHM_CHANNEL2_H_uint32_t*)0x60220b24) /* Lower 16 bits of this word contains upper 16 bits of the MAC. */
 #define REG_SHM_CHANNEL2_NCSI_CHANNEL_ALT_HOST_MAC_MID ((volatile APE_SHM_CHANNEL2_H_uint32_t*)0x60220b28) /* Lower 16 bits of this word contains mid 16 bits of the MAC. */
 #define REG_SHM_CHANNEL2_NCSI_CHANNEL_ALT_HOST_MAC_LOW ((volatile APE_SHM_CHANNEL2_H_uint32_t*)0x60220b2c) /* Lower 16 bits of this word contains low 16 bits of the MAC. */
+#define REG_SHM_CHANNEL2_NCSI_CHANNEL_RELOAD_MAX_TIME ((volatile APE_SHM_CHANNEL2_H_uint32_t*)0x60220b30) /* Longest port reload in microseconds since the channel was last reset. */
 #define REG_SHM_CHANNEL2_NCSI_CHANNEL_MAC0_HIGH ((volatile APE_SHM_CHANNEL2_H_uint32_t*)0x60220b34) /* Lower 16 bits of this word contains upper 16 bits of the MAC. */
 #define REG_SHM_CHANNEL2_NCSI_CHANNEL_MAC0_MID ((volatile APE_SHM_CHANNEL2_H_uint32_t*)0x60220b38) /* Lower 16 bits of this word contains mid 16 bits of the MAC. */
 #define REG_SHM_CHANNEL2_NCSI_CHANNEL_MAC0_LOW ((volatile APE_SHM_CHANNEL2_H_uint32_t*)0x60220b3c) /* Lower 16 bits of this word contains low 16 bits of the MAC. */
+#define REG_SHM_CHANNEL2_NCSI_CHANNEL_RELOAD_WRITES ((volatile APE_SHM_CHANNEL2_H_uint32_t*)0x60220b40) /* Number of port configuration and filter registers written by the last port reload. */
 #define REG_SHM_CHANNEL2_NCSI_CHANNEL_MAC1_HIGH ((volatile APE_SHM_CHANNEL2_H_uint32_t*)0x60220b44) /* Lower 16 bits of this word contains upper 16 bits of the MAC. */
 #define REG_SHM_CHANNEL2_NCSI_CHANNEL_MAC1_MID ((volatile APE_SHM_CHANNEL2_H_uint32_t*)0x60220b48) /* Lower 16 bits of this word contains mid 16 bits of the MAC. */
 #define REG_SHM_CHANNEL2_NCSI_CHANNEL_MAC1_LOW ((volatile APE_SHM_CHANNEL2_H_uint32_t*)0x60220b4c) /* Lower 16 bits of this word contains low 16 bits of the MAC. */
+#define REG_SHM_CHANNEL2_NCSI_CHANNEL_MDIO_CACHE_HITS ((volatile APE_SHM_CHANNEL2_H_uint32_t*)0x60220b50) /* Number of PHY register reads answered from the MDIO register cache. */
 #define REG_SHM_CHANNEL2_NCSI_CHANNEL_MAC2_HIGH ((volatile APE_SHM_CHANNEL2_H_uint32_t*)0x60220b54) /* Lower 16 bits of this word contains upper 16 bits of the MAC. */
 #define REG_SHM_CHANNEL2_NCSI_CHANNEL_MAC2_MID ((volatile APE_SHM_CHANNEL2_H_uint32_t*)0x60220b58) /* Lower 16 bits of this word contains mid 16 bits of the MAC. */
 #define REG_SHM_CHANNEL2_NCSI_CHANNEL_MAC2_LOW ((volatile APE_SHM_CHANNEL2_H_uint32_t*)0x60220b5c) /* Lower 16 bits of this word contains low 16 bits of the MAC. */
+#define REG_SHM_CHANNEL2_NCSI_CHANNEL_MDIO_CACHE_MISSES ((volatile APE_SHM_CHANNEL2_H_uint32_t*)0x60220b60) /* Number of cacheable PHY register reads that required an MDIO transaction. */
 #define REG_SHM_CHANNEL2_NCSI_CHANNEL_MAC3_HIGH ((volatile APE_SHM_CHANNEL2_H_uint32_t*)0x60220b64) /* Lower 16 bits of this word contains upper 16 bits of the MAC. */
 #define REG_SHM_CHANNEL2_NCSI_CHANNEL_MAC3_MID ((volatile APE_SHM_CHANNEL2_H_uint32_t*)0x60220b68) /* Lower 16 bits of this word contains mid 16 bits of the MAC. */
 #define REG_SHM_CHANNEL2_NCSI_CHANNEL_MAC3_LOW ((volatile APE_SHM_CHANNEL2_H_uint32_t*)0x60220b6c) /* Lower 16 bits of this word contains low 16 bits of the MAC. */
@@ -113,7 +118,13 @@ typedef uint32_t APE_SHM_CHANNEL2_H_uint32_t;
 #define REG_SHM_CHANNEL2_NCSI_CHANNEL_PXE ((volatile APE_SHM_CHANNEL2_H_uint32_t*)0x60220b88) /*  */
 #define REG_SHM_CHANNEL2_NCSI_CHANNEL_DROPFIL ((volatile APE_SHM_CHANNEL2_H_uint32_t*)0x60220b8c) /*  */
 #define REG_SHM_CHANNEL2_NCSI_CHANNEL_SLINK ((volatile APE_SHM_CHANNEL2_H_uint32_t*)0x60220b90) /*  */
+#define REG_SHM_CHANNEL2_NCSI_CHANNEL_NCSI_COMMANDS ((volatile APE_SHM_CHANNEL2_H_uint32_t*)0x60220b94) /* Number of NC-SI commands received from the BMC. */
+#define REG_SHM_CHANNEL2_NCSI_CHANNEL_NCSI_COMMAND_ERRORS ((volatile APE_SHM_CHANNEL2_H_uint32_t*)0x60220b98) /* Number of NC-SI commands rejected as unsupported. */
+#define REG_SHM_CHANNEL2_NCSI_CHANNEL_AEN_TX ((volatile APE_SHM_CHANNEL2_H_uint32_t*)0x60220b9c) /* Number of AEN packets sent to the management controller. */
 #define REG_SHM_CHANNEL2_NCSI_CHANNEL_DBG ((volatile APE_SHM_CHANNEL2_H_uint32_t*)0x60220ba0) /*  */
+#define REG_SHM_CHANNEL2_NCSI_CHANNEL_NETWORK_DEFERRED ((volatile APE_SHM_CHANNEL2_H_uint32_t*)0x60220ba4) /* Number of passes where a network frame for the BMC was deferred because the NCSI fifo was full. */
+#define REG_SHM_CHANNEL2_NCSI_CHANNEL_NETWORK_ERRORS ((volatile APE_SHM_CHANNEL2_H_uint32_t*)0x60220ba8) /* Number of RX pool errors seen on the external network interface. */
+#define REG_SHM_CHANNEL2_NCSI_CHANNEL_NCSI_NO_BLOCKS ((volatile APE_SHM_CHANNEL2_H_uint32_t*)0x60220bac) /* Number of packets from the BMC dropped because no TX blocks were available. */
 #define REG_SHM_CHANNEL2_NCSI_CHANNEL_NETWORK_RX ((volatile APE_SHM_CHANNEL2_H_uint32_t*)0x60220bb0) /* Number of packets received from the external network interface */
 #define REG_SHM_CHANNEL2_NCSI_CHANNEL_NETWORK_TX ((volatile APE_SHM_CHANNEL2_H_uint32_t*)0x60220bb4) /* Number of packets transmited from the BCM5719 to external network interface */
 #define REG_SHM_CHANNEL2_NCSI_CHANNEL_NCSI_RX ((volatile APE_SHM_CHANNEL2_H_uint32_t*)0x60220bb8) /* Number of packets received from the BMC via NCSI */
@@ -121,6 +132,13 @@ typedef uint32_t APE_SHM_CHANNEL2_H_uint32_t;
 #define REG_SHM_CHANNEL2_NCSI_CHANNEL_NCSI_DROPPED ((volatile APE_SHM_CHANNEL2_H_uint32_t*)0x60220bc0) /* Number of packets dropped on the NCSI interface. */
 #define REG_SHM_CHANNEL2_NCSI_CHANNEL_NETWORK_DROPPED ((volatile APE_SHM_CHANNEL2_H_uint32_t*)0x60220bc4) /* Number of packets dropped on the external network interface. */
 #define REG_SHM_CHANNEL2_NCSI_CHANNEL_AEN ((volatile APE_SHM_CHANNEL2_H_uint32_t*)0x60220bc8) /* Number of AEN packets sent via NCSI */
+#define REG_SHM_CHANNEL2_NCSI_CHANNEL_LINK_DOWN ((volatile APE_SHM_CHANNEL2_H_uint32_t*)0x60220bcc) /* Number of times the link was seen going down */
+#define REG_SHM_CHANNEL2_NCSI_CHANNEL_LINK_RESTARTS ((volatile APE_SHM_CHANNEL2_H_uint32_t*)0x60220bd0) /* Number of autonegotiation restarts issued by link recovery */
+#define REG_SHM_CHANNEL2_NCSI_CHANNEL_LINK_READVERTISE ((volatile APE_SHM_CHANNEL2_H_uint32_t*)0x60220bd4) /* Number of advertisement updates issued by link recovery */
+#define REG_SHM_CHANNEL2_NCSI_CHANNEL_LINK_RESETS ((volatile APE_SHM_CHANNEL2_H_uint32_t*)0x60220bd8) /* Number of PHY resets issued by link recovery */
+#define REG_SHM_CHANNEL2_NCSI_CHANNEL_LINK_DOWN_MAX_TIME ((volatile APE_SHM_CHANNEL2_H_uint32_t*)0x60220bdc) /* Longest link down period, in milliseconds */
+#define REG_SHM_CHANNEL2_NCSI_CHANNEL_LINK_DOWN_HISTOGRAM ((volatile APE_SHM_CHANNEL2_H_uint32_t*)0x60220be0) /* Number of link down periods lasting under 250ms, 1s, 4s, 16s, 64s and longer */
+#define REG_SHM_CHANNEL2_NCSI_CHANNEL_NCSI_COMMANDS_DROPPED ((volatile APE_SHM_CHANNEL2_H_uint32_t*)0x60220bf8) /* Number of NC-SI commands rejected for an invalid payload length, an unknown channel or a channel that is not ready. */
 /** @brief Device SHM Registers, function 0 */
 extern volatile SHM_CHANNEL_t SHM_CHANNEL2;
 
@@ -136,7 +154,7 @@ extern volatile SHM_CHANNEL_t SHM_CHANNEL2;
 #undef BITFIELD_END
 
 #ifndef CXX_SIMULATOR
-_Static_assert(sizeof(SHM_CHANNEL_t) == 204, "sizeof(SHM_CHANNEL_t) must be 204");
+_Static_assert(sizeof(SHM_CHANNEL_t) == 252, "sizeof(SHM_CHANNEL_t) must be 252");
 #endif
 
 #endif /* !APE_SHM_CHANNEL2_H */
@@ -624,6 +624,31 @@ typedef register_container RegSHM_CHANNELNcsiChannelVlan_t {
 #endif /* CXX_SIMULATOR */
 } RegSHM_CHANNELNcsiChannelVlan_t;
 
+#define REG_SHM_CHANNEL0_NCSI_CHANNEL_RELOAD_TIME ((volatile BCM5719_SHM_CHANNEL0_H_uint32_t*)0xc0014920) /* Duration of the last port reload in microseconds. */
+/** @brief Register definition for @ref SHM_CHANNEL_t.NcsiChannelReloadTime. */
+typedef register_container RegSHM_CHANNELNcsiChannelReloadTime_t {
+    /** @brief 32bit direct register access. */
+    BCM5719_SHM_CHANNEL0_H_uint32_t r32;
+#ifdef CXX_SIMULATOR
+    /** @brief Register name for use with the simulator. */
+    const char* getName(void) { return "NcsiChannelReloadTime"; }
+
+    /** @brief Print register value. */
+    void print(void) { r32.print(); }
+
+    RegSHM_CHANNELNcsiChannelReloadTime_t()
+    {
+        /** @brief constructor for @ref SHM_CHANNEL_t.NcsiChannelReloadTime. */
+        r32.setName("NcsiChannelReloadTime");
+    }
+    RegSHM_CHANNELNcsiChannelReloadTime_t& operator=(const RegSHM_CHANNELNcsiChannelReloadTime_t& other)
+    {
+        r32 = other.r32;
+        return *this;
+    }
+#endif /* CXX_SIMULATOR */
+} RegSHM_CHANNELNcsiChannelReloadTime_t;
+
 #define REG_SHM_CHANNEL0_NCSI_CHANNEL_ALT_HOST_MAC_HIGH ((volatile BCM5719_SHM_CHANNEL0_H_uint32_t*)0xc0014924) /* Lower 16 bits of this word contains upper 16 bits of the MAC. */
 /** @brief Register definition for @ref SHM_CHANNEL_t.NcsiChannelAltHostMacHigh. */
 typedef register_container RegSHM_CHANNELNcsiChannelAltHostMacHigh_t {
@@ -699,6 +724,31 @@ typedef register_container RegSHM_CHANNELNcsiChannelAltHostMacLow_t {
 #endif /* CXX_SIMULATOR */
 } RegSHM_CHANNELNcsiChannelAltHostMacLow_t;
 
+#define REG_SHM_CHANNEL0_NCSI_CHANNEL_RELOAD_MAX_TIME ((volatile BCM5719_SHM_CHANNEL0_H_uint32_t*)0xc0014930) /* Longest port reload in microseconds since the channel was last reset. */
+/** @brief Register definition for @ref SHM_CHANNEL_t.NcsiChannelReloadMaxTime. */
+typedef register_container RegSHM_CHANNELNcsiChannelReloadMaxTime_t {
+    /** @brief 32bit direct register access. */
+    BCM5719_SHM_CHANNEL0_H_uint32_t r32;
+#ifdef CXX_SIMULATOR
+    /** @brief Register name for use with the simulator. */
+    const char* getName(void) { return "NcsiChannelReloadMaxTime"; }
+
+    /** @brief Print register value. */
+    void print(void) { r32.print(); }
+
+    RegSHM_CHANNELNcsiChannelReloadMaxTime_t()
+    {
+        /** @brief constructor for @ref SHM_CHANNEL_t.NcsiChannelReloadMaxTime. */
+        r32.setName("NcsiChannelReloadMaxTime");
+    }
+    RegSHM_CHANNELNcsiChannelReloadMaxTime_t& operator=(const RegSHM_CHANNELNcsiChannelReloadMaxTime_t& other)
+    {
+        r32 = other.r32;
+        return *this;
+    }
+#endif /* CXX_SIMULATOR */
+} RegSHM_CHANNELNcsiChannelReloadMaxTime_t;
+
 #define REG_SHM_CHANNEL0_NCSI_CHANNEL_MAC0_HIGH ((volatile BCM5719_SHM_CHANNEL0_H_uint32_t*)0xc0014934) /* Lower 16 bits of this word contains upper 16 bits of the MAC. */
 /** @brief Register definition for @ref SHM_CHANNEL_t.NcsiChannelMac0High. */
 typedef register_container RegSHM_CHANNELMacHigh_t {
@@ -783,6 +833,81 @@ typedef register_container RegSHM_CHANNELMacLow_t {
 #define REG_SHM_CHANNEL0_NCSI_CHANNEL_MAC3_HIGH ((volatile BCM5719_SHM_CHANNEL0_H_uint32_t*)0xc0014964) /* Lower 16 bits of this word contains upper 16 bits of the MAC. */
 #define REG_SHM_CHANNEL0_NCSI_CHANNEL_MAC3_MID ((volatile BCM5719_SHM_CHANNEL0_H_uint32_t*)0xc0014968) /* Lower 16 bits of this word contains mid 16 bits of the MAC. */
 #define REG_SHM_CHANNEL0_NCSI_CHANNEL_MAC3_LOW ((volatile BCM5719_SHM_CHANNEL0_H_uint32_t*)0xc001496c) /* Lower 16 bits of this word contains low 16 bits of the MAC. */
+#define REG_SHM_CHANNEL0_NCSI_CHANNEL_RELOAD_WRITES ((volatile BCM5719_SHM_CHANNEL0_H_uint32_t*)0xc0014940) /* Number of port configuration and filter registers written by the last port reload. */
+/** @brief Register definition for @ref SHM_CHANNEL_t.NcsiChannelReloadWrites. */
+typedef register_container RegSHM_CHANNELNcsiChannelReloadWrites_t {
+    /** @brief 32bit direct register access. */
+    BCM5719_SHM_CHANNEL0_H_uint32_t r32;
+#ifdef CXX_SIMULATOR
+    /** @brief Register name for use with the simulator. */
+    const char* getName(void) { return "NcsiChannelReloadWrites"; }
+
+    /** @brief Print register value. */
+    void print(void) { r32.print(); }
+
+    RegSHM_CHANNELNcsiChannelReloadWrites_t()
+    {
+        /** @brief constructor for @ref SHM_CHANNEL_t.NcsiChannelReloadWrites. */
+        r32.setName("NcsiChannelReloadWrites");
+    }
+    RegSHM_CHANNELNcsiChannelReloadWrites_t& operator=(const RegSHM_CHANNELNcsiChannelReloadWrites_t& other)
+    {
+        r32 = other.r32;
+        return *this;
+    }
+#endif /* CXX_SIMULATOR */
+} RegSHM_CHANNELNcsiChannelReloadWrites_t;
+
+#define REG_SHM_CHANNEL0_NCSI_CHANNEL_MDIO_CACHE_HITS ((volatile BCM5719_SHM_CHANNEL0_H_uint32_t*)0xc0014950) /* Number of PHY register reads answered from the MDIO register cache. */
+/** @brief Register definition for @ref SHM_CHANNEL_t.NcsiChannelMdioCacheHits. */
+typedef register_container RegSHM_CHANNELNcsiChannelMdioCacheHits_t {
+    /** @brief 32bit direct register access. */
+    BCM5719_SHM_CHANNEL0_H_uint32_t r32;
+#ifdef CXX_SIMULATOR
+    /** @brief Register name for use with the simulator. */
+    const char* getName(void) { return "NcsiChannelMdioCacheHits"; }
+
+    /** @brief Print register value. */
+    void print(void) { r32.print(); }
+
+    RegSHM_CHANNELNcsiChannelMdioCacheHits_t()
+    {
+        /** @brief constructor for @ref SHM_CHANNEL_t.NcsiChannelMdioCacheHits. */
+        r32.setName("NcsiChannelMdioCacheHits");
+    }
+    RegSHM_CHANNELNcsiChannelMdioCacheHits_t& operator=(const RegSHM_CHANNELNcsiChannelMdioCacheHits_t& other)
+    {
+        r32 = other.r32;
+        return *this;
+    }
+#endif /* CXX_SIMULATOR */
+} RegSHM_CHANNELNcsiChannelMdioCacheHits_t;
+
+#define REG_SHM_CHANNEL0_NCSI_CHANNEL_MDIO_CACHE_MISSES ((volatile BCM5719_SHM_CHANNEL0_H_uint32_t*)0xc0014960) /* Number of cacheable PHY register reads that required an MDIO transaction. */
+/** @brief Register definition for @ref SHM_CHANNEL_t.NcsiChannelMdioCacheMisses. */
+typedef register_container RegSHM_CHANNELNcsiChannelMdioCacheMisses_t {
+    /** @brief 32bit direct register access. */
+    BCM5719_SHM_CHANNEL0_H_uint32_t r32;
+#ifdef CXX_SIMULATOR
+    /** @brief Register name for use with the simulator. */
+    const char* getName(void) { return "NcsiChannelMdioCacheMisses"; }
+
+    /** @brief Print register value. */
+    void print(void) { r32.print(); }
+
+    RegSHM_CHANNELNcsiChannelMdioCacheMisses_t()
+    {
+        /** @brief constructor for @ref SHM_CHANNEL_t.NcsiChannelMdioCacheMisses. */
+        r32.setName("NcsiChannelMdioCacheMisses");
+    }
+    RegSHM_CHANNELNcsiChannelMdioCacheMisses_t& operator=(const RegSHM_CHANNELNcsiChannelMdioCacheMisses_t& other)
+    {
+        r32 = other.r32;
+        return *this;
+    }
+#endif /* CXX_SIMULATOR */
+} RegSHM_CHANNELNcsiChannelMdioCacheMisses_t;
+
 #define REG_SHM_CHANNEL0_NCSI_CHANNEL_MAC0_VLAN_VALID ((volatile BCM5719_SHM_CHANNEL0_H_uint32_t*)0xc0014970) /* Nonzero indicates VLAN field is valid */
 /** @brief Register definition for @ref SHM_CHANNEL_t.NcsiChannelMac0VlanValid. */
 typedef register_container RegSHM_CHANNELNcsiChannelMac0VlanValid_t {
@@ -1225,6 +1350,81 @@ typedef register_container RegSHM_CHANNELNcsiChannelSlink_t {
 #endif /* CXX_SIMULATOR */
 } RegSHM_CHANNELNcsiChannelSlink_t;
 
+#define REG_SHM_CHANNEL0_NCSI_CHANNEL_NCSI_COMMANDS ((volatile BCM5719_SHM_CHANNEL0_H_uint32_t*)0xc0014994) /* Number of NC-SI commands received from the BMC. */
+/** @brief Register definition for @ref SHM_CHANNEL_t.NcsiChannelNcsiCommands. */
+typedef register_container RegSHM_CHANNELNcsiChannelNcsiCommands_t {
+    /** @brief 32bit direct register access. */
+    BCM5719_SHM_CHANNEL0_H_uint32_t r32;
+#ifdef CXX_SIMULATOR
+    /** @brief Register name for use with the simulator. */
+    const char* getName(void) { return "NcsiChannelNcsiCommands"; }
+
+    /** @brief Print register value. */
+    void print(void) { r32.print(); }
+
+    RegSHM_CHANNELNcsiChannelNcsiCommands_t()
+    {
+        /** @brief constructor for @ref SHM_CHANNEL_t.NcsiChannelNcsiCommands. */
+        r32.setName("NcsiChannelNcsiCommands");
+    }
+    RegSHM_CHANNELNcsiChannelNcsiCommands_t& operator=(const RegSHM_CHANNELNcsiChannelNcsiCommands_t& other)
+    {
+        r32 = other.r32;
+        return *this;
+    }
+#endif /* CXX_SIMULATOR */
+} RegSHM_CHANNELNcsiChannelNcsiCommands_t;
+
+#define REG_SHM_CHANNEL0_NCSI_CHANNEL_NCSI_COMMAND_ERRORS ((volatile BCM5719_SHM_CHANNEL0_H_uint32_t*)0xc0014998) /* Number of NC-SI commands rejected as unsupported. */
+/** @brief Register definition for @ref SHM_CHANNEL_t.NcsiChannelNcsiCommandErrors. */
+typedef register_container RegSHM_CHANNELNcsiChannelNcsiCommandErrors_t {
+    /** @brief 32bit direct register access. */
+    BCM5719_SHM_CHANNEL0_H_uint32_t r32;
+#ifdef CXX_SIMULATOR
+    /** @brief Register name for use with the simulator. */
+    const char* getName(void) { return "NcsiChannelNcsiCommandErrors"; }
+
+    /** @brief Print register value. */
+    void print(void) { r32.print(); }
+
+    RegSHM_CHANNELNcsiChannelNcsiCommandErrors_t()
+    {
+        /** @brief constructor for @ref SHM_CHANNEL_t.NcsiChannelNcsiCommandErrors. */
+        r32.setName("NcsiChannelNcsiCommandErrors");
+    }
+    RegSHM_CHANNELNcsiChannelNcsiCommandErrors_t& operator=(const RegSHM_CHANNELNcsiChannelNcsiCommandErrors_t& other)
+    {
+        r32 = other.r32;
+        return *this;
+    }
+#endif /* CXX_SIMULATOR */
+} RegSHM_CHANNELNcsiChannelNcsiCommandErrors_t;
+
+#define REG_SHM_CHANNEL0_NCSI_CHANNEL_AEN_TX ((volatile BCM5719_SHM_CHANNEL0_H_uint32_t*)0xc001499c) /* Number of AEN packets sent to the management controller. */
+/** @brief Register definition for @ref SHM_CHANNEL_t.NcsiChannelAenTx. */
+typedef register_container RegSHM_CHANNELNcsiChannelAenTx_t {
+    /** @brief 32bit direct register access. */
+    BCM5719_SHM_CHANNEL0_H_uint32_t r32;
+#ifdef CXX_SIMULATOR
+    /** @brief Register name for use with the simulator. */
+    const char* getName(void) { return "NcsiChannelAenTx"; }
+
+    /** @brief Print register value. */
+    void print(void) { r32.print(); }
+
+    RegSHM_CHANNELNcsiChannelAenTx_t()
+    {
+        /** @brief constructor for @ref SHM_CHANNEL_t.NcsiChannelAenTx. */
+        r32.setName("NcsiChannelAenTx");
+    }
+    RegSHM_CHANNELNcsiChannelAenTx_t& operator=(const RegSHM_CHANNELNcsiChannelAenTx_t& other)
+    {
+        r32 = other.r32;
+        return *this;
+    }
+#endif /* CXX_SIMULATOR */
+} RegSHM_CHANNELNcsiChannelAenTx_t;
+
 #define REG_SHM_CHANNEL0_NCSI_CHANNEL_DBG ((volatile BCM5719_SHM_CHANNEL0_H_uint32_t*)0xc00149a0) /*  */
 /** @brief Register definition for @ref SHM_CHANNEL_t.NcsiChannelDbg. */
 typedef register_container RegSHM_CHANNELNcsiChannelDbg_t {
@@ -1250,6 +1450,81 @@ typedef register_container RegSHM_CHANNELNcsiChannelDbg_t {
 #endif /* CXX_SIMULATOR */
 } RegSHM_CHANNELNcsiChannelDbg_t;
 
+#define REG_SHM_CHANNEL0_NCSI_CHANNEL_NETWORK_DEFERRED ((volatile BCM5719_SHM_CHANNEL0_H_uint32_t*)0xc00149a4) /* Number of passes where a network frame for the BMC was deferred because the NCSI fifo was full. */
+/** @brief Register definition for @ref SHM_CHANNEL_t.NcsiChannelNetworkDeferred. */
+typedef register_container RegSHM_CHANNELNcsiChannelNetworkDeferred_t {
+    /** @brief 32bit direct register access. */
+    BCM5719_SHM_CHANNEL0_H_uint32_t r32;
+#ifdef CXX_SIMULATOR
+    /** @brief Register name for use with the simulator. */
+    const char* getName(void) { return "NcsiChannelNetworkDeferred"; }
+
+    /** @brief Print register value. */
+    void print(void) { r32.print(); }
+
+    RegSHM_CHANNELNcsiChannelNetworkDeferred_t()
+    {
+        /** @brief constructor for @ref SHM_CHANNEL_t.NcsiChannelNetworkDeferred. */
+        r32.setName("NcsiChannelNetworkDeferred");
+    }
+    RegSHM_CHANNELNcsiChannelNetworkDeferred_t& operator=(const RegSHM_CHANNELNcsiChannelNetworkDeferred_t& other)
+    {
+        r32 = other.r32;
+        return *this;
+    }
+#endif /* CXX_SIMULATOR */
+} RegSHM_CHANNELNcsiChannelNetworkDeferred_t;
+
+#define REG_SHM_CHANNEL0_NCSI_CHANNEL_NETWORK_ERRORS ((volatile BCM5719_SHM_CHANNEL0_H_uint32_t*)0xc00149a8) /* Number of RX pool errors seen on the external network interface. */
+/** @brief Register definition for @ref SHM_CHANNEL_t.NcsiChannelNetworkErrors. */
+typedef register_container RegSHM_CHANNELNcsiChannelNetworkErrors_t {
+    /** @brief 32bit direct register access. */
+    BCM5719_SHM_CHANNEL0_H_uint32_t r32;
+#ifdef CXX_SIMULATOR
+    /** @brief Register name for use with the simulator. */
+    const char* getName(void) { return "NcsiChannelNetworkErrors"; }
+
+    /** @brief Print register value. */
+    void print(void) { r32.print(); }
+
+    RegSHM_CHANNELNcsiChannelNetworkErrors_t()
+    {
+        /** @brief constructor for @ref SHM_CHANNEL_t.NcsiChannelNetworkErrors. */
+        r32.setName("NcsiChannelNetworkErrors");
+    }
+    RegSHM_CHANNELNcsiChannelNetworkErrors_t& operator=(const RegSHM_CHANNELNcsiChannelNetworkErrors_t& other)
+    {
+        r32 = other.r32;
+        return *this;
+    }
+#endif /* CXX_SIMULATOR */
+} RegSHM_CHANNELNcsiChannelNetworkErrors_t;
+
+#define REG_SHM_CHANNEL0_NCSI_CHANNEL_NCSI_NO_BLOCKS ((volatile BCM5719_SHM_CHANNEL0_H_uint32_t*)0xc00149ac) /* Number of packets from the BMC dropped because no TX blocks were available. */
+/** @brief Register definition for @ref SHM_CHANNEL_t.NcsiChannelNcsiNoBlocks. */
+typedef register_container RegSHM_CHANNELNcsiChannelNcsiNoBlocks_t {
+    /** @brief 32bit direct register access. */
+    BCM5719_SHM_CHANNEL0_H_uint32_t r32;
+#ifdef CXX_SIMULATOR
+    /** @brief Register name for use with the simulator. */
+    const char* getName(void) { return "NcsiChannelNcsiNoBlocks"; }
+
+    /** @brief Print register value. */
+    void print(void) { r32.print(); }
+
+    RegSHM_CHANNELNcsiChannelNcsiNoBlocks_t()
+    {
+        /** @brief constructor for @ref SHM_CHANNEL_t.NcsiChannelNcsiNoBlocks. */
+        r32.setName("NcsiChannelNcsiNoBlocks");
+    }
+    RegSHM_CHANNELNcsiChannelNcsiNoBlocks_t& operator=(const RegSHM_CHANNELNcsiChannelNcsiNoBlocks_t& other)
+    {
+        r32 = other.r32;
+        return *this;
+    }
+#endif /* CXX_SIMULATOR */
+} RegSHM_CHANNELNcsiChannelNcsiNoBlocks_t;
+
 #define REG_SHM_CHANNEL0_NCSI_CHANNEL_NETWORK_RX ((volatile BCM5719_SHM_CHANNEL0_H_uint32_t*)0xc00149b0) /* Number of packets received from the external network interface */
 /** @brief Register definition for @ref SHM_CHANNEL_t.NcsiChannelNetworkRx. */
 typedef register_container RegSHM_CHANNELNcsiChannelNetworkRx_t {
@@ -1468,6 +1743,181 @@ typedef register_container RegSHM_CHANNELNcsiChannelAen_t {
 #endif /* CXX_SIMULATOR */
 } RegSHM_CHANNELNcsiChannelAen_t;
 
+#define REG_SHM_CHANNEL0_NCSI_CHANNEL_LINK_DOWN ((volatile BCM5719_SHM_CHANNEL0_H_uint32_t*)0xc00149cc) /* Number of times the link was seen going down */
+/** @brief Register definition for @ref SHM_CHANNEL_t.NcsiChannelLinkDown. */
+typedef register_container RegSHM_CHANNELNcsiChannelLinkDown_t {
+    /** @brief 32bit direct register access. */
+    BCM5719_SHM_CHANNEL0_H_uint32_t r32;
+#ifdef CXX_SIMULATOR
+    /** @brief Register name for use with the simulator. */
+    const char* getName(void) { return "NcsiChannelLinkDown"; }
+
+    /** @brief Print register value. */
+    void print(void) { r32.print(); }
+
+    RegSHM_CHANNELNcsiChannelLinkDown_t()
+    {
+        /** @brief constructor for @ref SHM_CHANNEL_t.NcsiChannelLinkDown. */
+        r32.setName("NcsiChannelLinkDown");
+    }
+    RegSHM_CHANNELNcsiChannelLinkDown_t& operator=(const RegSHM_CHANNELNcsiChannelLinkDown_t& other)
+    {
+        r32 = other.r32;
+        return *this;
+    }
+#endif /* CXX_SIMULATOR */
+} RegSHM_CHANNELNcsiChannelLinkDown_t;
+
+#define REG_SHM_CHANNEL0_NCSI_CHANNEL_LINK_RESTARTS ((volatile BCM5719_SHM_CHANNEL0_H_uint32_t*)0xc00149d0) /* Number of autonegotiation restarts issued by link recovery */
+/** @brief Register definition for @ref SHM_CHANNEL_t.NcsiChannelLinkRestarts. */
+typedef register_container RegSHM_CHANNELNcsiChannelLinkRestarts_t {
+    /** @brief 32bit direct register access. */
+    BCM5719_SHM_CHANNEL0_H_uint32_t r32;
+#ifdef CXX_SIMULATOR
+    /** @brief Register name for use with the simulator. */
+    const char* getName(void) { return "NcsiChannelLinkRestarts"; }
+
+    /** @brief Print register value. */
+    void print(void) { r32.print(); }
+
+    RegSHM_CHANNELNcsiChannelLinkRestarts_t()
+    {
+        /** @brief constructor for @ref SHM_CHANNEL_t.NcsiChannelLinkRestarts. */
+        r32.setName("NcsiChannelLinkRestarts");
+    }
+    RegSHM_CHANNELNcsiChannelLinkRestarts_t& operator=(const RegSHM_CHANNELNcsiChannelLinkRestarts_t& other)
+    {
+        r32 = other.r32;
+        return *this;
+    }
+#endif /* CXX_SIMULATOR */
+} RegSHM_CHANNELNcsiChannelLinkRestarts_t;
+
+#define REG_SHM_CHANNEL0_NCSI_CHANNEL_LINK_READVERTISE ((volatile BCM5719_SHM_CHANNEL0_H_uint32_t*)0xc00149d4) /* Number of advertisement updates issued by link recovery */
+/** @brief Register definition for @ref SHM_CHANNEL_t.NcsiChannelLinkReadvertise. */
+typedef register_container RegSHM_CHANNELNcsiChannelLinkReadvertise_t {
+    /** @brief 32bit direct register access. */
+    BCM5719_SHM_CHANNEL0_H_uint32_t r32;
+#ifdef CXX_SIMULATOR
+    /** @brief Register name for use with the simulator. */
+    const char* getName(void) { return "NcsiChannelLinkReadvertise"; }
+
+    /** @brief Print register value. */
+    void print(void) { r32.print(); }
+
+    RegSHM_CHANNELNcsiChannelLinkReadvertise_t()
+    {
+        /** @brief constructor for @ref SHM_CHANNEL_t.NcsiChannelLinkReadvertise. */
+        r32.setName("NcsiChannelLinkReadvertise");
+    }
+    RegSHM_CHANNELNcsiChannelLinkReadvertise_t& operator=(const RegSHM_CHANNELNcsiChannelLinkReadvertise_t& other)
+    {
+        r32 = other.r32;
+        return *this;
+    }
+#endif /* CXX_SIMULATOR */
+} RegSHM_CHANNELNcsiChannelLinkReadvertise_t;
+
+#define REG_SHM_CHANNEL0_NCSI_CHANNEL_LINK_RESETS ((volatile BCM5719_SHM_CHANNEL0_H_uint32_t*)0xc00149d8) /* Number of PHY resets issued by link recovery */
+/** @brief Register definition for @ref SHM_CHANNEL_t.NcsiChannelLinkResets. */
+typedef register_container RegSHM_CHANNELNcsiChannelLinkResets_t {
+    /** @brief 32bit direct register access. */
+    BCM5719_SHM_CHANNEL0_H_uint32_t r32;
+#ifdef CXX_SIMULATOR
+    /** @brief Register name for use with the simulator. */
+    const char* getName(void) { return "NcsiChannelLinkResets"; }
+
+    /** @brief Print register value. */
+    void print(void) { r32.print(); }
+
+    RegSHM_CHANNELNcsiChannelLinkResets_t()
+    {
+        /** @brief constructor for @ref SHM_CHANNEL_t.NcsiChannelLinkResets. */
+        r32.setName("NcsiChannelLinkResets");
+    }
+    RegSHM_CHANNELNcsiChannelLinkResets_t& operator=(const RegSHM_CHANNELNcsiChannelLinkResets_t& other)
+    {
+        r32 = other.r32;
+        return *this;
+    }
+#endif /* CXX_SIMULATOR */
+} RegSHM_CHANNELNcsiChannelLinkResets_t;
+
+#define REG_SHM_CHANNEL0_NCSI_CHANNEL_LINK_DOWN_MAX_TIME ((volatile BCM5719_SHM_CHANNEL0_H_uint32_t*)0xc00149dc) /* Longest link down period, in milliseconds */
+/** @brief Register definition for @ref SHM_CHANNEL_t.NcsiChannelLinkDownMaxTime. */
+typedef register_container RegSHM_CHANNELNcsiChannelLinkDownMaxTime_t {
+    /** @brief 32bit direct register access. */
+    BCM5719_SHM_CHANNEL0_H_uint32_t r32;
+#ifdef CXX_SIMULATOR
+    /** @brief Register name for use with the simulator. */
+    const char* getName(void) { return "NcsiChannelLinkDownMaxTime"; }
+
+    /** @brief Print register value. */
+    void print(void) { r32.print(); }
+
+    RegSHM_CHANNELNcsiChannelLinkDownMaxTime_t()
+    {
+        /** @brief constructor for @ref SHM_CHANNEL_t.NcsiChannelLinkDownMaxTime. */
+        r32.setName("NcsiChannelLinkDownMaxTime");
+    }
+    RegSHM_CHANNELNcsiChannelLinkDownMaxTime_t& operator=(const RegSHM_CHANNELNcsiChannelLinkDownMaxTime_t& other)
+    {
+        r32 = other.r32;
+        return *this;
+    }
+#endif /* CXX_SIMULATOR */
+} RegSHM_CHANNELNcsiChannelLinkDownMaxTime_t;
+
+#define REG_SHM_CHANNEL0_NCSI_CHANNEL_LINK_DOWN_HISTOGRAM ((volatile BCM5719_SHM_CHANNEL0_H_uint32_t*)0xc00149e0) /* Number of link down periods lasting under 250ms, 1s, 4s, 16s, 64s and longer */
+/** @brief Register definition for @ref SHM_CHANNEL_t.NcsiChannelLinkDownHistogram. */
+typedef register_container RegSHM_CHANNELNcsiChannelLinkDownHistogram_t {
+    /** @brief 32bit direct register access. */
+    BCM5719_SHM_CHANNEL0_H_uint32_t r32;
+#ifdef CXX_SIMULATOR
+    /** @brief Register name for use with the simulator. */
+    const char* getName(void) { return "NcsiChannelLinkDownHistogram"; }
+
+    /** @brief Print register value. */
+    void print(void) { r32.print(); }
+
+    RegSHM_CHANNELNcsiChannelLinkDownHistogram_t()
+    {
+        /** @brief constructor for @ref SHM_CHANNEL_t.NcsiChannelLinkDownHistogram. */
+        r32.setName("NcsiChannelLinkDownHistogram");
+    }
+    RegSHM_CHANNELNcsiChannelLinkDownHistogram_t& operator=(const RegSHM_CHANNELNcsiChannelLinkDownHistogram_t& other)
+    {
+        r32 = other.r32;
+        return *this;
+    }
+#endif /* CXX_SIMULATOR */
+} RegSHM_CHANNELNcsiChannelLinkDownHistogram_t;
+
+#define REG_SHM_CHANNEL0_NCSI_CHANNEL_NCSI_COMMANDS_DROPPED ((volatile BCM5719_SHM_CHANNEL0_H_uint32_t*)0xc00149f8) /* Number of NC-SI commands rejected for an invalid payload length, an unknown channel or a channel that is not ready. */
+/** @brief Register definition for @ref SHM_CHANNEL_t.NcsiChannelNcsiCommandsDropped. */
+typedef register_container RegSHM_CHANNELNcsiChannelNcsiCommandsDropped_t {
+    /** @brief 32bit direct register access. */
+    BCM5719_SHM_CHANNEL0_H_uint32_t r32;
+#ifdef CXX_SIMULATOR
+    /** @brief Register name for use with the simulator. */
+    const char* getName(void) { return "NcsiChannelNcsiCommandsDropped"; }
+
+    /** @brief Print register value. */
+    void print(void) { r32.print(); }
+
+    RegSHM_CHANNELNcsiChannelNcsiCommandsDropped_t()
+    {
+        /** @brief constructor for @ref SHM_CHANNEL_t.NcsiChannelNcsiCommandsDropped. */
+        r32.setName("NcsiChannelNcsiCommandsDropped");
+    }
+    RegSHM_CHANNELNcsiChannelNcsiCommandsDropped_t& operator=(const RegSHM_CHANNELNcsiChannelNcsiCommandsDropped_t& other)
+    {
+        r32 = other.r32;
+        return *this;
+    }
+#endif /* CXX_SIMULATOR */
+} RegSHM_CHANNELNcsiChannelNcsiCommandsDropped_t;
+
 /** @brief Component definition for @ref SHM_CHANNEL0. */
 typedef struct SHM_CHANNEL_t {
     /** @brief  */
@@ -1494,8 +1944,8 @@ typedef struct SHM_CHANNEL_t {
     /** @brief Receives VLAN mode from NCSI specification "Enable VLAN" command. */
     RegSHM_CHANNELNcsiChannelVlan_t NcsiChannelVlan;
 
-    /** @brief Reserved bytes to pad out data structure. */
-    BCM5719_SHM_CHANNEL0_H_uint32_t reserved_32[1];
+    /** @brief Duration of the last port reload in microseconds. */
+    RegSHM_CHANNELNcsiChannelReloadTime_t NcsiChannelReloadTime;
 
     /** @brief Lower 16 bits of this word contains upper 16 bits of the MAC. */
     RegSHM_CHANNELNcsiChannelAltHostMacHigh_t NcsiChannelAltHostMacHigh;
@@ -1506,8 +1956,8 @@ typedef struct SHM_CHANNEL_t {
     /** @brief Lower 16 bits of this word contains low 16 bits of the MAC. */
     RegSHM_CHANNELNcsiChannelAltHostMacLow_t NcsiChannelAltHostMacLow;
 
-    /** @brief Reserved bytes to pad out data structure. */
-    BCM5719_SHM_CHANNEL0_H_uint32_t reserved_48[1];
+    /** @brief Longest port reload in microseconds since the channel was last reset. */
+    RegSHM_CHANNELNcsiChannelReloadMaxTime_t NcsiChannelReloadMaxTime;
 
     /** @brief Lower 16 bits of this word contains upper 16 bits of the MAC. */
     RegSHM_CHANNELMacHigh_t NcsiChannelMac0High;
@@ -1518,8 +1968,8 @@ typedef struct SHM_CHANNEL_t {
     /** @brief Lower 16 bits of this word contains low 16 bits of the MAC. */
     RegSHM_CHANNELMacLow_t NcsiChannelMac0Low;
 
-    /** @brief Reserved bytes to pad out data structure. */
-    BCM5719_SHM_CHANNEL0_H_uint32_t reserved_64[1];
+    /** @brief Number of port configuration and filter registers written by the last port reload. */
+    RegSHM_CHANNELNcsiChannelReloadWrites_t NcsiChannelReloadWrites;
 
     /** @brief Lower 16 bits of this word contains upper 16 bits of the MAC. */
     RegSHM_CHANNELMacHigh_t NcsiChannelMac1High;
@@ -1530,8 +1980,8 @@ typedef struct SHM_CHANNEL_t {
     /** @brief Lower 16 bits of this word contains low 16 bits of the MAC. */
     RegSHM_CHANNELMacLow_t NcsiChannelMac1Low;
 
-    /** @brief Reserved bytes to pad out data structure. */
-    BCM5719_SHM_CHANNEL0_H_uint32_t reserved_80[1];
+    /** @brief Number of PHY register reads answered from the MDIO register cache. */
+    RegSHM_CHANNELNcsiChannelMdioCacheHits_t NcsiChannelMdioCacheHits;
 
     /** @brief Lower 16 bits of this word contains upper 16 bits of the MAC. */
     RegSHM_CHANNELMacHigh_t NcsiChannelMac2High;
@@ -1542,8 +1992,8 @@ typedef struct SHM_CHANNEL_t {
     /** @brief Lower 16 bits of this word contains low 16 bits of the MAC. */
     RegSHM_CHANNELMacLow_t NcsiChannelMac2Low;
 
-    /** @brief Reserved bytes to pad out data structure. */
-    BCM5719_SHM_CHANNEL0_H_uint32_t reserved_96[1];
+    /** @brief Number of cacheable PHY register reads that required an MDIO transaction. */
+    RegSHM_CHANNELNcsiChannelMdioCacheMisses_t NcsiChannelMdioCacheMisses;
 
     /** @brief Lower 16 bits of this word contains upper 16 bits of the MAC. */
     RegSHM_CHANNELMacHigh_t NcsiChannelMac3High;
@@ -1581,14 +2031,26 @@ typedef struct SHM_CHANNEL_t {
     /** @brief  */
     RegSHM_CHANNELNcsiChannelSlink_t NcsiChannelSlink;
 
-    /** @brief Reserved bytes to pad out data structure. */
-    BCM5719_SHM_CHANNEL0_H_uint32_t reserved_148[3];
+    /** @brief Number of NC-SI commands received from the BMC. */
+    RegSHM_CHANNELNcsiChannelNcsiCommands_t NcsiChannelNcsiCommands;
+
+    /** @brief Number of NC-SI commands rejected as unsupported. */
+    RegSHM_CHANNELNcsiChannelNcsiCommandErrors_t NcsiChannelNcsiCommandErrors;
+
+    /** @brief Number of AEN packets sent to the management controller. */
+    RegSHM_CHANNELNcsiChannelAenTx_t NcsiChannelAenTx;
 
     /** @brief  */
     RegSHM_CHANNELNcsiChannelDbg_t NcsiChannelDbg;
 
-    /** @brief Reserved bytes to pad out data structure. */
-    BCM5719_SHM_CHANNEL0_H_uint32_t reserved_164[3];
+    /** @brief Number of passes where a network frame for the BMC was deferred because the NCSI fifo was full. */
+    RegSHM_CHANNELNcsiChannelNetworkDeferred_t NcsiChannelNetworkDeferred;
+
+    /** @brief Number of RX pool errors seen on the external network interface. */
+    RegSHM_CHANNELNcsiChannelNetworkErrors_t NcsiChannelNetworkErrors;
+
+    /** @brief Number of packets from the BMC dropped because no TX blocks were available. */
+    RegSHM_CHANNELNcsiChannelNcsiNoBlocks_t NcsiChannelNcsiNoBlocks;
 
     /** @brief Number of packets received from the external network interface */
     RegSHM_CHANNELNcsiChannelNetworkRx_t NcsiChannelNetworkRx;
@@ -1611,6 +2073,27 @@ typedef struct SHM_CHANNEL_t {
     /** @brief Number of AEN packets sent via NCSI */
     RegSHM_CHANNELNcsiChannelAen_t NcsiChannelAen;
 
+    /** @brief Number of times the link was seen going down */
+    RegSHM_CHANNELNcsiChannelLinkDown_t NcsiChannelLinkDown;
+
+    /** @brief Number of autonegotiation restarts issued by link recovery */
+    RegSHM_CHANNELNcsiChannelLinkRestarts_t NcsiChannelLinkRestarts;
+
+    /** @brief Number of advertisement updates issued by link recovery */
+    RegSHM_CHANNELNcsiChannelLinkReadvertise_t NcsiChannelLinkReadvertise;
+
+    /** @brief Number of PHY resets issued by link recovery */
+    RegSHM_CHANNELNcsiChannelLinkResets_t NcsiChannelLinkResets;
+
+    /** @brief Longest link down period, in milliseconds */
+    RegSHM_CHANNELNcsiChannelLinkDownMaxTime_t NcsiChannelLinkDownMaxTime;
+
+    /** @brief Number of link down periods lasting under 250ms, 1s, 4s, 16s, 64s and longer */
+    RegSHM_CHANNELNcsiChannelLinkDownHistogram_t NcsiChannelLinkDownHistogram[6];
+
+    /** @brief Number of NC-SI commands rejected for an invalid payload length, an unknown channel or a channel that is not ready. */
+    RegSHM_CHANNELNcsiChannelNcsiCommandsDropped_t NcsiChannelNcsiCommandsDropped;
+
 #ifdef CXX_SIMULATOR
     typedef uint32_t (*callback_t)(uint32_t, uint32_t, void*);
     callback_t mIndexReadCallback;
@@ -1632,47 +2115,32 @@ typedef struct SHM_CHANNEL_t {
         NcsiChannelSetting1.r32.setComponentOffset(0x14);
         NcsiChannelSetting2.r32.setComponentOffset(0x18);
         NcsiChannelVlan.r32.setComponentOffset(0x1c);
-        for(int i = 0; i < 1; i++)
-        {
-            reserved_32[i].setComponentOffset(0x20 + (i * 4));
-        }
+        NcsiChannelReloadTime.r32.setComponentOffset(0x20);
         NcsiChannelAltHostMacHigh.r32.setComponentOffset(0x24);
         NcsiChannelAltHostMacMid.r32.setComponentOffset(0x28);
         NcsiChannelAltHostMacLow.r32.setComponentOffset(0x2c);
-        for(int i = 0; i < 1; i++)
-        {
-            reserved_48[i].setComponentOffset(0x30 + (i * 4));
-        }
+        NcsiChannelReloadMaxTime.r32.setComponentOffset(0x30);
         NcsiChannelMac0High.r32.setName("NcsiChannelMac0High");
         NcsiChannelMac0High.r32.setComponentOffset(0x34);
         NcsiChannelMac0Mid.r32.setName("NcsiChannelMac0Mid");
         NcsiChannelMac0Mid.r32.setComponentOffset(0x38);
         NcsiChannelMac0Low.r32.setName("NcsiChannelMac0Low");
         NcsiChannelMac0Low.r32.setComponentOffset(0x3c);
-        for(int i = 0; i < 1; i++)
-        {
-            reserved_64[i].setComponentOffset(0x40 + (i * 4));
-        }
+        NcsiChannelReloadWrites.r32.setComponentOffset(0x40);
         NcsiChannelMac1High.r32.setName("NcsiChannelMac1High");
         NcsiChannelMac1High.r32.setComponentOffset(0x44);
         NcsiChannelMac1Mid.r32.setName("NcsiChannelMac1Mid");
         NcsiChannelMac1Mid.r32.setComponentOffset(0x48);
         NcsiChannelMac1Low.r32.setName("NcsiChannelMac1Low");
         NcsiChannelMac1Low.r32.setComponentOffset(0x4c);
-        for(int i = 0; i < 1; i++)
-        {
-            reserved_80[i].setComponentOffset(0x50 + (i * 4));
-        }
+        NcsiChannelMdioCacheHits.r32.setComponentOffset(0x50);
         NcsiChannelMac2High.r32.setName("NcsiChannelMac2High");
         NcsiChannelMac2High.r32.setComponentOffset(0x54);
         NcsiChannelMac2Mid.r32.setName("NcsiChannelMac2Mid");
         NcsiChannelMac2Mid.r32.setComponentOffset(0x58);
         NcsiChannelMac2Low.r32.setName("NcsiChannelMac2Low");
         NcsiChannelMac2Low.r32.setComponentOffset(0x5c);
-        for(int i = 0; i < 1; i++)
-        {
-            reserved_96[i].setComponentOffset(0x60 + (i * 4));
-        }
+        NcsiChannelMdioCacheMisses.r32.setComponentOffset(0x60);
         NcsiChannelMac3High.r32.setName("NcsiChannelMac3High");
         NcsiChannelMac3High.r32.setComponentOffset(0x64);
         NcsiChannelMac3Mid.r32.setName("NcsiChannelMac3Mid");
@@ -1688,15 +2156,13 @@ typedef struct SHM_CHANNEL_t {
         NcsiChannelPxe.r32.setComponentOffset(0x88);
         NcsiChannelDropfil.r32.setComponentOffset(0x8c);
         NcsiChannelSlink.r32.setComponentOffset(0x90);
-        for(int i = 0; i < 3; i++)
-        {
-            reserved_148[i].setComponentOffset(0x94 + (i * 4));
-        }
+        NcsiChannelNcsiCommands.r32.setComponentOffset(0x94);
+        NcsiChannelNcsiCommandErrors.r32.setComponentOffset(0x98);
+        NcsiChannelAenTx.r32.setComponentOffset(0x9c);
         NcsiChannelDbg.r32.setComponentOffset(0xa0);
-        for(int i = 0; i < 3; i++)
-        {
-            reserved_164[i].setComponentOffset(0xa4 + (i * 4));
-        }
+        NcsiChannelNetworkDeferred.r32.setComponentOffset(0xa4);
+        NcsiChannelNetworkErrors.r32.setComponentOffset(0xa8);
+        NcsiChannelNcsiNoBlocks.r32.setComponentOffset(0xac);
         NcsiChannelNetworkRx.r32.setComponentOffset(0xb0);
         NcsiChannelNetworkTx.r32.setComponentOffset(0xb4);
         NcsiChannelNcsiRx.r32.setComponentOffset(0xb8);
@@ -1704,6 +2170,16 @@ typedef struct SHM_CHANNEL_t {
         NcsiChannelNcsiDropped.r32.setComponentOffset(0xc0);
         NcsiChannelNetworkDropped.r32.setComponentOffset(0xc4);
         NcsiChannelAen.r32.setComponentOffset(0xc8);
+        NcsiChannelLinkDown.r32.setComponentOffset(0xcc);
+        NcsiChannelLinkRestarts.r32.setComponentOffset(0xd0);
+        NcsiChannelLinkReadvertise.r32.setComponentOffset(0xd4);
+        NcsiChannelLinkResets.r32.setComponentOffset(0xd8);
+        NcsiChannelLinkDownMaxTime.r32.setComponentOffset(0xdc);
+        for(int i = 0; i < 6; i++)
+        {
+            NcsiChannelLinkDownHistogram[i].r32.setComponentOffset(0xe0 + (i * 4));
+        }
+        NcsiChannelNcsiCommandsDropped.r32.setComponentOffset(0xf8);
     }
     void print()
     {
@@ -1718,38 +2194,23 @@ typedef struct SHM_CHANNEL_t {
         NcsiChannelSetting1.print();
         NcsiChannelSetting2.print();
         NcsiChannelVlan.print();
-        for(int i = 0; i < 1; i++)
-        {
-            reserved_32[i].print();
-        }
+        NcsiChannelReloadTime.print();
         NcsiChannelAltHostMacHigh.print();
         NcsiChannelAltHostMacMid.print();
         NcsiChannelAltHostMacLow.print();
-        for(int i = 0; i < 1; i++)
-        {
-            reserved_48[i].print();
-        }
+        NcsiChannelReloadMaxTime.print();
         NcsiChannelMac0High.print();
         NcsiChannelMac0Mid.print();
         NcsiChannelMac0Low.print();
-        for(int i = 0; i < 1; i++)
-        {
-            reserved_64[i].print();
-        }
+        NcsiChannelReloadWrites.print();
         NcsiChannelMac1High.print();
         NcsiChannelMac1Mid.print();
         NcsiChannelMac1Low.print();
-        for(int i = 0; i < 1; i++)
-        {
-            reserved_80[i].print();
-        }
+        NcsiChannelMdioCacheHits.print();
         NcsiChannelMac2High.print();
         NcsiChannelMac2Mid.print();
         NcsiChannelMac2Low.print();
-        for(int i = 0; i < 1; i++)
-        {
-            reserved_96[i].print();
-        }
+        NcsiChannelMdioCacheMisses.print();
         NcsiChannelMac3High.print();
         NcsiChannelMac3Mid.print();
         NcsiChannelMac3Low.print();
@@ -1762,15 +2223,13 @@ typedef struct SHM_CHANNEL_t {
         NcsiChannelPxe.print();
         NcsiChannelDropfil.print();
         NcsiChannelSlink.print();
-        for(int i = 0; i < 3; i++)
-        {
-            reserved_148[i].print();
-        }
+        NcsiChannelNcsiCommands.print();
+        NcsiChannelNcsiCommandErrors.print();
+        NcsiChannelAenTx.print();
         NcsiChannelDbg.print();
-        for(int i = 0; i < 3; i++)
-        {
-            reserved_164[i].print();
-        }
+        NcsiChannelNetworkDeferred.print();
+        NcsiChannelNetworkErrors.print();
+        NcsiChannelNcsiNoBlocks.print();
         NcsiChannelNetworkRx.print();
         NcsiChannelNetworkTx.print();
         NcsiChannelNcsiRx.print();
@@ -1778,6 +2237,16 @@ typedef struct SHM_CHANNEL_t {
         NcsiChannelNcsiDropped.print();
         NcsiChannelNetworkDropped.print();
         NcsiChannelAen.print();
+        NcsiChannelLinkDown.print();
+        NcsiChannelLinkRestarts.print();
+        NcsiChannelLinkReadvertise.print();
+        NcsiChannelLinkResets.print();
+        NcsiChannelLinkDownMaxTime.print();
+        for(int i = 0; i < 6; i++)
+        {
+            NcsiChannelLinkDownHistogram[i].print();
+        }
+        NcsiChannelNcsiCommandsDropped.print();
     }
     uint32_t read(int offset) { return mIndexReadCallback(0, offset, mIndexReadCallbackArgs); }
     void write(int offset, uint32_t value) { (void)mIndexWriteCallback(value, offset, mIndexWriteCallbackArgs); }
@@ -1799,7 +2268,7 @@ extern volatile SHM_CHANNEL_t SHM_CHANNEL0;
 #undef BITFIELD_END
 
 #ifndef CXX_SIMULATOR
-_Static_assert(sizeof(SHM_CHANNEL_t) == 204, "sizeof(SHM_CHANNEL_t) must be 204");
+_Static_assert(sizeof(SHM_CHANNEL_t) == 252, "sizeof(SHM_CHANNEL_t) must be 252");
 #endif
 
 #endif /* !BCM5719_SHM_CHANNEL0_H */
@@ -89,18 +89,23 @@ typedef uint32_t BCM5719_SHM_CHANNEL1_H_uint32_t;
 #define REG_SHM_CHANNEL1_NCSI_CHANNEL_SETTING_1 ((volatile BCM5719_SHM_CHANNEL1_H_uint32_t*)0xc0014a14) /* This is the "Link Settings" value from NCSI Set Link. */
 #define REG_SHM_CHANNEL1_NCSI_CHANNEL_SETTING_2 ((volatile BCM5719_SHM_CHANNEL1_H_uint32_t*)0xc0014a18) /* This is the "OEM Settings" value from NCSI Set Link. */
 #define REG_SHM_CHANNEL1_NCSI_CHANNEL_VLAN ((volatile BCM5719_SHM_CHANNEL1_H_uint32_t*)0xc0014a1c) /* Receives VLAN mode from NCSI specification "Enable VLAN" command. */
+#define REG_SHM_CHANNEL1_NCSI_CHANNEL_RELOAD_TIME ((volatile BCM5719_SHM_CHANNEL1_H_uint32_t*)0xc0014a20) /* Duration of the last port reload in microseconds. */
 #define REG_SHM_CHANNEL1_NCSI_CHANNEL_ALT_HOST_MAC_HIGH ((volatile BCM5719_SHM_CHANNEL1_H_uint32_t*)0xc0014a24) /* Lower 16 bits of this word contains upper 16 bits of the MAC. */
 #define REG_SHM_CHANNEL1_NCSI_CHANNEL_ALT_HOST_MAC_MID ((volatile BCM5719_SHM_CHANNEL1_H_uint32_t*)0xc0014a28) /* Lower 16 bits of this word contains mid 16 bits of the MAC. */
 #define REG_SHM_CHANNEL1_NCSI_CHANNEL_ALT_HOST_MAC_LOW ((volatile BCM5719_SHM_CHANNEL1_H_uint32_t*)0xc0014a2c) /* Lower 16 bits of this word contains low 16 bits of the MAC. */
+#define REG_SHM_CHANNEL1_NCSI_CHANNEL_RELOAD_MAX_TIME ((volatile BCM5719_SHM_CHANNEL1_H_uint32_t*)0xc0014a30) /* Longest port reload in microseconds since the channel was last reset. */
 #define REG_SHM_CHANNEL1_NCSI_CHANNEL_MAC0_HIGH ((volatile BCM5719_SHM_CHANNEL1_H_uint32_t*)0xc0014a34) /* Lower 16 bits of this word contains upper 16 bits of the MAC. */
 #define REG_SHM_CHANNEL1_NCSI_CHANNEL_MAC0_MID ((volatile BCM5719_SHM_CHANNEL1_H_uint32_t*)0xc0014a38) /* Lower 16 bits of this word contains mid 16 bits of the MAC. */
 #define REG_SHM_CHANNEL1_NCSI_CHANNEL_MAC0_LOW ((volatile BCM5719_SHM_CHANNEL1_H_uint32_t*)0xc0014a3c) /* Lower 16 bits of this word contains low 16 bits of the MAC. */
+#define REG_SHM_CHANNEL1_NCSI_CHANNEL_RELOAD_WRITES ((volatile BCM5719_SHM_CHANNEL1_H_uint32_t*)0xc0014a40) /* Number of port configuration and filter registers written by the last port reload. */
 #define REG_SHM_CHANNEL1_NCSI_CHANNEL_MAC1_HIGH ((volatile BCM5719_SHM_CHANNEL1_H_uint32_t*)0xc0014a44) /* Lower 16 bits of this word contains upper 16 bits of the MAC. */
 #define REG_SHM_CHANNEL1_NCSI_CHANNEL_MAC1_MID ((volatile BCM5719_SHM_CHANNEL1_H_uint32_t*)0xc0014a48) /* Lower 16 bits of this word contains mid 16 bits of the MAC. */
 #define REG_SHM_CHANNEL1_NCSI_CHANNEL_MAC1_LOW ((volatile BCM5719_SHM_CHANNEL1_H_uint32_t*)0xc0014a4c) /* Lower 16 bits of this word contains low 16 bits of the MAC. */
+#define REG_SHM_CHANNEL1_NCSI_CHANNEL_MDIO_CACHE_HITS ((volatile BCM5719_SHM_CHANNEL1_H_uint32_t*)0xc0014a50) /* Number of PHY register reads answered from the MDIO register cache. */
 #define REG_SHM_CHANNEL1_NCSI_CHANNEL_MAC2_HIGH ((volatile BCM5719_SHM_CHANNEL1_H_uint32_t*)0xc0014a54) /* Lower 16 bits of this word contains upper 16 bits of the MAC. */
 #define REG_SHM_CHANNEL1_NCSI_CHANNEL_MAC2_MID ((volatile BCM5719_SHM_CHANNEL1_H_uint32_t*)0xc0014a58) /* Lower 16 bits of this word contains mid 16 bits of the MAC. */
 #define REG_SHM_CHANNEL1_NCSI_CHANNEL_MAC2_LOW ((volatile BCM5719_SHM_CHANNEL1_H_uint32_t*)0xc0014a5c) /* Lower 16 bits of this word contains low 16 bits of the MAC. */
+#define REG_SHM_CHANNEL1_NCSI_CHANNEL_MDIO_CACHE_MISSES ((volatile BCM5719_SHM_CHANNEL1_H_uint32_t*)0xc0014a60) /* Number of cacheable PHY register reads that required an MDIO transaction. */
 #define REG_SHM_CHANNEL1_NCSI_CHANNEL_MAC3_HIGH ((volatile BCM5719_SHM_CHANNEL1_H_uint32_t*)0xc0014a64) /* Lower 16 bits of this word contains upper 16 bits of the MAC. */
 #define REG_SHM_CHANNEL1_NCSI_CHANNEL_MAC3_MID ((volatile BCM5719_SHM_CHANNEL1_H_uint32_t*)0xc0014a68) /* Lower 16 bits of this word contains mid 16 bits of the MAC. */
 #define REG_SHM_CHANNEL1_NCSI_CHANNEL_MAC3_LOW ((volatile BCM5719_SHM_CHANNEL1_H_uint32_t*)0xc0014a6c) /* Lower 16 bits of this word contains low 16 bits of the MAC. */
@@ -113,7 +118,13 @@ typedef uint32_t BCM5719_SHM_CHANNEL1_H_uint32_t;
 #define REG_SHM_CHANNEL1_NCSI_CHANNEL_PXE ((volatile BCM5719_SHM_CHANNEL1_H_uint32_t*)0xc0014a88) /*  */
 #define REG_SHM_CHANNEL1_NCSI_CHANNEL_DROPFIL ((volatile BCM5719_SHM_CHANNEL1_H_uint32_t*)0xc0014a8c) /*  */
 #define REG_SHM_CHANNEL1_NCSI_CHANNEL_SLINK ((volatile BCM5719_SHM_CHANNEL1_H_uint32_t*)0xc0014a90) /*  */
+#define REG_SHM_CHANNEL1_NCSI_CHANNEL_NCSI_COMMANDS ((volatile BCM5719_SHM_CHANNEL1_H_uint32_t*)0xc0014a94) /* Number of NC-SI commands received from the BMC. */
+#define REG_SHM_CHANNEL1_NCSI_CHANNEL_NCSI_COMMAND_ERRORS ((volatile BCM5719_SHM_CHANNEL1_H_uint32_t*)0xc0014a98) /* Number of NC-SI commands rejected as unsupported. */
+#define REG_SHM_CHANNEL1_NCSI_CHANNEL_AEN_TX ((volatile BCM5719_SHM_CHANNEL1_H_uint32_t*)0xc0014a9c) /* Number of AEN packets sent to the management controller. */
 #define REG_SHM_CHANNEL1_NCSI_CHANNEL_DBG ((volatile BCM5719_SHM_CHANNEL1_H_uint32_t*)0xc0014aa0) /*  */
+#define REG_SHM_CHANNEL1_NCSI_CHANNEL_NETWORK_DEFERRED ((volatile BCM5719_SHM_CHANNEL1_H_uint32_t*)0xc0014aa4) /* Number of passes where a network frame for the BMC was deferred because the NCSI fifo was full. */
+#define REG_SHM_CHANNEL1_NCSI_CHANNEL_NETWORK_ERRORS ((volatile BCM5719_SHM_CHANNEL1_H_uint32_t*)0xc0014aa8) /* Number of RX pool errors seen on the external network interface. */
+#define REG_SHM_CHANNEL1_NCSI_CHANNEL_NCSI_NO_BLOCKS ((volatile BCM5719_SHM_CHANNEL1_H_uint32_t*)0xc0014aac) /* Number of packets from the BMC dropped because no TX blocks were available. */
 #define REG_SHM_CHANNEL1_NCSI_CHANNEL_NETWORK_RX ((volatile BCM5719_SHM_CHANNEL1_H_uint32_t*)0xc0014ab0) /* Number of packets received from the external network interface */
 #define REG_SHM_CHANNEL1_NCSI_CHANNEL_NETWORK_TX ((volatile BCM5719_SHM_CHANNEL1_H_uint32_t*)0xc0014ab4) /* Number of packets transmited from the BCM5719 to external network interface */
 #define REG_SHM_CHANNEL1_NCSI_CHANNEL_NCSI_RX ((volatile BCM5719_SHM_CHANNEL1_H_uint32_t*)0xc0014ab8) /* Number of packets received from the BMC via NCSI */
@@ -121,6 +132,13 @@ typedef uint32_t BCM5719_SHM_CHANNEL1_H_uint32_t;
 #define REG_SHM_CHANNEL1_NCSI_CHANNEL_NCSI_DROPPED ((volatile BCM5719_SHM_CHANNEL1_H_uint32_t*)0xc0014ac0) /* Number of packets dropped on the NCSI interface. */
 #define REG_SHM_CHANNEL1_NCSI_CHANNEL_NETWORK_DROPPED ((volatile BCM5719_SHM_CHANNEL1_H_uint32_t*)0xc0014ac4) /* Number of packets dropped on the external network interface. */
 #define REG_SHM_CHANNEL1_NCSI_CHANNEL_AEN ((volatile BCM5719_SHM_CHANNEL1_H_uint32_t*)0xc0014ac8) /* Number of AEN packets sent via NCSI */
+#define REG_SHM_CHANNEL1_NCSI_CHANNEL_LINK_DOWN ((volatile BCM5719_SHM_CHANNEL1_H_uint32_t*)0xc0014acc) /* Number of times the link was seen going down */
+#define REG_SHM_CHANNEL1_NCSI_CHANNEL_LINK_RESTARTS ((volatile BCM5719_SHM_CHANNEL1_H_uint32_t*)0xc0014ad0) /* Number of autonegotiation restarts issued by link recovery */
+#define REG_SHM_CHANNEL1_NCSI_CHANNEL_LINK_READVERTISE ((volatile BCM5719_SHM_CHANNEL1_H_uint32_t*)0xc0014ad4) /* Number of advertisement updates issued by link recovery */
+#define REG_SHM_CHANNEL1_NCSI_CHANNEL_LINK_RESETS ((volatile BCM5719_SHM_CHANNEL1_H_uint32_t*)0xc0014ad8) /* Number of PHY resets issued by link recovery */
+#define REG_SHM_CHANNEL1_NCSI_CHANNEL_LINK_DOWN_MAX_TIME ((volatile BCM5719_SHM_CHANNEL1_H_uint32_t*)0xc0014adc) /* Longest link down period, in milliseconds */
+#define REG_SHM_CHANNEL1_NCSI_CHANNEL_LINK_DOWN_HISTOGRAM ((volatile BCM5719_SHM_CHANNEL1_H_uint32_t*)0xc0014ae0) /* Number of link down periods lasting under 250ms, 1s, 4s, 16s, 64s and longer */
+#define REG_SHM_CHANNEL1_NCSI_CHANNEL_NCSI_COMMANDS_DROPPED ((volatile BCM5719_SHM_CHANNEL1_H_uint32_t*)0xc0014af8) /* Number of NC-SI commands rejected for an invalid payload length, an unknown channel or a channel that is not ready. */
 /** @brief Device APE SHM Channel Registers */
 extern volatile SHM_CHANNEL_t SHM_CHANNEL1;
 
@@ -136,7 +154,7 @@ extern volatile SHM_CHANNEL_t SHM_CHANNEL1;
 #undef BITFIELD_END
 
 #ifndef CXX_SIMULATOR
-_Static_assert(sizeof(SHM_CHANNEL_t) == 204, "sizeof(SHM_CHANNEL_t) must be 204");
+_Static_assert(sizeof(SHM_CHANNEL_t) == 252, "sizeof(SHM_CHANNEL_t) must be 252");
 #endif
 
 #endif /* !BCM5719_SHM_CHANNEL1_H */
@@ -89,18 +89,23 @@ typedef uint32_t BCM5719_SHM_CHANNEL2_H_uint32_t;
 #define REG_SHM_CHANNEL2_NCSI_CHANNEL_SETTING_1 ((volatile BCM5719_SHM_CHANNEL2_H_uint32_t*)0xc0014b14) /* This is the "Link Settings" value from NCSI Set Link. */
 #define REG_SHM_CHANNEL2_NCSI_CHANNEL_SETTING_2 ((volatile BCM5719_SHM_CHANNEL2_H_uint32_t*)0xc0014b18) /* This is the "OEM Settings" value from NCSI Set Link. */
 #define REG_SHM_CHANNEL2_NCSI_CHANNEL_VLAN ((volatile BCM5719_SHM_CHANNEL2_H_uint32_t*)0xc0014b1c) /* Receives VLAN mode from NCSI specification "Enable VLAN" command. */
+#define REG_SHM_CHANNEL2_NCSI_CHANNEL_RELOAD_TIME ((volatile BCM5719_SHM_CHANNEL2_H_uint32_t*)0xc0014b20) /* Duration of the last port reload in microseconds. */
 #define REG_SHM_CHANNEL2_NCSI_CHANNEL_ALT_HOST_MAC_HIGH ((volatile BCM5719_SHM_CHANNEL2_H_uint32_t*)0xc0014b24) /* Lower 16 bits of this word contains upper 16 bits of the MAC. */
 #define REG_SHM_CHANNEL2_NCSI_CHANNEL_ALT_HOST_MAC_MID ((volatile BCM5719_SHM_CHANNEL2_H_uint32_t*)0xc0014b28) /* Lower 16 bits of this word contains mid 16 bits of the MAC. */
 #define REG_SHM_CHANNEL2_NCSI_CHANNEL_ALT_HOST_MAC_LOW ((volatile BCM5719_SHM_CHANNEL2_H_uint32_t*)0xc0014b2c) /* Lower 16 bits of this word contains low 16 bits of the MAC. */
+#define REG_SHM_CHANNEL2_NCSI_CHANNEL_RELOAD_MAX_TIME ((volatile BCM5719_SHM_CHANNEL2_H_uint32_t*)0xc0014b30) /* Longest port reload in microseconds since the channel was last reset. */
 #define REG_SHM_CHANNEL2_NCSI_CHANNEL_MAC0_HIGH ((volatile BCM5719_SHM_CHANNEL2_H_uint32_t*)0xc0014b34) /* Lower 16 bits of this word contains upper 16 bits of the MAC. */
 #define REG_SHM_CHANNEL2_NCSI_CHANNEL_MAC0_MID ((volatile BCM5719_SHM_CHANNEL2_H_uint32_t*)0xc0014b38) /* Lower 16 bits of this word contains mid 16 bits of the MAC. */
 #define REG_SHM_CHANNEL2_NCSI_CHANNEL_MAC0_LOW ((volatile BCM5719_SHM_CHANNEL2_H_uint32_t*)0xc0014b3c) /* Lower 16 bits of this word contains low 16 bits of the MAC. */
+#define REG_SHM_CHANNEL2_NCSI_CHANNEL_RELOAD_WRITES ((volatile BCM5719_SHM_CHANNEL2_H_uint32_t*)0xc0014b40) /* Number of port configuration and filter registers written by the last port reload. */
 #define REG_SHM_CHANNEL2_NCSI_CHANNEL_MAC1_HIGH ((volatile BCM5719_SHM_CHANNEL2_H_uint32_t*)0xc0014b44) /* Lower 16 bits of this word contains upper 16 bits of the MAC. */
 #define REG_SHM_CHANNEL2_NCSI_CHANNEL_MAC1_MID ((volatile BCM5719_SHM_CHANNEL2_H_uint32_t*)0xc0014b48) /* Lower 16 bits of this word contains mid 16 bits of the MAC. */
 #define REG_SHM_CHANNEL2_NCSI_CHANNEL_MAC1_LOW ((volatile BCM5719_SHM_CHANNEL2_H_uint32_t*)0xc0014b4c) /* Lower 16 bits of this word contains low 16 bits of the MAC. */
+#define REG_SHM_CHANNEL2_NCSI_CHANNEL_MDIO_CACHE_HITS ((volatile BCM5719_SHM_CHANNEL2_H_uint32_t*)0xc0014b50) /* Number of PHY register reads answered from the MDIO register cache. */
 #define REG_SHM_CHANNEL2_NCSI_CHANNEL_MAC2_HIGH ((volatile BCM5719_SHM_CHANNEL2_H_uint32_t*)0xc0014b54) /* Lower 16 bits of this word contains upper 16 bits of the MAC. */
 #define REG_SHM_CHANNEL2_NCSI_CHANNEL_MAC2_MID ((volatile BCM5719_SHM_CHANNEL2_H_uint32_t*)0xc0014b58) /* Lower 16 bits of this word contains mid 16 bits of the MAC. */
 #define REG_SHM_CHANNEL2_NCSI_CHANNEL_MAC2_LOW ((volatile BCM5719_SHM_CHANNEL2_H_uint32_t*)0xc0014b5c) /* Lower 16 bits of this word contains low 16 bits of the MAC. */
+#define REG_SHM_CHANNEL2_NCSI_CHANNEL_MDIO_CACHE_MISSES ((volatile BCM5719_SHM_CHANNEL2_H_uint32_t*)0xc0014b60) /* Number of cacheable PHY register reads that required an MDIO transaction. */
 #define REG_SHM_CHANNEL2_NCSI_CHANNEL_MAC3_HIGH ((volatile BCM5719_SHM_CHANNEL2_H_uint32_t*)0xc0014b64) /* Lower 16 bits of this word contains upper 16 bits of the MAC. */
 #define REG_SHM_CHANNEL2_NCSI_CHANNEL_MAC3_MID ((volatile BCM5719_SHM_CHANNEL2_H_uint32_t*)0xc0014b68) /* Lower 16 bits of this word contains mid 16 bits of the MAC. */
 #define REG_SHM_CHANNEL2_NCSI_CHANNEL_MAC3_LOW ((volatile BCM5719_SHM_CHANNEL2_H_uint32_t*)0xc0014b6c) /* Lower 16 bits of this word contains low 16 bits of the MAC. */
@@ -113,7 +118,13 @@ typedef uint32_t BCM5719_SHM_CHANNEL2_H_uint32_t;
 #define REG_SHM_CHANNEL2_NCSI_CHANNEL_PXE ((volatile BCM5719_SHM_CHANNEL2_H_uint32_t*)0xc0014b88) /*  */
 #define REG_SHM_CHANNEL2_NCSI_CHANNEL_DROPFIL ((volatile BCM5719_SHM_CHANNEL2_H_uint32_t*)0xc0014b8c) /*  */
 #define REG_SHM_CHANNEL2_NCSI_CHANNEL_SLINK ((volatile BCM5719_SHM_CHANNEL2_H_uint32_t*)0xc0014b90) /*  */
+#define REG_SHM_CHANNEL2_NCSI_CHANNEL_NCSI_COMMANDS ((volatile BCM5719_SHM_CHANNEL2_H_uint32_t*)0xc0014b94) /* Number of NC-SI commands received from the BMC. */
+#define REG_SHM_CHANNEL2_NCSI_CHANNEL_NCSI_COMMAND_ERRORS ((volatile BCM5719_SHM_CHANNEL2_H_uint32_t*)0xc0014b98) /* Number of NC-SI commands rejected as unsupported. */
+#define REG_SHM_CHANNEL2_NCSI_CHANNEL_AEN_TX ((volatile BCM5719_SHM_CHANNEL2_H_uint32_t*)0xc0014b9c) /* Number of AEN packets sent to the management controller. */
 #define REG_SHM_CHANNEL2_NCSI_CHANNEL_DBG ((volatile BCM5719_SHM_CHANNEL2_H_uint32_t*)0xc0014ba0) /*  */
+#define REG_SHM_CHANNEL2_NCSI_CHANNEL_NETWORK_DEFERRED ((volatile BCM5719_SHM_CHANNEL2_H_uint32_t*)0xc0014ba4) /* Number of passes where a network frame for the BMC was deferred because the NCSI fifo was full. */
+#define REG_SHM_CHANNEL2_NCSI_CHANNEL_NETWORK_ERRORS ((volatile BCM5719_SHM_CHANNEL2_H_uint32_t*)0xc0014ba8) /* Number of RX pool errors seen on the external network interface. */
+#define REG_SHM_CHANNEL2_NCSI_CHANNEL_NCSI_NO_BLOCKS ((volatile BCM5719_SHM_CHANNEL2_H_uint32_t*)0xc0014bac) /* Number of packets from the BMC dropped because no TX blocks were available. */
 #define REG_SHM_CHANNEL2_NCSI_CHANNEL_NETWORK_RX ((volatile BCM5719_SHM_CHANNEL2_H_uint32_t*)0xc0014bb0) /* Number of packets received from the external network interface */
 #define REG_SHM_CHANNEL2_NCSI_CHANNEL_NETWORK_TX ((volatile BCM5719_SHM_CHANNEL2_H_uint32_t*)0xc0014bb4) /* Number of packets transmited from the BCM5719 to external network interface */
 #define REG_SHM_CHANNEL2_NCSI_CHANNEL_NCSI_RX ((volatile BCM5719_SHM_CHANNEL2_H_uint32_t*)0xc0014bb8) /* Number of packets received from the BMC via NCSI */
@@ -121,6 +132,13 @@ typedef uint32_t BCM5719_SHM_CHANNEL2_H_uint32_t;
 #define REG_SHM_CHANNEL2_NCSI_CHANNEL_NCSI_DROPPED ((volatile BCM5719_SHM_CHANNEL2_H_uint32_t*)0xc0014bc0) /* Number of packets dropped on the NCSI interface. */
 #define REG_SHM_CHANNEL2_NCSI_CHANNEL_NETWORK_DROPPED ((volatile BCM5719_SHM_CHANNEL2_H_uint32_t*)0xc0014bc4) /* Number of packets dropped on the external network interface. */
 #define REG_SHM_CHANNEL2_NCSI_CHANNEL_AEN ((volatile BCM5719_SHM_CHANNEL2_H_uint32_t*)0xc0014bc8) /* Number of AEN packets sent via NCSI */
+#define REG_SHM_CHANNEL2_NCSI_CHANNEL_LINK_DOWN ((volatile BCM5719_SHM_CHANNEL2_H_uint32_t*)0xc0014bcc) /* Number of times the link was seen going down */
+#define REG_SHM_CHANNEL2_NCSI_CHANNEL_LINK_RESTARTS ((volatile BCM5719_SHM_CHANNEL2_H_uint32_t*)0xc0014bd0) /* Number of autonegotiation restarts issued by link recovery */
+#define REG_SHM_CHANNEL2_NCSI_CHANNEL_LINK_READVERTISE ((volatile BCM5719_SHM_CHANNEL2_H_uint32_t*)0xc0014bd4) /* Number of advertisement updates issued by link recovery */
+#define REG_SHM_CHANNEL2_NCSI_CHANNEL_LINK_RESETS ((volatile BCM5719_SHM_CHANNEL2_H_uint32_t*)0xc0014bd8) /* Number of PHY resets issued by link recovery */
+#define REG_SHM_CHANNEL2_NCSI_CHANNEL_LINK_DOWN_MAX_TIME ((volatile BCM5719_SHM_CHANNEL2_H_uint32_t*)0xc0014bdc) /* Longest link down period, in milliseconds */
+#define REG_SHM_CHANNEL2_NCSI_CHANNEL_LINK_DOWN_HISTOGRAM ((volatile BCM5719_SHM_CHANNEL2_H_uint32_t*)0xc0014be0) /* Number of link down periods lasting under 250ms, 1s, 4s, 16s, 64s and longer */
+#define REG_SHM_CHANNEL2_NCSI_CHANNEL_NCSI_COMMANDS_DROPPED ((volatile BCM5719_SHM_CHANNEL2_H_uint32_t*)0xc0014bf8) /* Number of NC-SI commands rejected for an invalid payload length, an unknown channel or a channel that is not ready. */
 /** @brief Device APE SHM Channel Registers */
 extern volatile SHM_CHANNEL_t SHM_CHANNEL2;
 
@@ -136,7 +154,7 @@ extern volatile SHM_CHANNEL_t SHM_CHANNEL2;
 #undef BITFIELD_END
 
 #ifndef CXX_SIMULATOR
-_Static_assert(sizeof(SHM_CHANNEL_t) == 204, "sizeof(SHM_CHANNEL_t) must be 204");
+_Static_assert(sizeof(SHM_CHANNEL_t) == 252, "sizeof(SHM_CHANNEL_t) must be 252");
 #endif
 
 #endif /* !BCM5719_SHM_CHANNEL2_H */
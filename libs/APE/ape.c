@@ -43,12 +43,28 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "bcm5719_APE_PERI.h"
-#include "bcm5719_DEVICE.h"
 
 #include <APE.h>
 
-void APE_aquireLock(void)
+#define APE_PHY_LOCKS (4) /* One PHY lock per PCIe function */
+
+// Number of outstanding APE_aquireLock calls for each PHY lock. The hardware lock is only requested and released at the
+// outermost level, so queued MDIO sequences and synchronous PHY accesses can overlap.
+static uint32_t gLockDepth[APE_PHY_LOCKS];
+
+void APE_aquireLock(uint8_t function)
 {
+    if (function >= APE_PHY_LOCKS)
+    {
+        function = 0;
+    }
+
+    if (gLockDepth[function]++)
+    {
+        // Already held.
+        return;
+    }
+
     RegAPE_PERIPerLockRequestPhy0_t lock_req;
     lock_req.r32 = 0;
 #ifdef __arm__ /* APE */
@@ -57,7 +73,6 @@ void APE_aquireLock(void)
     lock_req.bits.Bootcode = 1;
 #endif
 
-    uint8_t function = DEVICE.Status.bits.FunctionNumber;
     switch (function)
     {
         default: /* fallthrough */
@@ -95,8 +110,19 @@ void APE_aquireLock(void)
     }
 }
 
-void APE_releaseLock(void)
+void APE_releaseLock(uint8_t function)
 {
+    if (function >= APE_PHY_LOCKS)
+    {
+        function = 0;
+    }
+
+    if (gLockDepth[function] && --gLockDepth[function])
+    {
+        // Still held by an outer caller.
+        return;
+    }
+
     RegAPE_PERIPerLockGrantPhy0_t lock_release;
     lock_release.r32 = 0;
 #ifdef __arm__ /* APE */
@@ -105,7 +131,6 @@ void APE_releaseLock(void)
     lock_release.bits.Bootcode = 1;
 #endif
 
-    uint8_t function = DEVICE.Status.bits.FunctionNumber;
     switch (function)
     {
         default: /* fallthrough */
@@ -129,6 +154,11 @@ void APE_releaseLock(void)
 
 void APE_releaseAllLocks(void)
 {
+    for (int i = 0; i < APE_PHY_LOCKS; i++)
+    {
+        gLockDepth[i] = 0;
+    }
+
     RegAPE_PERIPerLockGrantPhy0_t lock_release;
     lock_release.r32 = 0;
     lock_release.bits.Bootcode = 1;
@@ -45,9 +45,13 @@
 #ifndef LIBS_APE_H
 #define LIBS_APE_H
 
-void APE_aquireLock(void);
+#include <stdint.h>
 
-void APE_releaseLock(void);
+/* Acquires the PHY lock of the given PCIe function. Calls nest per function, the lock is released by the matching
+ * outermost APE_releaseLock. */
+void APE_aquireLock(uint8_t function);
+
+void APE_releaseLock(uint8_t function);
 
 void APE_releaseAllLocks(void);
 
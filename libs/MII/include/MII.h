@@ -60,6 +60,71 @@ typedef uint64_t    mii_reg_t;
 typedef uint16_t    mii_reg_t;
 #endif
 
+typedef enum
+{
+    MII_OP_READ,  /* Read reg, result holds the value */
+    MII_OP_WRITE, /* Write data to reg */
+    MII_OP_DELAY, /* Hold the queue for data milliseconds */
+} mii_op_t;
+
+typedef struct mii_request mii_request_t;
+typedef void (*mii_callback_t)(mii_request_t *request);
+
+/**
+ * @brief A queued MDIO operation. Requests are owned by the caller and must
+ *        stay valid until done is set. Shadow registers (18h, 1Ch) are
+ *        handled as a single request.
+ */
+struct mii_request
+{
+    /* Set up by the caller, see MII_setupRequest */
+    volatile DEVICE_t *device;
+    uint8_t phy;
+    mii_op_t op;
+    mii_reg_t reg;
+    uint16_t data;           /* Value to write, or the delay in milliseconds */
+    mii_callback_t callback; /* Called from MII_processQueue once done, may submit the request again */
+    void *context;           /* Free for use by the callback */
+
+    /* Updated by the queue */
+    int32_t result; /* Register value for reads, 0 for writes, negative on error */
+    bool done;
+    bool started;
+    uint8_t step;   /* MDIO transactions issued */
+    uint32_t polls; /* Busy polls for the transaction in flight */
+    uint32_t start; /* 1KHz timestamp for delays */
+    mii_request_t *next;
+};
+
+typedef enum
+{
+    MII_RESET_STATE_RESET,
+    MII_RESET_STATE_POLL,
+    MII_RESET_STATE_SETTLE,
+    MII_RESET_STATE_EXT_STATUS,
+    MII_RESET_STATE_CONTROL_1G,
+    MII_RESET_STATE_ADVERTISE,
+    MII_RESET_STATE_RESTART,
+} mii_reset_state_t;
+
+typedef struct mii_reset mii_reset_t;
+typedef void (*mii_reset_callback_t)(mii_reset_t *reset);
+
+/**
+ * @brief State for a queued PHY reset, see MII_startReset.
+ */
+struct mii_reset
+{
+    mii_request_t request;
+    mii_reset_callback_t callback;
+    void *context;
+    mii_reset_state_t state;
+    uint16_t ext_status;
+    uint32_t start; /* 1KHz timestamp the reset was issued, bounds the wait for the reset bit to clear */
+    bool success;   /* The PHY accepted the reset, or autonegotiation was restarted */
+    bool done;
+};
+
 /**
  * @fn uint8_t MII_getPhy(void);
  *
@@ -71,14 +136,106 @@ uint8_t MII_getPhy(volatile DEVICE_t* device);
 
 /**
  * @fn uint16_t MII_readRegister(uint8_t PHY, uint8_t reg);
+ *
+ * Synchronous wrapper around MII_submit, waits for all earlier requests.
+ *
+ * Registers that are constant until the PHY is reset (PHY ID, IEEE extended
+ * status) are answered from a per-PHY cache while block 0 is selected.
  */
 int32_t MII_readRegister(volatile DEVICE_t* device, uint8_t phy, mii_reg_t reg);
 
+/**
+ * @fn void MII_invalidateCache(uint8_t phy);
+ *
+ * @brief Drops all cached register values for the PHY. Must be called when
+ *        the PHY may have been reset or reconfigured behind our back.
+ */
+void MII_invalidateCache(uint8_t phy);
+
+/**
+ * @fn uint32_t MII_getCacheHits(uint8_t phy);
+ *
+ * @returns The number of cacheable register reads answered without an MDIO transaction.
+ */
+uint32_t MII_getCacheHits(uint8_t phy);
+
+/**
+ * @fn uint32_t MII_getCacheMisses(uint8_t phy);
+ *
+ * @returns The number of cacheable register reads that went to the PHY.
+ */
+uint32_t MII_getCacheMisses(uint8_t phy);
+
 /**
  * @fn void MII_writeRegister(uint8_t PHY, uint8_t reg, uint16_t data);
  */
 bool MII_writeRegister(volatile DEVICE_t* device, uint8_t phy, mii_reg_t reg, uint16_t data);
 
+/**
+ * @fn void MII_setupRequest(mii_request_t *request, volatile DEVICE_t *device, uint8_t phy, mii_op_t op, mii_reg_t reg, uint16_t data);
+ *
+ * @brief Fills in a request for MII_submit. The callback and context are cleared.
+ */
+void MII_setupRequest(mii_request_t *request, volatile DEVICE_t *device, uint8_t phy, mii_op_t op, mii_reg_t reg, uint16_t data);
+
+/**
+ * @fn void MII_submit(mii_request_t *request);
+ *
+ * @brief Queues a request without waiting for the PHY. Requests complete in
+ *        the order they were submitted.
+ */
+void MII_submit(mii_request_t *request);
+
+/**
+ * @fn bool MII_processQueue(void);
+ *
+ * @brief Advances the request at the head of the queue without blocking.
+ *        Completion callbacks run from here.
+ *
+ * @returns True while requests are still pending.
+ */
+bool MII_processQueue(void);
+
+/**
+ * @fn bool MII_isIdle(void);
+ *
+ * @returns True when no requests are queued.
+ */
+bool MII_isIdle(void);
+
+/**
+ * @fn void MII_abortQueue(void);
+ *
+ * @brief Drops all queued requests without running their callbacks. Dropped
+ *        requests are marked done with an error, as are queued resets.
+ */
+void MII_abortQueue(void);
+
+/**
+ * @fn void MII_startReset(mii_reset_t *reset, volatile DEVICE_t *device, uint8_t phy, mii_reset_callback_t callback, void *context);
+ *
+ * @brief Queues a PHY reset followed by the MII_UpdateAdvertisement steps.
+ *        Each step is queued as the previous one completes, so other requests
+ *        may run in between. The callback is called once the sequence is done.
+ */
+void MII_startReset(mii_reset_t *reset, volatile DEVICE_t *device, uint8_t phy, mii_reset_callback_t callback, void *context);
+
+/**
+ * @fn void MII_startAdvertise(mii_reset_t *reset, volatile DEVICE_t *device, uint8_t phy, mii_reset_callback_t callback, void *context);
+ *
+ * @brief Queues the MII_UpdateAdvertisement steps without resetting the PHY.
+ *        Nothing is written if the advertisement is already correct, in
+ *        which case success is left false.
+ */
+void MII_startAdvertise(mii_reset_t *reset, volatile DEVICE_t *device, uint8_t phy, mii_reset_callback_t callback, void *context);
+
+/**
+ * @fn void MII_startRestart(mii_reset_t *reset, volatile DEVICE_t *device, uint8_t phy, mii_reset_callback_t callback, void *context);
+ *
+ * @brief Queues an autonegotiation restart with the current advertisement.
+ */
+void MII_startRestart(mii_reset_t *reset, volatile DEVICE_t *device, uint8_t phy, mii_reset_callback_t callback, void *context);
+
 /**
  * @fn void MII_selectBlock(uint8_t phy, uint16_t block);
  */
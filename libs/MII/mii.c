@@ -44,105 +44,115 @@
 
 #include <MII.h>
 #include <Timer.h>
+#include <stddef.h>
 
 #ifdef CXX_SIMULATOR
 #define volatile
 #endif
 
-static bool __attribute__((noinline)) MII_wait(volatile DEVICE_t *device)
+#define MII_MAX_POLLS (0xffffu) /* Busy polls allowed per MDIO transaction before giving up */
+#define MII_RESET_TIMEOUT_MS (500) /* IEEE 802.3 allows the PHY up to 0.5s to clear the reset bit */
+
+// Number of PHYs cached at once. Each function uses either PHY_n or SGMII_n,
+// so indexing by the low bits of the PHY address gives every port its own entry.
+#define MII_CACHE_ENTRIES (4u)
+#define MII_CACHE_SLOTS   (3u)
+
+typedef struct
 {
-    uint32_t maxWait = 0xffff;
-    // Wait for the status bit to be clear.
-    while (device->MiiCommunication.bits.Start_DIV_Busy && maxWait)
-    {
-        // Waiting...
-        maxWait--;
-    }
+    uint8_t phy;
+    uint8_t valid; /* Bitmask of slots holding a value */
+    bool bypass;   /* A register block other than 0 is selected */
+    uint16_t value[MII_CACHE_SLOTS];
+    uint32_t hits;
+    uint32_t misses;
+} mii_cache_t;
 
-    return maxWait ? true : false;
-} //lint !e818
+static mii_cache_t gMIICache[MII_CACHE_ENTRIES];
 
-uint8_t MII_getPhy(volatile DEVICE_t *device)
+static int32_t MII_cacheSlot(mii_reg_t reg)
 {
-    if (device->SgmiiStatus.bits.MediaSelectionMode)
+    // Only registers that are constant until the PHY is reset are cached. Status, counters and self clearing control bits
+    // change underneath us, and the read/write registers are also programmed by the host driver and the RX CPU.
+    if ((mii_reg_t)REG_MII_PHY_ID_HIGH == reg)
     {
-        // SERDES platform
-        return device->Status.bits.FunctionNumber + DEVICE_MII_COMMUNICATION_PHY_ADDRESS_SGMII_0;
+        return 0;
     }
-    else
+    else if ((mii_reg_t)REG_MII_PHY_ID_LOW == reg)
     {
-        // GPHY platform
-        return device->Status.bits.FunctionNumber + DEVICE_MII_COMMUNICATION_PHY_ADDRESS_PHY_0;
+        return 1;
     }
-} //lint !e818
-
-static int32_t MII_readRegisterInternal(volatile DEVICE_t *device, uint8_t phy, mii_reg_t reg)
-{
-    union
+    else if ((mii_reg_t)REG_MII_IEEE_EXTENDED_STATUS == reg)
     {
-        uint8_t addr;
-        mii_reg_t reg;
-    } caster;
-    caster.reg = reg;
-
-    RegDEVICEMiiCommunication_t regcontents;
-    regcontents.r32 = 0;
-    regcontents.bits.Command = DEVICE_MII_COMMUNICATION_COMMAND_READ;
-    regcontents.bits.Start_DIV_Busy = 1;
-    regcontents.bits.PHYAddress = phy;
-    regcontents.bits.RegisterAddress = caster.addr;
-
-    // Ensure there are no active transactions
-    if (!MII_wait(device))
+        return 2;
+    }
+    else
     {
-        // Unable to read
         return -1;
     }
+}
 
-    // Start the transaction
-    device->MiiCommunication = regcontents;
+static mii_cache_t *MII_getCacheEntry(uint8_t phy)
+{
+    mii_cache_t *entry = &gMIICache[phy % MII_CACHE_ENTRIES];
 
-    // Wait for transaction to complete.
-    if (!MII_wait(device))
+    if (entry->phy != phy)
     {
-        // Unable to read
-        return -1;
+        // Entry was used by a different PHY, start over.
+        entry->phy = phy;
+        entry->valid = 0;
+        entry->bypass = false;
+        entry->hits = 0;
+        entry->misses = 0;
     }
 
-    return device->MiiCommunication.bits.TransactionData;
+    return entry;
 }
 
-static bool MII_writeRegisterInternal(volatile DEVICE_t *device, uint8_t phy, mii_reg_t reg, uint16_t data)
+void MII_invalidateCache(uint8_t phy)
 {
-    RegDEVICEMiiCommunication_t regcontents;
-    regcontents.r32 = 0;
-    regcontents.bits.Command = DEVICE_MII_COMMUNICATION_COMMAND_WRITE;
-    regcontents.bits.Start_DIV_Busy = 1;
-    regcontents.bits.PHYAddress = phy;
-    regcontents.bits.RegisterAddress = reg;
-    regcontents.bits.TransactionData = data;
+    mii_cache_t *entry = MII_getCacheEntry(phy);
 
-    // Ensure there are no active transactions
-    if (!MII_wait(device))
-    {
-        // Unable to read
-        return false;
-    }
+    entry->valid = 0;
+}
 
-    // Start the transaction
-    device->MiiCommunication = regcontents;
+uint32_t MII_getCacheHits(uint8_t phy)
+{
+    const mii_cache_t *entry = &gMIICache[phy % MII_CACHE_ENTRIES];
 
-    // Wait for transaction to complete (not strictly required for writes).
-    if (!MII_wait(device))
-    {
-        // Unable to read
-        return false;
-    }
+    return (entry->phy == phy) ? entry->hits : 0;
+}
 
-    return true;
+uint32_t MII_getCacheMisses(uint8_t phy)
+{
+    const mii_cache_t *entry = &gMIICache[phy % MII_CACHE_ENTRIES];
+
+    return (entry->phy == phy) ? entry->misses : 0;
 }
 
-static int32_t MII_readShadowRegister18(volatile DEVICE_t *device, uint8_t phy, mii_reg_t reg)
+typedef struct
+{
+    mii_request_t *head; /* Request being processed */
+    mii_request_t *tail;
+} mii_queue_t;
+
+static mii_queue_t gMIIQueue;
+
+uint8_t MII_getPhy(volatile DEVICE_t *device)
+{
+    if (device->SgmiiStatus.bits.MediaSelectionMode)
+    {
+        // SERDES platform
+        return device->Status.bits.FunctionNumber + DEVICE_MII_COMMUNICATION_PHY_ADDRESS_SGMII_0;
+    }
+    else
+    {
+        // GPHY platform
+        return device->Status.bits.FunctionNumber + DEVICE_MII_COMMUNICATION_PHY_ADDRESS_PHY_0;
+    }
+} //lint !e818
+
+static uint16_t MII_getShadowSelect18(uint16_t shadow_reg)
 {
     // Write register 18h, bits [2:0] = 111 This selects the Miscellaneous
     // Control register, shadow 7h. All reads must be performed through the
@@ -160,22 +170,22 @@ static int32_t MII_readShadowRegister18(volatile DEVICE_t *device, uint8_t phy,
     // phy_write(0x18, 0x1007); //switch to shadow 0x1
     // valu = phy_read(0x18);
 
-    uint16_t shadow_reg = reg >> 8;
+    // --------------------------------------------
+    // PHY 0x18 Shadow 0x2 register write Procedure
+    // --------------------------------------------
+    // int wdata;
+    // phy_write(0x18, 0x2007); //switch to shadow 0x2
+    // phy_write(0x18, wdata | 0x2 );
+
     RegMIIMiscellaneousControl_t shadow_select;
     shadow_select.r16 = 0;
     shadow_select.bits.ShadowRegisterReadSelector = shadow_reg;
     shadow_select.bits.ShadowRegisterSelector = 7;
-    if (MII_writeRegisterInternal(device, phy, (mii_reg_t)0x18, shadow_select.r16))
-    {
-        return MII_readRegisterInternal(device, phy, (mii_reg_t)0x18);
-    }
-    else
-    {
-        return -1;
-    }
+
+    return shadow_select.r16;
 }
 
-static int32_t MII_readShadowRegister1C(volatile DEVICE_t *device, uint8_t phy, mii_reg_t reg)
+static uint16_t MII_getShadowSelect1C(uint16_t shadow_reg)
 {
     // --------------------------------------------
     // PHY 0x1C Shadow 0x1 register read Procedure
@@ -185,106 +195,308 @@ static int32_t MII_readShadowRegister1C(volatile DEVICE_t *device, uint8_t phy,
     // value = phy_read(0x1C);
     // return value;
 
-    uint16_t shadow_reg = reg >> 8;
+    // --------------------------------------------
+    // PHY 0x1C Shadow 0x2 register write Procedure
+    // --------------------------------------------
+    // int wdata;
+    // phy_write(0x1C, 0x0800); //switch to shadow 0x2
+    // phy_write(0x1C, wdata | 0x8800 );
+
     RegMIICabletronLed_t shadow_select;
     shadow_select.r16 = 0;
     shadow_select.bits.ShadowRegisterSelector = shadow_reg;
-    if (MII_writeRegisterInternal(device, phy, (mii_reg_t)0x1C, shadow_select.r16))
+
+    return shadow_select.r16;
+}
+
+static uint16_t MII_getShadowData(uint8_t addr, uint16_t shadow_reg, uint16_t data)
+{
+    if (0x1C == addr)
     {
-        return MII_readRegisterInternal(device, phy, (mii_reg_t)0x1C);
+        RegMIICabletronLed_t write_data;
+        write_data.r16 = data;
+        write_data.bits.ShadowRegisterSelector = shadow_reg;
+        write_data.bits.WriteEnable = 1;
+
+        return write_data.r16;
     }
     else
     {
-        return -1;
+        // Set Bits [15:3] = Preferred write values Bits [15:3] contain the desired
+        // bits to be written to. Set Bits [2:0] = yyy This enables shadow register
+        // yyy to be written. For shadow 7h, bit 15 must also be written.
+        RegMIIMiscellaneousControl_t write_data;
+        write_data.r16 = data;
+        write_data.bits.ShadowRegisterSelector = shadow_reg;
+
+        return write_data.r16;
     }
 }
 
-int32_t MII_readRegister(volatile DEVICE_t *device, uint8_t phy, mii_reg_t reg)
+static bool MII_getTransaction(const mii_request_t *request, uint8_t step, RegDEVICEMiiCommunication_t *transaction)
 {
-    if ((reg & 0xFF) == 0x1C)
+    // Shadow registers 18h and 1Ch are accessed by first selecting the shadow register, then accessing the register itself.
+    uint8_t addr = (uint8_t)(request->reg & 0xFF);
+    uint16_t shadow_reg = (uint16_t)(request->reg >> 8);
+    bool shadowed = (0x18 == addr) || (0x1C == addr);
+
+    transaction->r32 = 0;
+    transaction->bits.Start_DIV_Busy = 1;
+    transaction->bits.PHYAddress = request->phy;
+    transaction->bits.RegisterAddress = addr;
+
+    if (shadowed && 0 == step)
     {
-        return MII_readShadowRegister1C(device, phy, reg);
+        transaction->bits.Command = DEVICE_MII_COMMUNICATION_COMMAND_WRITE;
+        transaction->bits.TransactionData = (0x18 == addr) ? MII_getShadowSelect18(shadow_reg) : MII_getShadowSelect1C(shadow_reg);
+        return true;
     }
-    else if ((reg & 0xFF) == 0x18)
+    else if ((shadowed ? 1 : 0) == step)
     {
-        return MII_readShadowRegister18(device, phy, reg);
+        if (MII_OP_WRITE == request->op)
+        {
+            transaction->bits.Command = DEVICE_MII_COMMUNICATION_COMMAND_WRITE;
+            transaction->bits.TransactionData = shadowed ? MII_getShadowData(addr, shadow_reg, request->data) : request->data;
+        }
+        else
+        {
+            transaction->bits.Command = DEVICE_MII_COMMUNICATION_COMMAND_READ;
+        }
+        return true;
     }
     else
     {
-        return MII_readRegisterInternal(device, phy, reg);
+        // All transactions issued.
+        return false;
     }
 }
 
-static bool MII_writeShadowRegister18(volatile DEVICE_t *device, uint8_t phy, mii_reg_t reg, uint16_t data)
+void MII_setupRequest(mii_request_t *request, volatile DEVICE_t *device, uint8_t phy, mii_op_t op, mii_reg_t reg, uint16_t data)
 {
-    // Set Bits [15:3] = Preferred write values Bits [15:3] contain the desired
-    // bits to be written to. Set Bits [2:0] = yyy This enables shadow register
-    // yyy to be written. For shadow 7h, bit 15 must also be written.
+    request->device = device;
+    request->phy = phy;
+    request->op = op;
+    request->reg = reg;
+    request->data = data;
+    request->callback = NULL;
+    request->context = NULL;
+}
 
-    // --------------------------------------------
-    // PHY 0x18 Shadow 0x2 register write Procedure
-    // --------------------------------------------
-    // int wdata;
-    // phy_write(0x18, 0x2007); //switch to shadow 0x2
-    // phy_write(0x18, wdata | 0x2 );
+void MII_submit(mii_request_t *request)
+{
+    request->next = NULL;
+    request->result = -1;
+    request->done = false;
+    request->started = false;
+    request->step = 0;
+    request->polls = 0;
+
+    if (gMIIQueue.tail)
+    {
+        gMIIQueue.tail->next = request;
+    }
+    else
+    {
+        gMIIQueue.head = request;
+    }
+    gMIIQueue.tail = request;
+}
 
-    uint16_t shadow_reg = reg >> 8;
-    RegMIIMiscellaneousControl_t shadow_select;
-    shadow_select.r16 = 0;
-    shadow_select.bits.ShadowRegisterReadSelector = shadow_reg;
-    shadow_select.bits.ShadowRegisterSelector = 7;
-    if (MII_writeRegisterInternal(device, phy, (mii_reg_t)REG_MII_AUXILIARY_CONTROL, shadow_select.r16))
+bool MII_isIdle(void)
+{
+    return NULL == gMIIQueue.head;
+}
+
+static void MII_resetStep(mii_request_t *request);
+
+void MII_abortQueue(void)
+{
+    mii_request_t *request = gMIIQueue.head;
+
+    gMIIQueue.head = NULL;
+    gMIIQueue.tail = NULL;
+
+    while (request)
     {
-        RegMIIMiscellaneousControl_t write_data;
-        write_data.r16 = data;
-        write_data.bits.ShadowRegisterSelector = shadow_reg;
+        mii_request_t *next = request->next;
+
+        request->next = NULL;
+        request->result = -1;
+        request->done = true;
+
+        if (MII_resetStep == request->callback)
+        {
+            mii_reset_t *reset = (mii_reset_t *)request->context;
+            reset->success = false;
+            reset->done = true;
+        }
 
-        return MII_writeRegisterInternal(device, phy, (mii_reg_t)REG_MII_AUXILIARY_CONTROL, write_data.r16);
+        request = next;
     }
+}
 
-    return false;
+static void MII_completeRequest(mii_request_t *request)
+{
+    // Dequeue first so that the callback is free to submit the request again.
+    gMIIQueue.head = request->next;
+    if (!gMIIQueue.head)
+    {
+        gMIIQueue.tail = NULL;
+    }
+
+    request->next = NULL;
+    request->done = true;
+
+    if (request->callback)
+    {
+        request->callback(request);
+    }
 }
 
-static bool MII_writeShadowRegister1C(volatile DEVICE_t *device, uint8_t phy, mii_reg_t reg, uint16_t data)
+static bool MII_startRequest(mii_request_t *request)
 {
-    // --------------------------------------------
-    // PHY 0x1C Shadow 0x2 register write Procedure
-    // --------------------------------------------
-    // int wdata;
-    // phy_write(0x1C, 0x0800); //switch to shadow 0x2
-    // phy_write(0x1C, wdata | 0x8800 );
+    request->started = true;
 
-    uint16_t shadow_reg = reg >> 8;
-    RegMIICabletronLed_t shadow_select;
-    shadow_select.r16 = 0;
-    shadow_select.bits.ShadowRegisterSelector = shadow_reg;
-    if (MII_writeRegisterInternal(device, phy, (mii_reg_t)REG_MII_CABLETRON_LED, shadow_select.r16))
+    if (MII_OP_DELAY == request->op)
     {
-        RegMIICabletronLed_t write_data;
-        write_data.r16 = data;
-        write_data.bits.ShadowRegisterSelector = shadow_reg;
-        write_data.bits.WriteEnable = 1;
+        request->start = Timer_getCurrentTime1KHz();
+        return true;
+    }
 
-        return MII_writeRegisterInternal(device, phy, (mii_reg_t)REG_MII_CABLETRON_LED, write_data.r16);
+    int32_t slot = MII_cacheSlot(request->reg);
+    mii_cache_t *entry = MII_getCacheEntry(request->phy);
+    if (MII_OP_WRITE == request->op)
+    {
+        if ((mii_reg_t)REG_MII_BLOCK_SELECT == request->reg)
+        {
+            // Cached values are only valid for block 0.
+            entry->bypass = (0 != request->data);
+        }
+        else if (slot >= 0)
+        {
+            entry->valid = 0;
+        }
     }
+    else if (slot >= 0 && !entry->bypass)
+    {
+        if (entry->valid & (1u << slot))
+        {
+            entry->hits++;
+            request->result = entry->value[slot];
+            return false;
+        }
 
-    return false;
+        entry->misses++;
+    }
+
+    return true;
 }
 
-bool MII_writeRegister(volatile DEVICE_t *device, uint8_t phy, mii_reg_t reg, uint16_t data)
+static void MII_finishRequest(mii_request_t *request)
 {
-    if ((reg & 0xFF) == 0x1C)
+    if (MII_OP_READ == request->op && request->result >= 0)
     {
-        return MII_writeShadowRegister1C(device, phy, reg, data);
+        int32_t slot = MII_cacheSlot(request->reg);
+        mii_cache_t *entry = MII_getCacheEntry(request->phy);
+        if (slot >= 0 && !entry->bypass)
+        {
+            entry->value[slot] = (uint16_t)request->result;
+            entry->valid |= (uint8_t)(1u << slot);
+        }
     }
-    else if ((reg & 0xFF) == 0x18)
+
+    MII_completeRequest(request);
+}
+
+bool MII_processQueue(void)
+{
+    mii_request_t *request = gMIIQueue.head;
+    if (!request)
+    {
+        return false;
+    }
+
+    if (!request->started && !MII_startRequest(request))
     {
-        return MII_writeShadowRegister18(device, phy, reg, data);
+        // Answered from the cache.
+        MII_completeRequest(request);
+        return !MII_isIdle();
+    }
+
+    if (MII_OP_DELAY == request->op)
+    {
+        if (!Timer_didTimeElapsed1KHz(request->start, request->data))
+        {
+            return true;
+        }
+
+        request->result = 0;
     }
     else
     {
-        return MII_writeRegisterInternal(device, phy, reg, data);
+        volatile DEVICE_t *device = request->device;
+        if (device->MiiCommunication.bits.Start_DIV_Busy)
+        {
+            // Either our transaction or one started by someone else is still running.
+            if (++request->polls < MII_MAX_POLLS)
+            {
+                return true;
+            }
+
+            // Unable to complete the transaction.
+            request->result = -1;
+            MII_completeRequest(request);
+            return !MII_isIdle();
+        }
+
+        if (request->step)
+        {
+            // The last transaction completed.
+            request->result = (MII_OP_READ == request->op) ? (int32_t)device->MiiCommunication.bits.TransactionData : 0;
+        }
+
+        RegDEVICEMiiCommunication_t transaction;
+        if (MII_getTransaction(request, request->step, &transaction))
+        {
+            // Start the next transaction.
+            device->MiiCommunication = transaction;
+            request->step++;
+            request->polls = 0;
+            return true;
+        }
+    }
+
+    MII_finishRequest(request);
+    return !MII_isIdle();
+}
+
+static int32_t MII_run(mii_request_t *request)
+{
+    MII_submit(request);
+
+    // Earlier requests in the queue are completed first.
+    while (!request->done)
+    {
+        (void)MII_processQueue();
     }
+
+    return request->result;
+}
+
+int32_t MII_readRegister(volatile DEVICE_t *device, uint8_t phy, mii_reg_t reg)
+{
+    mii_request_t request;
+    MII_setupRequest(&request, device, phy, MII_OP_READ, reg, 0);
+
+    return MII_run(&request);
+}
+
+bool MII_writeRegister(volatile DEVICE_t *device, uint8_t phy, mii_reg_t reg, uint16_t data)
+{
+    mii_request_t request;
+    MII_setupRequest(&request, device, phy, MII_OP_WRITE, reg, data);
+
+    return MII_run(&request) >= 0;
 }
 
 bool MII_selectBlock(volatile DEVICE_t *device, uint8_t phy, uint16_t block)
@@ -299,6 +511,37 @@ int32_t MII_getBlock(volatile DEVICE_t *device, uint8_t phy)
     return MII_readRegister(device, phy, (mii_reg_t)REG_MII_BLOCK_SELECT);
 }
 
+static bool MII_getAdvertisement(uint16_t ext_status, uint16_t control, uint16_t *advertisement)
+{
+    RegMIIIeeeExtendedStatus_t status;
+    status.r16 = ext_status;
+
+    RegMII1000baseTControl_t control1G;
+    control1G.r16 = control;
+
+    if ((status.bits._1000BASE_THalfDuplexCapable != control1G.bits.Advertise1000BASE_THalfDuplex) ||
+        (status.bits._1000BASE_TFullDuplexCapable != control1G.bits.Advertise1000BASE_TFullDuplex))
+    {
+        control1G.bits.Advertise1000BASE_THalfDuplex = status.bits._1000BASE_THalfDuplexCapable;
+        control1G.bits.Advertise1000BASE_TFullDuplex = status.bits._1000BASE_TFullDuplexCapable;
+        *advertisement = control1G.r16;
+
+        return true;
+    }
+
+    return false;
+}
+
+static uint16_t MII_getRestartAutonegotiation(void)
+{
+    RegMIIControl_t control;
+    control.r16 = 0;
+    control.bits.AutoNegotiationEnable = 1;
+    control.bits.RestartAutonegotiation = 1;
+
+    return control.r16;
+}
+
 bool MII_UpdateAdvertisement(volatile DEVICE_t *device, uint8_t phy)
 {
     int32_t readVal;
@@ -307,28 +550,19 @@ bool MII_UpdateAdvertisement(volatile DEVICE_t *device, uint8_t phy)
     readVal = MII_readRegister(device, phy, (mii_reg_t)REG_MII_IEEE_EXTENDED_STATUS);
     if (readVal >= 0)
     {
-        RegMIIIeeeExtendedStatus_t status;
-        status.r16 = (uint16_t)readVal;
+        uint16_t status = (uint16_t)readVal;
 
         readVal = MII_readRegister(device, phy, (mii_reg_t)REG_MII_1000BASE_T_CONTROL);
         if (readVal >= 0)
         {
-            RegMII1000baseTControl_t control1G;
-            control1G.r16 = (uint16_t)readVal;
+            uint16_t control1G;
 
-            if ((status.bits._1000BASE_THalfDuplexCapable != control1G.bits.Advertise1000BASE_THalfDuplex) ||
-                (status.bits._1000BASE_TFullDuplexCapable != control1G.bits.Advertise1000BASE_TFullDuplex))
+            if (MII_getAdvertisement(status, (uint16_t)readVal, &control1G))
             {
-                control1G.bits.Advertise1000BASE_THalfDuplex = status.bits._1000BASE_THalfDuplexCapable;
-                control1G.bits.Advertise1000BASE_TFullDuplex = status.bits._1000BASE_TFullDuplexCapable;
-                (void)MII_writeRegister(device, phy, (mii_reg_t)REG_MII_1000BASE_T_CONTROL, control1G.r16);
+                (void)MII_writeRegister(device, phy, (mii_reg_t)REG_MII_1000BASE_T_CONTROL, control1G);
 
                 // Restart Autonegotiation.
-                RegMIIControl_t control;
-                control.r16 = 0;
-                control.bits.AutoNegotiationEnable = 1;
-                control.bits.RestartAutonegotiation = 1;
-                (void)MII_writeRegister(device, phy, (mii_reg_t)REG_MII_CONTROL, control.r16);
+                (void)MII_writeRegister(device, phy, (mii_reg_t)REG_MII_CONTROL, MII_getRestartAutonegotiation());
 
                 return true;
             }
@@ -338,25 +572,164 @@ bool MII_UpdateAdvertisement(volatile DEVICE_t *device, uint8_t phy)
     return false;
 }
 
-bool MII_reset(volatile DEVICE_t *device, uint8_t phy)
+static void MII_finishReset(mii_reset_t *reset)
 {
-    // Set MII_REG_CONTROL to RESET; wait until RESET bit clears.
-    if (MII_writeRegister(device, phy, (mii_reg_t)REG_MII_CONTROL, MII_CONTROL_RESET_MASK))
+    reset->done = true;
+
+    if (reset->callback)
     {
-        uint16_t val;
+        reset->callback(reset);
+    }
+}
+
+static void MII_resetStep(mii_request_t *request)
+{
+    mii_reset_t *reset = (mii_reset_t *)request->context;
+    volatile DEVICE_t *device = request->device;
+    uint8_t phy = request->phy;
+
+    switch (reset->state)
+    {
+        default:
+        case MII_RESET_STATE_RESET:
+            if (request->result < 0)
+            {
+                MII_finishReset(reset);
+                return;
+            }
+
+            // Wait until RESET bit clears.
+            reset->success = true;
+            reset->start = Timer_getCurrentTime1KHz();
+            reset->state = MII_RESET_STATE_POLL;
+            MII_setupRequest(request, device, phy, MII_OP_READ, (mii_reg_t)REG_MII_CONTROL, 0);
+            break;
+
+        case MII_RESET_STATE_POLL:
+            if (request->result < 0)
+            {
+                // The PHY stopped responding, nothing more can be done.
+                MII_invalidateCache(phy);
+                MII_finishReset(reset);
+                return;
+            }
+            else if ((request->result & MII_CONTROL_RESET_MASK) == MII_CONTROL_RESET_MASK)
+            {
+                if (Timer_didTimeElapsed1KHz(reset->start, MII_RESET_TIMEOUT_MS))
+                {
+                    // The reset never completed, for example an absent PHY reading back 0xffff.
+                    MII_invalidateCache(phy);
+                    reset->success = false;
+                    MII_finishReset(reset);
+                    return;
+                }
+
+                // Still resetting, poll again.
+                break;
+            }
+
+            // All reset to settle for 5ms.
+            MII_invalidateCache(phy);
+            reset->state = MII_RESET_STATE_SETTLE;
+            MII_setupRequest(request, device, phy, MII_OP_DELAY, 0, 5);
+            break;
+
+        case MII_RESET_STATE_SETTLE:
+            // Ensure 1G is advertised if supported.
+            reset->state = MII_RESET_STATE_EXT_STATUS;
+            MII_setupRequest(request, device, phy, MII_OP_READ, (mii_reg_t)REG_MII_IEEE_EXTENDED_STATUS, 0);
+            break;
 
-        do
+        case MII_RESET_STATE_EXT_STATUS:
+            if (request->result < 0)
+            {
+                MII_finishReset(reset);
+                return;
+            }
+
+            reset->ext_status = (uint16_t)request->result;
+            reset->state = MII_RESET_STATE_CONTROL_1G;
+            MII_setupRequest(request, device, phy, MII_OP_READ, (mii_reg_t)REG_MII_1000BASE_T_CONTROL, 0);
+            break;
+
+        case MII_RESET_STATE_CONTROL_1G:
         {
-            // Spin
-            val = (uint16_t)MII_readRegister(device, phy, (mii_reg_t)REG_MII_CONTROL);
-        } while ((val & MII_CONTROL_RESET_MASK) == MII_CONTROL_RESET_MASK);
+            uint16_t control1G;
+            if (request->result < 0 || !MII_getAdvertisement(reset->ext_status, (uint16_t)request->result, &control1G))
+            {
+                MII_finishReset(reset);
+                return;
+            }
 
-        // All reset to settle for 5ms.
-        Timer_delayMs(5);
+            reset->state = MII_RESET_STATE_ADVERTISE;
+            MII_setupRequest(request, device, phy, MII_OP_WRITE, (mii_reg_t)REG_MII_1000BASE_T_CONTROL, control1G);
+            break;
+        }
 
-        (void)MII_UpdateAdvertisement(device, phy);
+        case MII_RESET_STATE_ADVERTISE:
+            // Restart Autonegotiation.
+            reset->state = MII_RESET_STATE_RESTART;
+            MII_setupRequest(request, device, phy, MII_OP_WRITE, (mii_reg_t)REG_MII_CONTROL, MII_getRestartAutonegotiation());
+            break;
 
-        return true;
+        case MII_RESET_STATE_RESTART:
+            if (request->result >= 0)
+            {
+                reset->success = true;
+            }
+
+            MII_finishReset(reset);
+            return;
     }
-    return false;
+
+    request->callback = MII_resetStep;
+    request->context = reset;
+    MII_submit(request);
+}
+
+static void MII_startSequence(mii_reset_t *reset, mii_reset_state_t state, mii_reset_callback_t callback, void *context)
+{
+    reset->callback = callback;
+    reset->context = context;
+    reset->state = state;
+    reset->success = false;
+    reset->done = false;
+
+    // The remaining steps are chained from MII_resetStep.
+    reset->request.callback = MII_resetStep;
+    reset->request.context = reset;
+    MII_submit(&reset->request);
+}
+
+void MII_startReset(mii_reset_t *reset, volatile DEVICE_t *device, uint8_t phy, mii_reset_callback_t callback, void *context)
+{
+    // Set MII_REG_CONTROL to RESET.
+    MII_setupRequest(&reset->request, device, phy, MII_OP_WRITE, (mii_reg_t)REG_MII_CONTROL, MII_CONTROL_RESET_MASK);
+    MII_startSequence(reset, MII_RESET_STATE_RESET, callback, context);
+}
+
+void MII_startAdvertise(mii_reset_t *reset, volatile DEVICE_t *device, uint8_t phy, mii_reset_callback_t callback, void *context)
+{
+    // Ensure 1G is advertised if supported.
+    MII_setupRequest(&reset->request, device, phy, MII_OP_READ, (mii_reg_t)REG_MII_IEEE_EXTENDED_STATUS, 0);
+    MII_startSequence(reset, MII_RESET_STATE_EXT_STATUS, callback, context);
+}
+
+void MII_startRestart(mii_reset_t *reset, volatile DEVICE_t *device, uint8_t phy, mii_reset_callback_t callback, void *context)
+{
+    MII_setupRequest(&reset->request, device, phy, MII_OP_WRITE, (mii_reg_t)REG_MII_CONTROL, MII_getRestartAutonegotiation());
+    MII_startSequence(reset, MII_RESET_STATE_RESTART, callback, context);
+}
+
+bool MII_reset(volatile DEVICE_t *device, uint8_t phy)
+{
+    mii_reset_t reset;
+    MII_startReset(&reset, device, phy, NULL, NULL);
+
+    while (!reset.done)
+    {
+        (void)MII_processQueue();
+    }
+
+    return reset.success;
 }
@@ -0,0 +1,418 @@
+#include "gtest/gtest.h"
+#include <APE_APE.h>
+#include <APE_DEVICE1.h>
+#include <MII.h>
+#include <vector>
+
+#define PHY (DEVICE_MII_COMMUNICATION_PHY_ADDRESS_PHY_0)
+
+typedef struct
+{
+    uint32_t command;
+    uint32_t phy;
+    uint32_t reg;
+    uint32_t data; /* Value written, or the value returned for reads */
+    uint32_t time; /* 1KHz tick the transaction was started at */
+} transaction_t;
+
+// Transactions written to MiiCommunication, in order.
+static std::vector<transaction_t> gTransactions;
+
+static uint16_t gPhyRegs[32];
+static uint32_t gMiiCommunication; /* Last transaction, with the read data filled in */
+static uint32_t gBusyPolls;        /* Busy polls reported for each transaction */
+static uint32_t gBusyRemaining;
+static uint32_t gPolls;            /* MiiCommunication reads since the last transaction started */
+static bool gHang;                 /* The next transaction started never completes */
+static bool gStuck;
+static bool gAbsent;               /* No PHY on the bus, reads return 0xffff */
+static uint32_t gResetPolls;       /* Control reads that still report the reset bit */
+static uint32_t gResetRemaining;
+static uint32_t gTime;
+
+static uint32_t write_mii(uint32_t val, uint32_t offset, void *args)
+{
+    RegDEVICEMiiCommunication_t transaction;
+    transaction.r32 = val;
+
+    uint32_t reg = transaction.bits.RegisterAddress;
+    transaction_t entry = {
+        (uint32_t)transaction.bits.Command, (uint32_t)transaction.bits.PHYAddress, reg, (uint32_t)transaction.bits.TransactionData, gTime,
+    };
+
+    if (DEVICE_MII_COMMUNICATION_COMMAND_WRITE == entry.command)
+    {
+        gPhyRegs[reg] = (uint16_t)entry.data;
+        if (0 == reg && (entry.data & MII_CONTROL_RESET_MASK))
+        {
+            gResetRemaining = gResetPolls;
+        }
+    }
+    else
+    {
+        uint16_t data = gPhyRegs[reg];
+        if (0 == reg && (data & MII_CONTROL_RESET_MASK))
+        {
+            if (gResetRemaining)
+            {
+                gResetRemaining--;
+            }
+            else
+            {
+                gPhyRegs[reg] &= ~MII_CONTROL_RESET_MASK;
+                data = gPhyRegs[reg];
+            }
+        }
+
+        entry.data = gAbsent ? 0xffff : data;
+        transaction.bits.TransactionData = entry.data;
+    }
+
+    gTransactions.push_back(entry);
+    gMiiCommunication = transaction.r32;
+    gBusyRemaining = gBusyPolls;
+    gPolls = 0;
+    gStuck = gHang;
+
+    return val;
+}
+
+static uint32_t read_mii(uint32_t val, uint32_t offset, void *args)
+{
+    RegDEVICEMiiCommunication_t transaction;
+    transaction.r32 = gMiiCommunication;
+
+    gPolls++;
+    if (gStuck || gBusyRemaining)
+    {
+        if (gBusyRemaining)
+        {
+            gBusyRemaining--;
+        }
+        transaction.bits.Start_DIV_Busy = 1;
+    }
+    else
+    {
+        transaction.bits.Start_DIV_Busy = 0;
+    }
+
+    return transaction.r32;
+}
+
+static uint32_t read_tick(uint32_t val, uint32_t offset, void *args)
+{
+    return gTime++;
+}
+
+static void init_harness(void)
+{
+    static bool installed = false;
+
+    if (!installed)
+    {
+        // Callbacks are chained, only install them once.
+        installed = true;
+        DEVICE1.MiiCommunication.r32.installWriteCallback(write_mii, NULL);
+        DEVICE1.MiiCommunication.r32.installReadCallback(read_mii, NULL);
+        APE.Tick1khz.r32.installReadCallback(read_tick, NULL);
+    }
+
+    MII_abortQueue();
+    MII_invalidateCache(PHY);
+
+    gTransactions.clear();
+    memset(gPhyRegs, 0, sizeof(gPhyRegs));
+    gMiiCommunication = 0;
+    gBusyPolls = 2;
+    gBusyRemaining = 0;
+    gPolls = 0;
+    gHang = false;
+    gStuck = false;
+    gAbsent = false;
+    gResetPolls = 0;
+    gResetRemaining = 0;
+    gTime = 100;
+}
+
+static void run_queue(void)
+{
+    int max_loops = 0x100000;
+    while (MII_processQueue() && --max_loops)
+        ;
+
+    EXPECT_NE(max_loops, 0);
+    EXPECT_TRUE(MII_isIdle());
+}
+
+static void expect_transaction(size_t index, uint32_t command, uint32_t reg, uint32_t data)
+{
+    ASSERT_LT(index, gTransactions.size());
+
+    const transaction_t &transaction = gTransactions[index];
+    EXPECT_EQ(transaction.command, command) << "transaction " << index;
+    EXPECT_EQ(transaction.phy, PHY) << "transaction " << index;
+    EXPECT_EQ(transaction.reg, reg) << "transaction " << index;
+    EXPECT_EQ(transaction.data, data) << "transaction " << index;
+}
+
+namespace
+{
+
+TEST(Queue, Read)
+{
+    init_harness();
+    gPhyRegs[4] = 0x01e1;
+
+    EXPECT_EQ(MII_readRegister(&DEVICE1, PHY, (mii_reg_t)4), 0x01e1);
+
+    ASSERT_EQ(gTransactions.size(), 1);
+    expect_transaction(0, DEVICE_MII_COMMUNICATION_COMMAND_READ, 4, 0x01e1);
+}
+
+TEST(Queue, Write)
+{
+    init_harness();
+
+    EXPECT_TRUE(MII_writeRegister(&DEVICE1, PHY, (mii_reg_t)4, 0x0de1));
+
+    ASSERT_EQ(gTransactions.size(), 1);
+    expect_transaction(0, DEVICE_MII_COMMUNICATION_COMMAND_WRITE, 4, 0x0de1);
+    EXPECT_EQ(gPhyRegs[4], 0x0de1);
+}
+
+TEST(Queue, Shadow18)
+{
+    init_harness();
+
+    // Select shadow 4 for reading through the Miscellaneous Control register, then read it.
+    gPhyRegs[0x18] = 0x1234;
+    EXPECT_GE(MII_readRegister(&DEVICE1, PHY, (mii_reg_t)REG_MII_MISC_TEST_1), 0);
+    ASSERT_EQ(gTransactions.size(), 2);
+    expect_transaction(0, DEVICE_MII_COMMUNICATION_COMMAND_WRITE, 0x18, 0x4007);
+    expect_transaction(1, DEVICE_MII_COMMUNICATION_COMMAND_READ, 0x18, 0x4007);
+
+    // Writes select the shadow register with bits [2:0] of the data.
+    gTransactions.clear();
+    EXPECT_TRUE(MII_writeRegister(&DEVICE1, PHY, (mii_reg_t)REG_MII_MISC_TEST_2, 0x0400));
+    ASSERT_EQ(gTransactions.size(), 2);
+    expect_transaction(0, DEVICE_MII_COMMUNICATION_COMMAND_WRITE, 0x18, 0x5007);
+    expect_transaction(1, DEVICE_MII_COMMUNICATION_COMMAND_WRITE, 0x18, 0x0405);
+}
+
+TEST(Queue, Shadow1C)
+{
+    init_harness();
+
+    EXPECT_GE(MII_readRegister(&DEVICE1, PHY, (mii_reg_t)REG_MII_DLL_SELECTION), 0);
+    ASSERT_EQ(gTransactions.size(), 2);
+    expect_transaction(0, DEVICE_MII_COMMUNICATION_COMMAND_WRITE, 0x1c, 0x0400);
+    expect_transaction(1, DEVICE_MII_COMMUNICATION_COMMAND_READ, 0x1c, 0x0400);
+
+    // Writes set the shadow register and the write enable bit along with the data.
+    gTransactions.clear();
+    EXPECT_TRUE(MII_writeRegister(&DEVICE1, PHY, (mii_reg_t)REG_MII_SPARE_CONTROL_1, 0x0012));
+    ASSERT_EQ(gTransactions.size(), 2);
+    expect_transaction(0, DEVICE_MII_COMMUNICATION_COMMAND_WRITE, 0x1c, 0x0800);
+    expect_transaction(1, DEVICE_MII_COMMUNICATION_COMMAND_WRITE, 0x1c, 0x8812);
+}
+
+TEST(Queue, CacheBypassOnBlockSelect)
+{
+    init_harness();
+    uint32_t hits = MII_getCacheHits(PHY);
+    uint32_t misses = MII_getCacheMisses(PHY);
+
+    gPhyRegs[2] = 0x600d;
+    EXPECT_EQ(MII_readRegister(&DEVICE1, PHY, (mii_reg_t)REG_MII_PHY_ID_HIGH), 0x600d);
+    EXPECT_EQ(MII_readRegister(&DEVICE1, PHY, (mii_reg_t)REG_MII_PHY_ID_HIGH), 0x600d);
+    EXPECT_EQ(gTransactions.size(), 1);
+    EXPECT_EQ(MII_getCacheHits(PHY), hits + 1);
+    EXPECT_EQ(MII_getCacheMisses(PHY), misses + 1);
+
+    // Another block aliases the cached registers, every read goes to the PHY.
+    EXPECT_TRUE(MII_selectBlock(&DEVICE1, PHY, 1));
+    gPhyRegs[2] = 0xb10c;
+    EXPECT_EQ(MII_readRegister(&DEVICE1, PHY, (mii_reg_t)REG_MII_PHY_ID_HIGH), 0xb10c);
+    EXPECT_EQ(MII_readRegister(&DEVICE1, PHY, (mii_reg_t)REG_MII_PHY_ID_HIGH), 0xb10c);
+    ASSERT_EQ(gTransactions.size(), 4);
+    expect_transaction(1, DEVICE_MII_COMMUNICATION_COMMAND_WRITE, 0x1f, 1);
+    expect_transaction(2, DEVICE_MII_COMMUNICATION_COMMAND_READ, 2, 0xb10c);
+    expect_transaction(3, DEVICE_MII_COMMUNICATION_COMMAND_READ, 2, 0xb10c);
+    EXPECT_EQ(MII_getCacheHits(PHY), hits + 1);
+
+    // Back on block 0 the value cached earlier is used again.
+    EXPECT_TRUE(MII_selectBlock(&DEVICE1, PHY, 0));
+    EXPECT_EQ(MII_readRegister(&DEVICE1, PHY, (mii_reg_t)REG_MII_PHY_ID_HIGH), 0x600d);
+    EXPECT_EQ(gTransactions.size(), 5);
+    EXPECT_EQ(MII_getCacheHits(PHY), hits + 2);
+}
+
+TEST(Queue, PollTimeout)
+{
+    init_harness();
+
+    // The transaction is started, then polled until the poll limit is reached.
+    gHang = true;
+    EXPECT_LT(MII_readRegister(&DEVICE1, PHY, (mii_reg_t)4), 0);
+    EXPECT_EQ(gTransactions.size(), 1);
+    EXPECT_EQ(gPolls, 0xffff);
+    EXPECT_TRUE(MII_isIdle());
+
+    // The queue keeps going once the bus recovers.
+    gHang = false;
+    gStuck = false;
+    gPhyRegs[5] = 0x5555;
+    EXPECT_EQ(MII_readRegister(&DEVICE1, PHY, (mii_reg_t)5), 0x5555);
+    EXPECT_EQ(gTransactions.size(), 2);
+}
+
+static void resubmit(mii_request_t *request)
+{
+    uint32_t *count = (uint32_t *)request->context;
+
+    if (0 == (*count)++)
+    {
+        MII_setupRequest(request, request->device, request->phy, MII_OP_READ, (mii_reg_t)6, 0);
+        request->callback = resubmit;
+        request->context = count;
+        MII_submit(request);
+    }
+}
+
+TEST(Queue, CallbackResubmit)
+{
+    init_harness();
+    gPhyRegs[5] = 0x0505;
+    gPhyRegs[6] = 0x0606;
+
+    uint32_t count = 0;
+    mii_request_t first;
+    MII_setupRequest(&first, &DEVICE1, PHY, MII_OP_READ, (mii_reg_t)5, 0);
+    first.callback = resubmit;
+    first.context = &count;
+    MII_submit(&first);
+
+    mii_request_t second;
+    MII_setupRequest(&second, &DEVICE1, PHY, MII_OP_WRITE, (mii_reg_t)4, 0x0444);
+    MII_submit(&second);
+
+    run_queue();
+
+    // The resubmitted request goes to the back of the queue.
+    ASSERT_EQ(gTransactions.size(), 3);
+    expect_transaction(0, DEVICE_MII_COMMUNICATION_COMMAND_READ, 5, 0x0505);
+    expect_transaction(1, DEVICE_MII_COMMUNICATION_COMMAND_WRITE, 4, 0x0444);
+    expect_transaction(2, DEVICE_MII_COMMUNICATION_COMMAND_READ, 6, 0x0606);
+    EXPECT_EQ(count, 2);
+    EXPECT_TRUE(first.done);
+    EXPECT_EQ(first.result, 0x0606);
+    EXPECT_TRUE(second.done);
+    EXPECT_EQ(second.result, 0);
+}
+
+static void reset_done(mii_reset_t *reset)
+{
+    ++*(uint32_t *)reset->context;
+}
+
+TEST(Reset, Sequence)
+{
+    init_harness();
+    gResetPolls = 3;
+    gPhyRegs[15] = MII_IEEE_EXTENDED_STATUS_1000BASE_T_FULL_DUPLEX_CAPABLE_MASK | MII_IEEE_EXTENDED_STATUS_1000BASE_T_HALF_DUPLEX_CAPABLE_MASK;
+    gPhyRegs[9] = 0;
+
+    uint32_t count = 0;
+    mii_reset_t reset;
+    MII_startReset(&reset, &DEVICE1, PHY, reset_done, &count);
+    run_queue();
+
+    EXPECT_TRUE(reset.done);
+    EXPECT_TRUE(reset.success);
+    EXPECT_EQ(count, 1);
+
+    ASSERT_EQ(gTransactions.size(), 9);
+    expect_transaction(0, DEVICE_MII_COMMUNICATION_COMMAND_WRITE, 0, MII_CONTROL_RESET_MASK);
+    for (size_t i = 1; i <= 3; i++)
+    {
+        expect_transaction(i, DEVICE_MII_COMMUNICATION_COMMAND_READ, 0, MII_CONTROL_RESET_MASK);
+    }
+    expect_transaction(4, DEVICE_MII_COMMUNICATION_COMMAND_READ, 0, 0);
+    expect_transaction(5, DEVICE_MII_COMMUNICATION_COMMAND_READ, 15, gPhyRegs[15]);
+    expect_transaction(6, DEVICE_MII_COMMUNICATION_COMMAND_READ, 9, 0);
+    expect_transaction(7, DEVICE_MII_COMMUNICATION_COMMAND_WRITE, 9,
+                       MII_1000BASE_T_CONTROL_ADVERTISE_1000BASE_T_FULL_DUPLEX_MASK | MII_1000BASE_T_CONTROL_ADVERTISE_1000BASE_T_HALF_DUPLEX_MASK);
+    expect_transaction(8, DEVICE_MII_COMMUNICATION_COMMAND_WRITE, 0, MII_CONTROL_AUTO_NEGOTIATION_ENABLE_MASK | MII_CONTROL_RESTART_AUTONEGOTIATION_MASK);
+
+    // The PHY is given 5ms to settle before it is accessed again.
+    EXPECT_GT(gTransactions[5].time - gTransactions[4].time, 5);
+}
+
+TEST(Reset, AdvertisementUnchanged)
+{
+    init_harness();
+    gPhyRegs[15] = MII_IEEE_EXTENDED_STATUS_1000BASE_T_FULL_DUPLEX_CAPABLE_MASK;
+    gPhyRegs[9] = MII_1000BASE_T_CONTROL_ADVERTISE_1000BASE_T_FULL_DUPLEX_MASK;
+
+    uint32_t count = 0;
+    mii_reset_t reset;
+    MII_startReset(&reset, &DEVICE1, PHY, reset_done, &count);
+    run_queue();
+
+    // Autonegotiation already advertises 1G, nothing is written after the reset.
+    EXPECT_TRUE(reset.done);
+    EXPECT_TRUE(reset.success);
+    EXPECT_EQ(count, 1);
+    ASSERT_EQ(gTransactions.size(), 4);
+    expect_transaction(0, DEVICE_MII_COMMUNICATION_COMMAND_WRITE, 0, MII_CONTROL_RESET_MASK);
+    expect_transaction(1, DEVICE_MII_COMMUNICATION_COMMAND_READ, 0, 0);
+    expect_transaction(2, DEVICE_MII_COMMUNICATION_COMMAND_READ, 15, gPhyRegs[15]);
+    expect_transaction(3, DEVICE_MII_COMMUNICATION_COMMAND_READ, 9, gPhyRegs[9]);
+}
+
+TEST(Reset, AbsentPHY)
+{
+    init_harness();
+    gAbsent = true;
+
+    uint32_t count = 0;
+    mii_reset_t reset;
+    MII_startReset(&reset, &DEVICE1, PHY, reset_done, &count);
+    run_queue();
+
+    // The reset bit never clears, the reset gives up after 500ms.
+    EXPECT_TRUE(reset.done);
+    EXPECT_FALSE(reset.success);
+    EXPECT_EQ(count, 1);
+    ASSERT_GT(gTransactions.size(), 2);
+    expect_transaction(0, DEVICE_MII_COMMUNICATION_COMMAND_WRITE, 0, MII_CONTROL_RESET_MASK);
+    for (size_t i = 1; i < gTransactions.size(); i++)
+    {
+        expect_transaction(i, DEVICE_MII_COMMUNICATION_COMMAND_READ, 0, 0xffff);
+    }
+    EXPECT_GE(gTransactions.back().time - gTransactions.front().time, 500);
+}
+
+TEST(Reset, Abort)
+{
+    init_harness();
+    gResetPolls = 100;
+
+    uint32_t count = 0;
+    mii_reset_t reset;
+    MII_startReset(&reset, &DEVICE1, PHY, reset_done, &count);
+    for (int i = 0; i < 20; i++)
+    {
+        (void)MII_processQueue();
+    }
+    EXPECT_FALSE(reset.done);
+
+    // Aborting completes the reset as failed without calling back.
+    MII_abortQueue();
+    EXPECT_TRUE(MII_isIdle());
+    EXPECT_TRUE(reset.done);
+    EXPECT_FALSE(reset.success);
+    EXPECT_EQ(count, 0);
+}
+
+} // namespace
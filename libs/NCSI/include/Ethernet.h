@@ -47,7 +47,8 @@
 
 #include <types.h>
 
-#define ETHERNET_FRAME_MIN      (64 - 4) /* Hardware automatically adds FCS (last 4 bytes) */
+#define ETHERNET_FCS_LENGTH     (4)      /* Frame check sequence, kept at the end of received frames */
+#define ETHERNET_FRAME_MIN      (64 - ETHERNET_FCS_LENGTH) /* Hardware automatically adds FCS (last 4 bytes) */
 
 typedef struct
 {
@@ -96,6 +97,7 @@ typedef struct
 } ControlPacketHeader_t;
 _Static_assert(sizeof(ControlPacketHeader_t) == 16 + PACKET_OFFSET, "sizeof(ControlPacketHeader_t) must be 16.");
 #define CONTROL_PACKET_PAYLOAD_OFFSET   (PACKET_OFFSET + 16)
+#define CONTROL_PACKET_HEADER_LENGTH    (14 + 16) /* Ethernet + NC-SI header length on the wire */
 
 #define CONTROL_PACKET_TYPE_RESPONSE                    (0x80)
 #define CONTROL_PACKET_TYPE_CLEAR_INITIAL_STATE         (0x00)
@@ -126,6 +128,7 @@ _Static_assert(sizeof(ControlPacketHeader_t) == 16 + PACKET_OFFSET, "sizeof(Cont
 #define CONTROL_PACKET_TYPE_GET_NCSI_STATS              (0x19)
 #define CONTROL_PACKET_TYPE_GET_NCSI_PASSTHRU_STATS     (0x1A)
 #define CONTROL_PACKET_OEM_COMMAND                      (0x50)
+#define CONTROL_PACKET_TYPE_AEN                         (0xFF)
 
 
 typedef struct {
@@ -210,6 +213,58 @@ typedef struct {
     uint32_t MACNumber:8;
 } SetMACAddr_t;
 
+typedef struct {
+    // Bytes 0 - 27
+    ControlPacketHeader_t   header;
+
+    // Byte 28 - 31
+    uint32_t reserved_0:16;
+    uint32_t headerPadding:16;
+
+    // Bytes 32 - 35
+    uint32_t reserved_1:16;
+    uint32_t VLANID:12;
+    uint32_t CFI:1;
+    uint32_t UserPriority:3;
+
+    // Bytes 36 - 39
+    uint32_t pad:16;
+    uint32_t Enable:1;
+    uint32_t Rsvd:7;
+    uint32_t FilterSelector:8;
+} SetVLANFilter_t;
+
+typedef struct {
+    // Bytes 0 - 27
+    ControlPacketHeader_t   header;
+
+    // Byte 28 - 31
+    uint32_t reserved_0:16;
+    uint32_t headerPadding:16;
+
+    // Bytes 32 - 35
+    uint32_t pad:16;
+    uint32_t Mode:8;
+    uint32_t reserved_1:8;
+} EnableVLAN_t;
+
+#define VLAN_MODE_VLAN_ONLY             (1) /* Only packets matching a VLAN filter */
+#define VLAN_MODE_VLAN_NON_VLAN         (2) /* Packets matching a VLAN filter and untagged packets */
+#define VLAN_MODE_ANY_VLAN_NON_VLAN     (3) /* Any tagged or untagged packet */
+
+typedef struct {
+    // Bytes 0 - 27
+    ControlPacketHeader_t   header;
+
+    // Byte 28 - 31
+    uint32_t Settings_High:16;
+    uint32_t headerPadding:16;
+
+    // Bytes 32 - 35
+    uint32_t pad:16;
+    uint32_t Settings_Low:16;
+} EnableFilter_t; /* Enable Broadcast Filter and Enable Global Multicast Filter */
+
 
 typedef struct
 {
@@ -459,6 +514,272 @@ typedef struct
 #endif
 } __attribute__((packed)) VersionResponsePacket_t;
 
+/*
+ * The statistics responses are a list of big endian 32 and 64 bit counters
+ * starting two bytes into a 32 bit word, so each counter straddles two words.
+ * Counters are stored using the payload offsets below rather than named fields.
+ */
+typedef struct
+{
+    // Bytes 0 - 11
+    uint8_t  DestinationAddress[6];
+    uint8_t  SourceAddress[6];
+
+#ifdef __LITTLE_ENDIAN__
+    // Bytes 12 - 15
+    uint32_t HeaderRevision:8;         /* Should be 1 */
+    uint32_t ManagmentControllerID:8;  /* Should be 0 */
+    uint32_t EtherType:16; // part of Ethernet header.
+
+    // Bytes 16 - 19
+    uint32_t ChannelID:8;
+    uint32_t ControlPacketType:8;
+    uint32_t InstanceID:8;
+    uint32_t reserved_0:8;
+
+    // Bytes 20 - 23
+    uint32_t reserved_2:16;
+    uint32_t PayloadLength:12;
+    uint32_t reserved_1:4;
+
+    // Bytes 24 - 27
+    uint32_t reserved_3;
+
+    // Bytes 28 - 31
+    uint16_t ResponseCode;
+    uint16_t reserved_4;
+
+    // Bytes 32 - 35
+    uint16_t Statistics_High;
+    uint16_t ReasonCode;
+
+    // Bytes 36 - 67, remaining counters and checksum.
+    uint32_t Statistics[8];
+#else
+#error Not tested
+#endif
+} __attribute__((packed)) NCSIStatisticsResponsePacket_t;
+_Static_assert(sizeof(NCSIStatisticsResponsePacket_t) == 68, "sizeof(NCSIStatisticsResponsePacket_t) must be 68.");
+
+#define NCSI_STATISTICS_PAYLOAD_LENGTH      (32)
+#define NCSI_STATISTICS_COMMANDS            (4)
+#define NCSI_STATISTICS_DROPPED             (8)
+#define NCSI_STATISTICS_COMMAND_TYPE_ERRORS (12)
+#define NCSI_STATISTICS_CHECKSUM_ERRORS     (16)
+#define NCSI_STATISTICS_RX_PACKETS          (20)
+#define NCSI_STATISTICS_TX_PACKETS          (24)
+#define NCSI_STATISTICS_AENS                (28)
+
+typedef struct
+{
+    // Bytes 0 - 11
+    uint8_t  DestinationAddress[6];
+    uint8_t  SourceAddress[6];
+
+#ifdef __LITTLE_ENDIAN__
+    // Bytes 12 - 15
+    uint32_t HeaderRevision:8;         /* Should be 1 */
+    uint32_t ManagmentControllerID:8;  /* Should be 0 */
+    uint32_t EtherType:16; // part of Ethernet header.
+
+    // Bytes 16 - 19
+    uint32_t ChannelID:8;
+    uint32_t ControlPacketType:8;
+    uint32_t InstanceID:8;
+    uint32_t reserved_0:8;
+
+    // Bytes 20 - 23
+    uint32_t reserved_2:16;
+    uint32_t PayloadLength:12;
+    uint32_t reserved_1:4;
+
+    // Bytes 24 - 27
+    uint32_t reserved_3;
+
+    // Bytes 28 - 31
+    uint16_t ResponseCode;
+    uint16_t reserved_4;
+
+    // Bytes 32 - 35
+    uint16_t Statistics_High;
+    uint16_t ReasonCode;
+
+    // Bytes 36 - 83, remaining counters and checksum.
+    uint32_t Statistics[12];
+#else
+#error Not tested
+#endif
+} __attribute__((packed)) PassthroughStatisticsResponsePacket_t;
+_Static_assert(sizeof(PassthroughStatisticsResponsePacket_t) == 84, "sizeof(PassthroughStatisticsResponsePacket_t) must be 84.");
+
+#define PASSTHROUGH_STATISTICS_PAYLOAD_LENGTH       (48)
+#define PASSTHROUGH_STATISTICS_TX_PACKETS           (4)  /* 64 bit */
+#define PASSTHROUGH_STATISTICS_TX_DROPPED           (12)
+#define PASSTHROUGH_STATISTICS_TX_CHANNEL_ERRORS    (16)
+#define PASSTHROUGH_STATISTICS_TX_UNDERSIZED        (20)
+#define PASSTHROUGH_STATISTICS_TX_OVERSIZED         (24)
+#define PASSTHROUGH_STATISTICS_RX_PACKETS           (28)
+#define PASSTHROUGH_STATISTICS_RX_DROPPED           (32)
+#define PASSTHROUGH_STATISTICS_RX_CHANNEL_ERRORS    (36)
+#define PASSTHROUGH_STATISTICS_RX_UNDERSIZED        (40)
+#define PASSTHROUGH_STATISTICS_RX_OVERSIZED         (44)
+
+typedef struct
+{
+    // Bytes 0 - 11
+    uint8_t  DestinationAddress[6];
+    uint8_t  SourceAddress[6];
+
+#ifdef __LITTLE_ENDIAN__
+    // Bytes 12 - 15
+    uint32_t HeaderRevision:8;         /* Should be 1 */
+    uint32_t ManagmentControllerID:8;  /* AEN MC ID from AEN Enable */
+    uint32_t EtherType:16; // part of Ethernet header.
+
+    // Bytes 16 - 19
+    uint32_t ChannelID:8;
+    uint32_t ControlPacketType:8;      /* Always 0xFF */
+    uint32_t InstanceID:8;             /* Always 0 */
+    uint32_t reserved_0:8;
+
+    // Bytes 20 - 23
+    uint32_t reserved_2:16;
+    uint32_t PayloadLength:12;
+    uint32_t reserved_1:4;
+
+    // Bytes 24 - 27
+    uint32_t reserved_3;
+
+    // Bytes 28 - 31
+    uint16_t reserved_5;
+    uint16_t reserved_4;
+
+    // Bytes 32 - 35
+    uint16_t LinkStatus_High;
+    uint8_t  AENType;
+    uint8_t  reserved_6;
+
+    // Bytes 36 - 39
+    uint16_t OEMLinkStatus_High;
+    uint16_t LinkStatus_Low;
+
+    // Bytes 40 - 43
+    uint16_t Checksum_High;
+    uint16_t OEMLinkStatus_Low;
+
+    uint16_t pad;
+    uint16_t Checksum_Low;
+#else
+#error Not tested
+#endif
+} __attribute__((packed)) LinkStatusAENPacket_t;
+_Static_assert(sizeof(LinkStatusAENPacket_t) == 48, "sizeof(LinkStatusAENPacket_t) must be 48.");
+
+typedef struct
+{
+    // Bytes 0 - 11
+    uint8_t  DestinationAddress[6];
+    uint8_t  SourceAddress[6];
+
+#ifdef __LITTLE_ENDIAN__
+    // Bytes 12 - 15
+    uint32_t HeaderRevision:8;         /* Should be 1 */
+    uint32_t ManagmentControllerID:8;  /* AEN MC ID from AEN Enable */
+    uint32_t EtherType:16; // part of Ethernet header.
+
+    // Bytes 16 - 19
+    uint32_t ChannelID:8;
+    uint32_t ControlPacketType:8;      /* Always 0xFF */
+    uint32_t InstanceID:8;             /* Always 0 */
+    uint32_t reserved_0:8;
+
+    // Bytes 20 - 23
+    uint32_t reserved_2:16;
+    uint32_t PayloadLength:12;
+    uint32_t reserved_1:4;
+
+    // Bytes 24 - 27
+    uint32_t reserved_3;
+
+    // Bytes 28 - 31
+    uint16_t reserved_5;
+    uint16_t reserved_4;
+
+    // Bytes 32 - 35
+    uint16_t Checksum_High;
+    uint8_t  AENType;
+    uint8_t  reserved_6;
+
+    uint16_t pad;
+    uint16_t Checksum_Low;
+#else
+#error Not tested
+#endif
+} __attribute__((packed)) ConfigurationRequiredAENPacket_t;
+_Static_assert(sizeof(ConfigurationRequiredAENPacket_t) == 40, "sizeof(ConfigurationRequiredAENPacket_t) must be 40.");
+
+typedef struct
+{
+    // Bytes 0 - 11
+    uint8_t  DestinationAddress[6];
+    uint8_t  SourceAddress[6];
+
+#ifdef __LITTLE_ENDIAN__
+    // Bytes 12 - 15
+    uint32_t HeaderRevision:8;         /* Should be 1 */
+    uint32_t ManagmentControllerID:8;  /* AEN MC ID from AEN Enable */
+    uint32_t EtherType:16; // part of Ethernet header.
+
+    // Bytes 16 - 19
+    uint32_t ChannelID:8;
+    uint32_t ControlPacketType:8;      /* Always 0xFF */
+    uint32_t InstanceID:8;             /* Always 0 */
+    uint32_t reserved_0:8;
+
+    // Bytes 20 - 23
+    uint32_t reserved_2:16;
+    uint32_t PayloadLength:12;
+    uint32_t reserved_1:4;
+
+    // Bytes 24 - 27
+    uint32_t reserved_3;
+
+    // Bytes 28 - 31
+    uint16_t reserved_5;
+    uint16_t reserved_4;
+
+    // Bytes 32 - 35
+    uint16_t HostDriverStatus_High;
+    uint8_t  AENType;
+    uint8_t  reserved_6;
+
+    // Bytes 36 - 39
+    uint16_t Checksum_High;
+    uint16_t HostDriverStatus_Low;
+
+    uint16_t pad;
+    uint16_t Checksum_Low;
+#else
+#error Not tested
+#endif
+} __attribute__((packed)) HostDriverStatusAENPacket_t;
+_Static_assert(sizeof(HostDriverStatusAENPacket_t) == 44, "sizeof(HostDriverStatusAENPacket_t) must be 44.");
+
+#define AEN_TYPE_LINK_STATUS_CHANGE             (0x00)
+#define AEN_TYPE_CONFIGURATION_REQUIRED         (0x01)
+#define AEN_TYPE_HOST_DRIVER_STATUS_CHANGE      (0x02)
+
+#define LINK_STATUS_AEN_PAYLOAD_LENGTH          (12)
+#define CONFIGURATION_REQUIRED_AEN_PAYLOAD_LENGTH   (4)
+#define HOST_DRIVER_STATUS_AEN_PAYLOAD_LENGTH   (8)
+
+/* AEN Enable, AEN Control bits. */
+#define AEN_CONTROL_LINK_STATUS_CHANGE          (1 << 0)
+#define AEN_CONTROL_CONFIGURATION_REQUIRED      (1 << 1)
+#define AEN_CONTROL_HOST_DRIVER_STATUS_CHANGE   (1 << 2)
+
+#define HOST_DRIVER_STATUS_OPERATIONAL          (1 << 0)
+
 #define CAPABILITIES_HARDWARE_ABSTRACTION   (1 << 0)
 #define CAPABILITIES_OS_PRESENCE            (1 << 1)
 #define CAPABILITIES_FLOW_CONTROL_RX        (1 << 2)
@@ -481,6 +802,12 @@ typedef union {
 
     SetMACAddr_t setMACAddr;
 
+    SetVLANFilter_t setVLANFilter;
+
+    EnableVLAN_t enableVLAN;
+
+    EnableFilter_t enableFilter;
+
     /* Response Packets */
     ResponsePacketHeader_t  responsePacket;
 
@@ -489,6 +816,17 @@ typedef union {
     CapabilitiesResponsePacket_t capabilities;
 
     VersionResponsePacket_t version;
+
+    NCSIStatisticsResponsePacket_t ncsiStatistics;
+
+    PassthroughStatisticsResponsePacket_t passthroughStatistics;
+
+    /* AEN Packets */
+    LinkStatusAENPacket_t linkStatusAEN;
+
+    ConfigurationRequiredAENPacket_t configurationRequiredAEN;
+
+    HostDriverStatusAENPacket_t hostDriverStatusAEN;
 } __attribute__((packed)) NetworkFrame_t;
 
 // Ethernet frame must be at least 64 bytes.
@@ -49,8 +49,32 @@
 #include <Ethernet.h>
 #include <Network.h>
 
+/* All supported commands fit in a minimum sized frame. */
+#define NCSI_MAX_COMMAND_LENGTH     (ETHERNET_FRAME_MIN)
+#define NCSI_HEADER_WORDS           (DIVIDE_RND_UP(sizeof(ControlPacketHeader_t), sizeof(uint32_t)))
+
+/**
+ * @fn void handleNCSIFrame(const NetworkFrame_t* frame, uint32_t start);
+ *
+ * @brief Handles a command frame received from the BMC.
+ *
+ * @param frame The command frame.
+ * @param start Timer_getCurrentTime1MHz() when the RMU reported the frame, recorded in the command trace.
+ */
 //lint -sem(handleNCSIFrame, 1p) Warn if frame is NULL
-void handleNCSIFrame(const NetworkFrame_t* frame);
+void handleNCSIFrame(const NetworkFrame_t* frame, uint32_t start);
+
+/**
+ * @fn uint32_t NCSI_getCommandLength(const NetworkFrame_t *frame);
+ *
+ * @brief Determines how many bytes of a command frame are needed to handle it.
+ *
+ * @param frame A command frame with at least the first NCSI_HEADER_WORDS words present.
+ *
+ * @returns The number of bytes, from the start of the frame, that the command handler uses.
+ */
+//lint -sem(NCSI_getCommandLength, 1p) Warn if frame is NULL
+uint32_t NCSI_getCommandLength(const NetworkFrame_t* frame);
 
 
 #define NCSI_RESPONSE_CODE_COMMAND_COMPLETE     (0)
@@ -75,13 +99,51 @@ void NCSI_TxPacket(const uint32_t* packet, uint32_t packet_len);
 //lint -sem(NCSI_TxBePacket, 2n >= 1P) Warn if packet is smaller than packet_len
 void NCSI_TxBePacket(const uint32_t* packet, uint32_t packet_len);
 
-void NCSI_handlePassthrough(void);
+unsigned int NCSI_handlePassthrough(void); /* Returns the number of frames passed to the BMC. */
+bool NCSI_passthroughPending(void);        /* Returns true if a ready channel still has a frame for the BMC. */
 
-void NCSI_init(void);
+void NCSI_init(void); /* Package state only, each channel is initialized by NCSI_initPort. */
+
+/**
+ * @fn void NCSI_initPort(NetworkPort_t *port, reload_type_t reset_phy);
+ *
+ * @brief Returns the channel using the port to its initial state.
+ *
+ * @param port The port to initialize.
+ * @param reset_phy NEVER_RESET if a host driver owns the port, otherwise the PHY is reset.
+ */
+//lint -sem(NCSI_initPort, 1p) Warn if port is NULL
+void NCSI_initPort(NetworkPort_t *port, reload_type_t reset_phy);
 
 void NCSI_reload(reload_type_t reset_phy);
 
+//lint -sem(NCSI_reloadPort, 1p) Warn if port is NULL
+void NCSI_reloadPort(NetworkPort_t *port, reload_type_t reset_phy); /* Reloads only the channel using the port. */
+
 //lint -sem(NCSI_usePort, 1p) Warn if port is NULL
 void NCSI_usePort(NetworkPort_t *port);
 
+NetworkPort_t *NCSI_getPassthroughPort(void); /* The enabled channel with network TX enabled, or NULL if there is none. */
+
+/**
+ * @fn void NCSI_sendLinkStatusAEN(NetworkPort_t *port);
+ *
+ * @brief Sends a Link Status Change AEN for the channel using the port, if enabled by the BMC.
+ *
+ * @param port The port whose link state changed.
+ */
+//lint -sem(NCSI_sendLinkStatusAEN, 1p) Warn if port is NULL
+void NCSI_sendLinkStatusAEN(NetworkPort_t *port);
+
+/**
+ * @fn void NCSI_sendHostDriverStatusAEN(NetworkPort_t *port, bool running);
+ *
+ * @brief Sends a Host NC Driver Status Change AEN for the channel using the port, if enabled by the BMC.
+ *
+ * @param port The port whose host driver changed state.
+ * @param running True if the host driver is now operational.
+ */
+//lint -sem(NCSI_sendHostDriverStatusAEN, 1p) Warn if port is NULL
+void NCSI_sendHostDriverStatusAEN(NetworkPort_t *port, bool running);
+
 #endif /* NCSI_H */
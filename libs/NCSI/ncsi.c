@@ -48,23 +48,17 @@
 #include <APE_SHM.h>
 #include <MII.h>
 #include <NCSI.h>
+#include <NetworkCopy.h>
+#include <Timer.h>
 
 #ifdef CXX_SIMULATOR
 #include <stdio.h>
 #else
 #include <printf.h>
-/* ARM */
-static inline uint32_t be32toh(uint32_t be32)
-{
-    uint32_t he32 = ((be32 & 0xFF000000) >> 24) | ((be32 & 0x00FF0000) >> 8) | ((be32 & 0x0000FF00) << 8) | ((be32 & 0x000000FF) << 24);
-
-    return he32;
-}
 #endif
 #define debug(...) printf(__VA_ARGS__)
 
-#define NUM_CHANNELS 1
-#define MAX_CHANNELS 1
+#define MAX_CHANNELS NETWORK_NUM_PORTS
 
 #define PACKAGE_ID_SHIFT 5
 #define CHANNEL_ID_MASK (0x1F)
@@ -162,8 +156,8 @@ NetworkFrame_t gCapabilitiesFrame =
         .BufferingCapabilities_Low = 0x7,
         .VLANFilterCount = 1,
         .MixedFilterCount = 1,
-        .AENControlSupport_Low = 0,
-        .ChannelCount = NUM_CHANNELS,
+        .AENControlSupport_Low = AEN_CONTROL_LINK_STATUS_CHANGE | AEN_CONTROL_CONFIGURATION_REQUIRED | AEN_CONTROL_HOST_DRIVER_STATUS_CHANGE,
+        .ChannelCount = 0,      /* Filled in by appropriate handler. */
         .VLANModeSupport = 0x7,
         .MulticastFilterCount = 1,
         .UnicastFilterCount = 1,
@@ -233,14 +227,322 @@ NetworkFrame_t gVersionFrame =
     },
 };
 
+NetworkFrame_t gNCSIStatisticsFrame =
+{
+    .ncsiStatistics = {
+        .DestinationAddress = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF},
+        .SourceAddress =      {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF},
+
+        .HeaderRevision = 1,
+        .ManagmentControllerID = 0,
+        .EtherType = ETHER_TYPE_NCSI,
+        .ChannelID = 0,         /* Filled in by appropriate handler. */
+        .ControlPacketType = CONTROL_PACKET_TYPE_RESPONSE | CONTROL_PACKET_TYPE_GET_NCSI_STATS,
+        .InstanceID = 0,        /* Filled in by appropriate handler. */
+        .reserved_0 = 0,
+        .reserved_2 = 0,
+        .PayloadLength = NCSI_STATISTICS_PAYLOAD_LENGTH,
+        .reserved_1 = 0,
+
+        .ResponseCode = NCSI_RESPONSE_CODE_COMMAND_COMPLETE,
+        .reserved_4 = 0,
+        .Statistics_High = 0,   /* Counters are filled in by appropriate handler. */
+        .ReasonCode = NCSI_REASON_CODE_NONE,
+    },
+};
+
+NetworkFrame_t gPassthroughStatisticsFrame =
+{
+    .passthroughStatistics = {
+        .DestinationAddress = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF},
+        .SourceAddress =      {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF},
+
+        .HeaderRevision = 1,
+        .ManagmentControllerID = 0,
+        .EtherType = ETHER_TYPE_NCSI,
+        .ChannelID = 0,         /* Filled in by appropriate handler. */
+        .ControlPacketType = CONTROL_PACKET_TYPE_RESPONSE | CONTROL_PACKET_TYPE_GET_NCSI_PASSTHRU_STATS,
+        .InstanceID = 0,        /* Filled in by appropriate handler. */
+        .reserved_0 = 0,
+        .reserved_2 = 0,
+        .PayloadLength = PASSTHROUGH_STATISTICS_PAYLOAD_LENGTH,
+        .reserved_1 = 0,
+
+        .ResponseCode = NCSI_RESPONSE_CODE_COMMAND_COMPLETE,
+        .reserved_4 = 0,
+        .Statistics_High = 0,   /* Counters are filled in by appropriate handler. */
+        .ReasonCode = NCSI_REASON_CODE_NONE,
+    },
+};
+
+NetworkFrame_t gLinkStatusAENFrame =
+{
+    .linkStatusAEN = {
+        .DestinationAddress = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF},
+        .SourceAddress =      {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF},
+
+        .HeaderRevision = 1,
+        .ManagmentControllerID = 0, /* Filled in from the AEN Enable command. */
+        .EtherType = ETHER_TYPE_NCSI,
+        .ChannelID = 0,         /* Filled in by appropriate handler. */
+        .ControlPacketType = CONTROL_PACKET_TYPE_AEN,
+        .InstanceID = 0,
+        .reserved_0 = 0,
+        .reserved_2 = 0,
+        .PayloadLength = LINK_STATUS_AEN_PAYLOAD_LENGTH,
+        .reserved_1 = 0,
+
+        .reserved_5 = 0,
+        .reserved_4 = 0,
+        .LinkStatus_High = 0,   /* Filled in by appropriate handler. */
+        .AENType = AEN_TYPE_LINK_STATUS_CHANGE,
+        .reserved_6 = 0,
+        .OEMLinkStatus_High = 0,
+        .LinkStatus_Low = 0,
+        .Checksum_High = 0,
+        .OEMLinkStatus_Low = 0,
+        .pad = 0,
+        .Checksum_Low = 0,
+    },
+};
+
+NetworkFrame_t gConfigurationRequiredAENFrame =
+{
+    .configurationRequiredAEN = {
+        .DestinationAddress = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF},
+        .SourceAddress =      {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF},
+
+        .HeaderRevision = 1,
+        .ManagmentControllerID = 0, /* Filled in from the AEN Enable command. */
+        .EtherType = ETHER_TYPE_NCSI,
+        .ChannelID = 0,         /* Filled in by appropriate handler. */
+        .ControlPacketType = CONTROL_PACKET_TYPE_AEN,
+        .InstanceID = 0,
+        .reserved_0 = 0,
+        .reserved_2 = 0,
+        .PayloadLength = CONFIGURATION_REQUIRED_AEN_PAYLOAD_LENGTH,
+        .reserved_1 = 0,
+
+        .reserved_5 = 0,
+        .reserved_4 = 0,
+        .Checksum_High = 0,
+        .AENType = AEN_TYPE_CONFIGURATION_REQUIRED,
+        .reserved_6 = 0,
+        .pad = 0,
+        .Checksum_Low = 0,
+    },
+};
+
+NetworkFrame_t gHostDriverStatusAENFrame =
+{
+    .hostDriverStatusAEN = {
+        .DestinationAddress = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF},
+        .SourceAddress =      {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF},
+
+        .HeaderRevision = 1,
+        .ManagmentControllerID = 0, /* Filled in from the AEN Enable command. */
+        .EtherType = ETHER_TYPE_NCSI,
+        .ChannelID = 0,         /* Filled in by appropriate handler. */
+        .ControlPacketType = CONTROL_PACKET_TYPE_AEN,
+        .InstanceID = 0,
+        .reserved_0 = 0,
+        .reserved_2 = 0,
+        .PayloadLength = HOST_DRIVER_STATUS_AEN_PAYLOAD_LENGTH,
+        .reserved_1 = 0,
+
+        .reserved_5 = 0,
+        .reserved_4 = 0,
+        .HostDriverStatus_High = 0,
+        .AENType = AEN_TYPE_HOST_DRIVER_STATUS_CHANGE,
+        .reserved_6 = 0,
+        .Checksum_High = 0,
+        .HostDriverStatus_Low = 0, /* Filled in by appropriate handler. */
+        .pad = 0,
+        .Checksum_Low = 0,
+    },
+};
+
+#define NCSI_CHECKSUM_START         (14) /* The checksum covers the NC-SI header and payload, not the Ethernet header. */
+#define NCSI_DYNAMIC_FIRST_WORD     (16 / sizeof(uint32_t)) /* ChannelID, ControlPacketType, InstanceID */
+#define NCSI_RESPONSE_MAX_WORDS     (DIVIDE_RND_UP(sizeof(NetworkFrame_t), sizeof(uint32_t)))
+
+typedef struct
+{
+    NetworkFrame_t *frame;
+    uint32_t length;          /* Number of bytes to transmit */
+    uint32_t dynamic_words;   /* Number of words, starting at NCSI_DYNAMIC_FIRST_WORD, patched per response */
+    uint32_t checksum_offset; /* Byte offset of the checksum, calculated on first use. */
+    uint32_t sum;             /* Running sum of all 16 bit words covered by the checksum. */
+} ncsi_response_t;
+
+static ncsi_response_t gResponse = {
+    .frame = &gResponseFrame,
+    .length = MAX(sizeof(gResponseFrame.responsePacket), ETHERNET_FRAME_MIN),
+    .dynamic_words = (36 - 16) / sizeof(uint32_t), /* Up to and including ReasonCode */
+};
+
+static ncsi_response_t gLinkStatusResponse = {
+    .frame = &gLinkStatusResponseFrame,
+    .length = MAX(sizeof(gLinkStatusResponseFrame.linkStatusResponse), ETHERNET_FRAME_MIN),
+    .dynamic_words = (48 - 16) / sizeof(uint32_t), /* Up to and including OEMLinkStatus_Low */
+};
+
+static ncsi_response_t gCapabilitiesResponse = {
+    .frame = &gCapabilitiesFrame,
+    .length = MAX(sizeof(gCapabilitiesFrame.capabilities), ETHERNET_FRAME_MIN),
+    .dynamic_words = (64 - 16) / sizeof(uint32_t), /* Up to and including ChannelCount */
+};
+
+static ncsi_response_t gVersionResponse = {
+    .frame = &gVersionFrame,
+    .length = MAX(sizeof(gVersionFrame.version), ETHERNET_FRAME_MIN),
+    .dynamic_words = (68 - 16) / sizeof(uint32_t), /* Up to and including PCISubsystemDevice */
+};
+
+static ncsi_response_t gNCSIStatisticsResponse = {
+    .frame = &gNCSIStatisticsFrame,
+    .length = MAX(sizeof(gNCSIStatisticsFrame.ncsiStatistics), ETHERNET_FRAME_MIN),
+    .dynamic_words = (64 - 16) / sizeof(uint32_t), /* Up to and including the last counter */
+};
+
+static ncsi_response_t gPassthroughStatisticsResponse = {
+    .frame = &gPassthroughStatisticsFrame,
+    .length = MAX(sizeof(gPassthroughStatisticsFrame.passthroughStatistics), ETHERNET_FRAME_MIN),
+    .dynamic_words = (80 - 16) / sizeof(uint32_t), /* Up to and including the last counter */
+};
+
+static ncsi_response_t gLinkStatusAEN = {
+    .frame = &gLinkStatusAENFrame,
+    .length = MAX(sizeof(gLinkStatusAENFrame.linkStatusAEN), ETHERNET_FRAME_MIN),
+    .dynamic_words = (44 - 16) / sizeof(uint32_t), /* Up to and including OEMLinkStatus_Low */
+};
+
+static ncsi_response_t gConfigurationRequiredAEN = {
+    .frame = &gConfigurationRequiredAENFrame,
+    .length = MAX(sizeof(gConfigurationRequiredAENFrame.configurationRequiredAEN), ETHERNET_FRAME_MIN),
+    .dynamic_words = (20 - 16) / sizeof(uint32_t), /* ChannelID only */
+};
+
+static ncsi_response_t gHostDriverStatusAEN = {
+    .frame = &gHostDriverStatusAENFrame,
+    .length = MAX(sizeof(gHostDriverStatusAENFrame.hostDriverStatusAEN), ETHERNET_FRAME_MIN),
+    .dynamic_words = (40 - 16) / sizeof(uint32_t), /* Up to and including HostDriverStatus_Low */
+};
+
+static inline uint32_t NCSI_checksumWord(const ncsi_response_t *response, uint32_t index, uint32_t word)
+{
+    // Words are transmitted most significant half first.
+    uint32_t offset = index * sizeof(uint32_t);
+    uint32_t sum = 0;
+
+    if (offset >= NCSI_CHECKSUM_START && offset < response->checksum_offset)
+    {
+        sum += word >> 16;
+    }
+
+    offset += sizeof(uint16_t);
+    if (offset >= NCSI_CHECKSUM_START && offset < response->checksum_offset)
+    {
+        sum += word & 0xFFFF;
+    }
+
+    return sum;
+}
+
+static inline void NCSI_setHalfWord(uint32_t *words, uint32_t offset, uint16_t value)
+{
+    uint32_t index = offset / sizeof(uint32_t);
+    if (offset % sizeof(uint32_t))
+    {
+        words[index] = (words[index] & 0xFFFF0000) | value;
+    }
+    else
+    {
+        words[index] = (words[index] & 0x0000FFFF) | ((uint32_t)value << 16);
+    }
+}
+
+static inline void NCSI_setStatistic(NetworkFrame_t *frame, uint32_t payload_offset, uint32_t value)
+{
+    uint32_t *words = (uint32_t *)frame;
+    uint32_t offset = CONTROL_PACKET_HEADER_LENGTH + payload_offset;
+
+    NCSI_setHalfWord(words, offset, value >> 16);
+    NCSI_setHalfWord(words, offset + sizeof(uint16_t), value & 0xFFFF);
+}
+
+static inline void NCSI_setStatistic64(NetworkFrame_t *frame, uint32_t payload_offset, uint64_t value)
+{
+    NCSI_setStatistic(frame, payload_offset, (uint32_t)(value >> 32));
+    NCSI_setStatistic(frame, payload_offset + sizeof(uint32_t), (uint32_t)value);
+}
+
+#define NCSI_TRACE_ENTRIES     (ARRAY_ELEMENTS(SHM.NcsiTraceStart))
+#define NCSI_TRACE_NO_RESPONSE (0xFF)
+
+// Response code of the last response sent, recorded in the command trace.
+static uint8_t gTraceResponseCode;
+
+static void NCSI_beginResponse(ncsi_response_t *response, uint32_t *saved)
+{
+    uint32_t *words = (uint32_t *)response->frame;
+
+    if (!response->checksum_offset)
+    {
+        // First use, sum the static portion of the template once.
+        response->checksum_offset = CONTROL_PACKET_HEADER_LENGTH + response->frame->responsePacket.PayloadLength;
+        response->sum = 0;
+        for (uint32_t i = 0; i < DIVIDE_RND_UP(response->checksum_offset, sizeof(uint32_t)); i++)
+        {
+            response->sum += NCSI_checksumWord(response, i, words[i]);
+        }
+    }
+
+    for (uint32_t i = 0; i < response->dynamic_words; i++)
+    {
+        saved[i] = words[NCSI_DYNAMIC_FIRST_WORD + i];
+    }
+}
+
+static void NCSI_sendResponse(ncsi_response_t *response, const uint32_t *saved)
+{
+    uint32_t *words = (uint32_t *)response->frame;
+
+    if (response->frame->responsePacket.ControlPacketType != CONTROL_PACKET_TYPE_AEN)
+    {
+        gTraceResponseCode = response->frame->responsePacket.ResponseCode;
+    }
+
+    // Only the patched words contribute a change to the checksum.
+    for (uint32_t i = 0; i < response->dynamic_words; i++)
+    {
+        uint32_t index = NCSI_DYNAMIC_FIRST_WORD + i;
+        if (words[index] != saved[i])
+        {
+            response->sum += NCSI_checksumWord(response, index, words[index]);
+            response->sum -= NCSI_checksumWord(response, index, saved[i]);
+        }
+    }
+
+    uint32_t checksum = ~response->sum + 1;
+    NCSI_setHalfWord(words, response->checksum_offset, checksum >> 16);
+    NCSI_setHalfWord(words, response->checksum_offset + sizeof(uint16_t), checksum & 0xFFFF);
+
+    NCSI_TxPacket(words, response->length);
+}
+
 typedef struct
 {
     bool selected;
+    unsigned int num_channels;
+    unsigned int passthrough_channel; /* First channel to service on the next passthrough pass. */
     NetworkPort_t *port[MAX_CHANNELS];
 } package_state_t;
 
 package_state_t gPackageState = {
     .selected = false,
+    .num_channels = 0,
+    .passthrough_channel = 0,
     .port = {
         [0] = NULL,
     },
@@ -248,7 +550,36 @@ package_state_t gPackageState = {
 
 void NCSI_usePort(NetworkPort_t *port)
 {
-    gPackageState.port[0] = port;
+    for (unsigned int ch = 0; ch < gPackageState.num_channels; ch++)
+    {
+        if (gPackageState.port[ch] == port)
+        {
+            // Already part of the package.
+            return;
+        }
+    }
+
+    if (gPackageState.num_channels < ARRAY_ELEMENTS(gPackageState.port))
+    {
+        gPackageState.port[gPackageState.num_channels++] = port;
+    }
+}
+
+NetworkPort_t *NCSI_getPassthroughPort(void)
+{
+    for (unsigned int ch = 0; ch < gPackageState.num_channels; ch++)
+    {
+        NetworkPort_t *port = gPackageState.port[ch];
+        RegSHM_CHANNELNcsiChannelInfo_t info = port->shm_channel->NcsiChannelInfo;
+        if (info.bits.Enabled && info.bits.TXPassthrough)
+        {
+            // The BMC selected this channel for network transmit.
+            return port;
+        }
+    }
+
+    // Without Enable Channel Network TX the BMC's frames must not reach the network.
+    return NULL;
 }
 
 void sendNCSIResponse(uint8_t InstanceID, uint8_t channelID, uint16_t controlID, uint16_t response_code, uint16_t reasons_code);
@@ -279,16 +610,22 @@ void unknownHandler(const NetworkFrame_t *frame)
     debug("Instance ID: %d\n", frame->controlPacket.InstanceID);
     debug("Payload Length: %d\n", frame->controlPacket.PayloadLength);
 
+    unsigned int ch = frame->controlPacket.ChannelID & CHANNEL_ID_MASK;
+    if (ch < gPackageState.num_channels)
+    {
+        ++gPackageState.port[ch]->shm_channel->NcsiChannelNcsiCommandErrors.r32;
+    }
+
     sendNCSIResponse(frame->controlPacket.InstanceID, frame->controlPacket.ChannelID, frame->controlPacket.ControlPacketType,
                      NCSI_RESPONSE_CODE_COMMAND_UNSUPPORTED, NCSI_REASON_CODE_UNKNOWN_UNSUPPORTED);
 }
 
 static void clearInitialStateHandler(const NetworkFrame_t *frame)
 {
-    int ch = frame->controlPacket.ChannelID & CHANNEL_ID_MASK;
+    unsigned int ch = frame->controlPacket.ChannelID & CHANNEL_ID_MASK;
 
     // Only send a response if this channel exists.
-    if (ch < NUM_CHANNELS)
+    if (ch < gPackageState.num_channels)
     {
         gPackageState.port[ch]->shm_channel->NcsiChannelInfo.bits.Ready = true;
         debug("Clear initial state: channel %x\n", ch);
@@ -401,24 +738,16 @@ static void setLinkHandler(const NetworkFrame_t *frame)
                      NCSI_RESPONSE_CODE_COMMAND_COMPLETE, NCSI_REASON_CODE_NONE);
 }
 
-static void getLinkStatusHandler(const NetworkFrame_t *frame)
+static RegSHM_CHANNELNcsiChannelStatus_t NCSI_updateLinkStatus(unsigned int ch)
 {
     RegMIIAuxiliaryStatusSummary_t stat;
 
-    int ch = frame->controlPacket.ChannelID & CHANNEL_ID_MASK;
     NetworkPort_t *port = gPackageState.port[ch];
-    uint8_t phy = MII_getPhy(port->device);
-
-    uint32_t rx_net = port->shm_channel->NcsiChannelNetworkRx.r32;
-    uint32_t tx_net = port->shm_channel->NcsiChannelNetworkTx.r32;
-    uint32_t rx_ncsi = port->shm_channel->NcsiChannelNcsiRx.r32;
-    uint32_t tx_ncsi = port->shm_channel->NcsiChannelNcsiTx.r32;
 
-    RegSHM_CHANNELNcsiChannelStatus_t linkStatus = port->shm_channel->NcsiChannelStatus;
+    RegSHM_CHANNELNcsiChannelStatus_t linkStatus;
+    linkStatus.r32 = port->shm_channel->NcsiChannelStatus.r32;
 
-    APE_aquireLock();
-    int32_t reg = MII_readRegister(port->device, phy, (mii_reg_t)REG_MII_AUXILIARY_STATUS_SUMMARY);
-    APE_releaseLock();
+    int32_t reg = Network_getLinkStatus(port);
     if (reg >= 0)
     {
         stat.r16 = (uint16_t)reg;
@@ -426,32 +755,47 @@ static void getLinkStatusHandler(const NetworkFrame_t *frame)
     else
     {
         // Unable to read AUX Status register. Re-using previous value.
-        debug("Error determining Link Status [%d]", frame->controlPacket.ChannelID);
+        debug("Error determining Link Status [%d]", ch);
         stat.r16 = 0;
         stat.bits.LinkStatus = linkStatus.bits.Linkup;
         stat.bits.AutoNegotiationHCD = linkStatus.bits.LinkStatus;
         stat.bits.AutoNegotiationComplete = linkStatus.bits.AutonegotiationComplete;
     }
 
-    debug("Link Status [%d] %s, NCSI TX/RX 0x%08X/0x%08X Net TX/RX 0x%08X/0x%08X\n", frame->controlPacket.ChannelID, stat.bits.LinkStatus ? "up" : "down",
+    linkStatus.bits.Linkup = stat.bits.LinkStatus;
+    linkStatus.bits.LinkStatus = stat.bits.AutoNegotiationHCD;
+    linkStatus.bits.AutonegotiationEnabled = 1;
+    linkStatus.bits.AutonegotiationComplete = stat.bits.AutoNegotiationComplete;
+
+    port->shm_channel->NcsiChannelStatus.r32 = linkStatus.r32;
+
+    return linkStatus;
+}
+
+static void getLinkStatusHandler(const NetworkFrame_t *frame)
+{
+    int ch = frame->controlPacket.ChannelID & CHANNEL_ID_MASK;
+    NetworkPort_t *port = gPackageState.port[ch];
+
+    uint32_t rx_net = port->shm_channel->NcsiChannelNetworkRx.r32;
+    uint32_t tx_net = port->shm_channel->NcsiChannelNetworkTx.r32;
+    uint32_t rx_ncsi = port->shm_channel->NcsiChannelNcsiRx.r32;
+    uint32_t tx_ncsi = port->shm_channel->NcsiChannelNcsiTx.r32;
+
+    RegSHM_CHANNELNcsiChannelStatus_t linkStatus = NCSI_updateLinkStatus(ch);
+
+    debug("Link Status [%d] %s, NCSI TX/RX 0x%08X/0x%08X Net TX/RX 0x%08X/0x%08X\n", frame->controlPacket.ChannelID, linkStatus.bits.Linkup ? "up" : "down",
           tx_ncsi, rx_ncsi, tx_net, rx_net);
 
-    if (!stat.bits.LinkStatus)
+    if (!linkStatus.bits.Linkup)
     {
         if (!Network_isLinkUp(port))
         {
-            printf("Resetting link.\n");
-            Network_resetLink(port);
+            // Escalates from an autonegotiation restart to a PHY reset, see Network_recoverLink.
+            Network_recoverLink(port);
         }
     }
 
-    linkStatus.bits.Linkup = stat.bits.LinkStatus;
-    linkStatus.bits.LinkStatus = stat.bits.AutoNegotiationHCD;
-    linkStatus.bits.AutonegotiationEnabled = 1;
-    linkStatus.bits.AutonegotiationComplete = stat.bits.AutoNegotiationComplete;
-
-    port->shm_channel->NcsiChannelStatus = linkStatus;
-
     uint32_t LinkStatus = linkStatus.r32;
     uint32_t OEMLinkStatus = 0;
     uint32_t OtherIndications = 0;
@@ -461,10 +805,10 @@ static void getLinkStatusHandler(const NetworkFrame_t *frame)
 
 static void disableVLANHandler(const NetworkFrame_t *frame)
 {
-    // TODO
     int ch = frame->controlPacket.ChannelID & CHANNEL_ID_MASK;
     NetworkPort_t *port = gPackageState.port[ch];
     port->shm_channel->NcsiChannelInfo.bits.VLAN = false;
+    Network_InitFilters(port);
 
     debug("Disable VLAN: channel %x\n", ch);
 
@@ -476,15 +820,17 @@ static void getCapabilities(const NetworkFrame_t *frame)
 {
     unsigned int ch = frame->controlPacket.ChannelID & CHANNEL_ID_MASK;
     // NetworkPort_t *port = gPackageState.port[ch];
-    uint32_t packetSize = MAX(sizeof(gCapabilitiesFrame.capabilities), ETHERNET_FRAME_MIN);
+    uint32_t saved[NCSI_RESPONSE_MAX_WORDS];
+    NCSI_beginResponse(&gCapabilitiesResponse, saved);
 
     gCapabilitiesFrame.capabilities.ChannelID = ch;
     gCapabilitiesFrame.capabilities.ControlPacketType = frame->controlPacket.ControlPacketType | CONTROL_PACKET_TYPE_RESPONSE;
     gCapabilitiesFrame.capabilities.InstanceID = frame->controlPacket.InstanceID;
     gCapabilitiesFrame.capabilities.ResponseCode = NCSI_RESPONSE_CODE_COMMAND_COMPLETE;
     gCapabilitiesFrame.capabilities.ReasonCode = NCSI_REASON_CODE_NONE;
+    gCapabilitiesFrame.capabilities.ChannelCount = gPackageState.num_channels;
 
-    NCSI_TxPacket((const uint32_t *)&gCapabilitiesFrame, packetSize);
+    NCSI_sendResponse(&gCapabilitiesResponse, saved);
 }
 
 static void getVersionID(const NetworkFrame_t *frame)
@@ -492,7 +838,8 @@ static void getVersionID(const NetworkFrame_t *frame)
     unsigned int ch = frame->controlPacket.ChannelID & CHANNEL_ID_MASK;
     NetworkPort_t *port = gPackageState.port[ch];
     DEVICE_t *device = (DEVICE_t *)port->device;
-    uint32_t packetSize = MAX(sizeof(gVersionFrame.version), ETHERNET_FRAME_MIN);
+    uint32_t saved[NCSI_RESPONSE_MAX_WORDS];
+    NCSI_beginResponse(&gVersionResponse, saved);
 
     gVersionFrame.version.ChannelID = ch;
     gVersionFrame.version.ControlPacketType = frame->controlPacket.ControlPacketType | CONTROL_PACKET_TYPE_RESPONSE;
@@ -505,17 +852,71 @@ static void getVersionID(const NetworkFrame_t *frame)
     gVersionFrame.version.PCISubsystemVendor = device->PciSubsystemId.bits.SubsystemVendorID;
     gVersionFrame.version.PCISubsystemDevice = device->PciSubsystemId.bits.SubsystemID;
 
-    NCSI_TxPacket((const uint32_t *)&gVersionFrame, packetSize);
+    NCSI_sendResponse(&gVersionResponse, saved);
+}
+
+static void getNCSIStatistics(const NetworkFrame_t *frame)
+{
+    unsigned int ch = frame->controlPacket.ChannelID & CHANNEL_ID_MASK;
+    VOLATILE SHM_CHANNEL_t *shm_ch = gPackageState.port[ch]->shm_channel;
+    NetworkFrame_t *response = &gNCSIStatisticsFrame;
+    uint32_t saved[NCSI_RESPONSE_MAX_WORDS];
+    NCSI_beginResponse(&gNCSIStatisticsResponse, saved);
+
+    response->ncsiStatistics.ChannelID = ch;
+    response->ncsiStatistics.InstanceID = frame->controlPacket.InstanceID;
+
+    // Checksums are not validated, so checksum errors are never counted.
+    NCSI_setStatistic(response, NCSI_STATISTICS_COMMANDS, shm_ch->NcsiChannelNcsiCommands.r32);
+    NCSI_setStatistic(response, NCSI_STATISTICS_DROPPED, shm_ch->NcsiChannelNcsiCommandsDropped.r32);
+    NCSI_setStatistic(response, NCSI_STATISTICS_COMMAND_TYPE_ERRORS, shm_ch->NcsiChannelNcsiCommandErrors.r32);
+    NCSI_setStatistic(response, NCSI_STATISTICS_RX_PACKETS, shm_ch->NcsiChannelNcsiRx.r32);
+    NCSI_setStatistic(response, NCSI_STATISTICS_TX_PACKETS, shm_ch->NcsiChannelNcsiTx.r32);
+    NCSI_setStatistic(response, NCSI_STATISTICS_AENS, shm_ch->NcsiChannelAenTx.r32);
+
+    NCSI_sendResponse(&gNCSIStatisticsResponse, saved);
+}
+
+static void getPassthroughStatistics(const NetworkFrame_t *frame)
+{
+    unsigned int ch = frame->controlPacket.ChannelID & CHANNEL_ID_MASK;
+    VOLATILE SHM_CHANNEL_t *shm_ch = gPackageState.port[ch]->shm_channel;
+    NetworkFrame_t *response = &gPassthroughStatisticsFrame;
+    uint32_t saved[NCSI_RESPONSE_MAX_WORDS];
+    NCSI_beginResponse(&gPassthroughStatisticsResponse, saved);
+
+    response->passthroughStatistics.ChannelID = ch;
+    response->passthroughStatistics.InstanceID = frame->controlPacket.InstanceID;
+
+    // Everything received from the BMC that was not a command was a pass-through packet.
+    uint32_t tx_packets = shm_ch->NcsiChannelNcsiRx.r32 - shm_ch->NcsiChannelNcsiCommands.r32;
+
+    NCSI_setStatistic64(response, PASSTHROUGH_STATISTICS_TX_PACKETS, tx_packets);
+    NCSI_setStatistic(response, PASSTHROUGH_STATISTICS_TX_DROPPED, shm_ch->NcsiChannelNcsiDropped.r32);
+    NCSI_setStatistic(response, PASSTHROUGH_STATISTICS_RX_PACKETS, shm_ch->NcsiChannelNetworkRx.r32);
+    NCSI_setStatistic(response, PASSTHROUGH_STATISTICS_RX_DROPPED, shm_ch->NcsiChannelNetworkDropped.r32);
+
+    NCSI_sendResponse(&gPassthroughStatisticsResponse, saved);
 }
 
 static void enableVLANHandler(const NetworkFrame_t *frame)
 {
-    // TODO
     int ch = frame->controlPacket.ChannelID & CHANNEL_ID_MASK;
     NetworkPort_t *port = gPackageState.port[ch];
-    port->shm_channel->NcsiChannelInfo.bits.VLAN = false;
+    uint32_t mode = frame->enableVLAN.Mode;
 
-    debug("Enable VLAN: channel %x\n", ch);
+    debug("Enable VLAN: channel %x, mode %d\n", ch, mode);
+
+    if (mode < VLAN_MODE_VLAN_ONLY || mode > VLAN_MODE_ANY_VLAN_NON_VLAN)
+    {
+        sendNCSIResponse(frame->controlPacket.InstanceID, frame->controlPacket.ChannelID, frame->controlPacket.ControlPacketType,
+                         NCSI_RESPONSE_CODE_COMMAND_FAILED, NCSI_REASON_CODE_INVALID_PARAM);
+        return;
+    }
+
+    port->shm_channel->NcsiChannelVlan.r32 = mode;
+    port->shm_channel->NcsiChannelInfo.bits.VLAN = true;
+    Network_InitFilters(port);
 
     sendNCSIResponse(frame->controlPacket.InstanceID, frame->controlPacket.ChannelID, frame->controlPacket.ControlPacketType,
                      NCSI_RESPONSE_CODE_COMMAND_COMPLETE, NCSI_REASON_CODE_NONE);
@@ -523,12 +924,23 @@ static void enableVLANHandler(const NetworkFrame_t *frame)
 
 static void setVLANFilter(const NetworkFrame_t *frame)
 {
-    // TODO
     int ch = frame->controlPacket.ChannelID & CHANNEL_ID_MASK;
     NetworkPort_t *port = gPackageState.port[ch];
-    port->shm_channel->NcsiChannelInfo.bits.VLAN = false;
 
-    debug("Set VLAN Filter: channel %x\n", ch);
+    debug("Set VLAN Filter: channel %x, filter %d, VLAN %d, enable %d\n", ch, frame->setVLANFilter.FilterSelector, frame->setVLANFilter.VLANID,
+          frame->setVLANFilter.Enable);
+
+    // Only a single VLAN filter is advertised in Get Capabilities.
+    if (1 != frame->setVLANFilter.FilterSelector)
+    {
+        sendNCSIResponse(frame->controlPacket.InstanceID, frame->controlPacket.ChannelID, frame->controlPacket.ControlPacketType,
+                         NCSI_RESPONSE_CODE_COMMAND_FAILED, NCSI_REASON_CODE_INVALID_PARAM);
+        return;
+    }
+
+    port->shm_channel->NcsiChannelMac0Vlan.r32 = frame->setVLANFilter.VLANID;
+    port->shm_channel->NcsiChannelMac0VlanValid.r32 = frame->setVLANFilter.Enable;
+    Network_InitFilters(port);
 
     sendNCSIResponse(frame->controlPacket.InstanceID, frame->controlPacket.ChannelID, frame->controlPacket.ControlPacketType,
                      NCSI_RESPONSE_CODE_COMMAND_COMPLETE, NCSI_REASON_CODE_NONE);
@@ -563,12 +975,59 @@ static void setMACAddressHandler(const NetworkFrame_t *frame)
 
 static void enableBroadcastFilteringHandler(const NetworkFrame_t *frame)
 {
-    // TODO
-    // channel_state_t* channel = gPackageState.port[ch];
-    // port->shm_channel->NcsiChannelInfo.bits.Enabled = false;
+    int ch = frame->controlPacket.ChannelID & CHANNEL_ID_MASK;
+    NetworkPort_t *port = gPackageState.port[ch];
+    uint32_t settings = (frame->enableFilter.Settings_Low | (frame->enableFilter.Settings_High << 16));
+
+    debug("Enable Broadcast Filtering: channel %x, settings %x\n", ch, settings);
+
+    port->shm_channel->NcsiChannelBfilt.r32 = settings & gCapabilitiesFrame.capabilities.BroadcastCapabilities_Low;
+    port->shm_channel->NcsiChannelInfo.bits.BFILT = true;
+    Network_InitFilters(port);
+
+    sendNCSIResponse(frame->controlPacket.InstanceID, frame->controlPacket.ChannelID, frame->controlPacket.ControlPacketType,
+                     NCSI_RESPONSE_CODE_COMMAND_COMPLETE, NCSI_REASON_CODE_NONE);
+}
 
+static void disableBroadcastFilteringHandler(const NetworkFrame_t *frame)
+{
     int ch = frame->controlPacket.ChannelID & CHANNEL_ID_MASK;
-    debug("Enable Broadcast Filtering: channel %x\n", ch);
+    NetworkPort_t *port = gPackageState.port[ch];
+
+    debug("Disable Broadcast Filtering: channel %x\n", ch);
+
+    port->shm_channel->NcsiChannelInfo.bits.BFILT = false;
+    Network_InitFilters(port);
+
+    sendNCSIResponse(frame->controlPacket.InstanceID, frame->controlPacket.ChannelID, frame->controlPacket.ControlPacketType,
+                     NCSI_RESPONSE_CODE_COMMAND_COMPLETE, NCSI_REASON_CODE_NONE);
+}
+
+static void enableGlobalMulticastFilteringHandler(const NetworkFrame_t *frame)
+{
+    int ch = frame->controlPacket.ChannelID & CHANNEL_ID_MASK;
+    NetworkPort_t *port = gPackageState.port[ch];
+    uint32_t settings = (frame->enableFilter.Settings_Low | (frame->enableFilter.Settings_High << 16));
+
+    debug("Enable Global Multicast Filtering: channel %x, settings %x\n", ch, settings);
+
+    port->shm_channel->NcsiChannelMfilt.r32 = settings & gCapabilitiesFrame.capabilities.MilticastCapabilities_Low;
+    port->shm_channel->NcsiChannelInfo.bits.MFILT = true;
+    Network_InitFilters(port);
+
+    sendNCSIResponse(frame->controlPacket.InstanceID, frame->controlPacket.ChannelID, frame->controlPacket.ControlPacketType,
+                     NCSI_RESPONSE_CODE_COMMAND_COMPLETE, NCSI_REASON_CODE_NONE);
+}
+
+static void disableGlobalMulticastFilteringHandler(const NetworkFrame_t *frame)
+{
+    int ch = frame->controlPacket.ChannelID & CHANNEL_ID_MASK;
+    NetworkPort_t *port = gPackageState.port[ch];
+
+    debug("Disable Global Multicast Filtering: channel %x\n", ch);
+
+    port->shm_channel->NcsiChannelInfo.bits.MFILT = false;
+    Network_InitFilters(port);
 
     sendNCSIResponse(frame->controlPacket.InstanceID, frame->controlPacket.ChannelID, frame->controlPacket.ControlPacketType,
                      NCSI_RESPONSE_CODE_COMMAND_COMPLETE, NCSI_REASON_CODE_NONE);
@@ -596,19 +1055,56 @@ ncsi_handler_t gNCSIHandlers[] = {
     [0x0D] = { .ignoreInit = false, .packageCommand = false, .payloadLength = 0, .fn = disableVLANHandler },
     [0x0E] = { .ignoreInit = false, .packageCommand = false, .payloadLength = 8, .fn = setMACAddressHandler },
     [0x10] = { .ignoreInit = false, .packageCommand = false, .payloadLength = 4, .fn = enableBroadcastFilteringHandler },
-    [0x11] = { .ignoreInit = false, .packageCommand = false, .payloadLength = 0, .fn = unknownHandler },
-    [0x12] = { .ignoreInit = false, .packageCommand = false, .payloadLength = 4, .fn = unknownHandler },
-    [0x13] = { .ignoreInit = false, .packageCommand = false, .payloadLength = 0, .fn = unknownHandler },
+    [0x11] = { .ignoreInit = false, .packageCommand = false, .payloadLength = 0, .fn = disableBroadcastFilteringHandler },
+    [0x12] = { .ignoreInit = false, .packageCommand = false, .payloadLength = 4, .fn = enableGlobalMulticastFilteringHandler },
+    [0x13] = { .ignoreInit = false, .packageCommand = false, .payloadLength = 0, .fn = disableGlobalMulticastFilteringHandler },
     [0x14] = { .ignoreInit = false, .packageCommand = false, .payloadLength = 4, .fn = unknownHandler }, // Optional
     [0x15] = { .ignoreInit = false, .packageCommand = false, .payloadLength = 0, .fn = getVersionID },
     [0x16] = { .ignoreInit = false, .packageCommand = false, .payloadLength = 0, .fn = getCapabilities },
     [0x17] = { .ignoreInit = false, .packageCommand = false, .payloadLength = 0, .fn = unknownHandler },
     [0x18] = { .ignoreInit = false, .packageCommand = false, .payloadLength = 0, .fn = unknownHandler }, // Optional
-    [0x19] = { .ignoreInit = false, .packageCommand = false, .payloadLength = 0, .fn = unknownHandler }, // Optional
-    [0x1A] = { .ignoreInit = false, .packageCommand = false, .payloadLength = 0, .fn = unknownHandler }, // Optional
+    [0x19] = { .ignoreInit = false, .packageCommand = false, .payloadLength = 0, .fn = getNCSIStatistics }, // Optional
+    [0x1A] = { .ignoreInit = false, .packageCommand = false, .payloadLength = 0, .fn = getPassthroughStatistics }, // Optional
 };
 
-void handleNCSIFrame(const NetworkFrame_t *frame)
+uint32_t NCSI_getCommandLength(const NetworkFrame_t *frame)
+{
+    uint8_t command = frame->controlPacket.ControlPacketType;
+    uint32_t length = CONTROL_PACKET_HEADER_LENGTH;
+
+    if (command < ARRAY_ELEMENTS(gNCSIHandlers) && gNCSIHandlers[command].fn)
+    {
+        // Commands with an unexpected payload length are rejected without looking at the payload.
+        if (gNCSIHandlers[command].payloadLength == frame->controlPacket.PayloadLength)
+        {
+            length += gNCSIHandlers[command].payloadLength;
+        }
+    }
+
+    return MIN(length, NCSI_MAX_COMMAND_LENGTH);
+}
+
+static void NCSI_traceCommand(const NetworkFrame_t *frame, uint32_t start)
+{
+    uint32_t index = SHM.NcsiTraceIndex.r32;
+    uint32_t slot = index % NCSI_TRACE_ENTRIES;
+    RegSHMNcsiTraceCommand_t entry;
+
+    entry.r32 = 0;
+    entry.bits.Command = frame->controlPacket.ControlPacketType;
+    entry.bits.Channel = frame->controlPacket.ChannelID;
+    entry.bits.InstanceID = frame->controlPacket.InstanceID;
+    entry.bits.ResponseCode = gTraceResponseCode;
+
+    SHM.NcsiTraceCommand[slot].r32 = entry.r32;
+    SHM.NcsiTraceStart[slot].r32 = start;
+    SHM.NcsiTraceEnd[slot].r32 = Timer_getCurrentTime1MHz();
+
+    // Publish the entry last so the host never sees a partially written slot as current.
+    SHM.NcsiTraceIndex.r32 = index + 1;
+}
+
+void handleNCSIFrame(const NetworkFrame_t *frame, uint32_t start)
 {
     uint8_t package = frame->controlPacket.ChannelID >> PACKAGE_ID_SHIFT;
     if (package != 0)
@@ -621,10 +1117,12 @@ void handleNCSIFrame(const NetworkFrame_t *frame)
     uint8_t ch = frame->controlPacket.ChannelID & CHANNEL_ID_MASK;
     uint8_t command = frame->controlPacket.ControlPacketType;
     uint16_t payloadLength = frame->controlPacket.PayloadLength;
-    ncsi_handler_t *handler = &gNCSIHandlers[command];
-    NetworkPort_t *port = ((ch >= NUM_CHANNELS) ? 0 : gPackageState.port[ch]);
+    ncsi_handler_t *handler = ((command < ARRAY_ELEMENTS(gNCSIHandlers)) ? &gNCSIHandlers[command] : 0);
+    NetworkPort_t *port = ((ch >= gPackageState.num_channels) ? 0 : gPackageState.port[ch]);
 
-    if (handler->fn)
+    gTraceResponseCode = NCSI_TRACE_NO_RESPONSE;
+
+    if (handler && handler->fn)
     {
         if (handler->payloadLength != payloadLength)
         {
@@ -632,6 +1130,10 @@ void handleNCSIFrame(const NetworkFrame_t *frame)
             debug("[%x] Unexpected payload length: 0x%04x != 0x%04x\n", command, handler->payloadLength, payloadLength);
 #endif
             // Unexpected payload length
+            if (port)
+            {
+                ++port->shm_channel->NcsiChannelNcsiCommandsDropped.r32;
+            }
             sendNCSIResponse(frame->controlPacket.InstanceID, frame->controlPacket.ChannelID, frame->controlPacket.ControlPacketType,
                              NCSI_RESPONSE_CODE_COMMAND_FAILED, NCSI_REASON_CODE_INVALID_PAYLOAD_LENGTH);
         }
@@ -644,6 +1146,7 @@ void handleNCSIFrame(const NetworkFrame_t *frame)
             if (port)
             {
                 ++port->shm_channel->NcsiChannelNcsiRx.r32;
+                ++port->shm_channel->NcsiChannelNcsiCommands.r32;
             }
             gPackageState.selected = true;
             SHM.SegSig.r32 |= (1u << command);
@@ -651,11 +1154,15 @@ void handleNCSIFrame(const NetworkFrame_t *frame)
         }
         else
         {
-            if (ch >= NUM_CHANNELS)
+            if (ch >= gPackageState.num_channels)
             {
 
                 debug("[%x] Invalid channel: %d\n", command, ch);
-                // Channel does not exist.
+                // Channel does not exist, count it against the first channel of the package.
+                if (gPackageState.num_channels)
+                {
+                    ++gPackageState.port[0]->shm_channel->NcsiChannelNcsiCommandsDropped.r32;
+                }
                 sendNCSIResponse(frame->controlPacket.InstanceID, frame->controlPacket.ChannelID, frame->controlPacket.ControlPacketType,
                                  NCSI_RESPONSE_CODE_COMMAND_FAILED, NCSI_REASON_CODE_INVALID_PARAM);
             }
@@ -666,6 +1173,7 @@ void handleNCSIFrame(const NetworkFrame_t *frame)
                 {
                     debug("[%x] Channel not initialized: %d\n", command, ch);
                     // Initialization required for the channel
+                    ++gPackageState.port[ch]->shm_channel->NcsiChannelNcsiCommandsDropped.r32;
                     sendNCSIResponse(frame->controlPacket.InstanceID, frame->controlPacket.ChannelID, frame->controlPacket.ControlPacketType,
                                      NCSI_RESPONSE_CODE_COMMAND_FAILED, NCSI_REASON_CODE_INITIALIZATION_REQUIRED);
                 }
@@ -674,6 +1182,7 @@ void handleNCSIFrame(const NetworkFrame_t *frame)
                     if (port)
                     {
                         ++port->shm_channel->NcsiChannelNcsiRx.r32;
+                        ++port->shm_channel->NcsiChannelNcsiCommands.r32;
                     }
                     SHM.SegSig.r32 |= (1u << command);
                     handler->fn(frame);
@@ -686,12 +1195,18 @@ void handleNCSIFrame(const NetworkFrame_t *frame)
         debug("[%x] Unknown command\n", command);
 
         // Unknown command.
+        if (port)
+        {
+            ++port->shm_channel->NcsiChannelNcsiCommandErrors.r32;
+        }
         sendNCSIResponse(frame->controlPacket.InstanceID, frame->controlPacket.ChannelID, frame->controlPacket.ControlPacketType,
                          NCSI_RESPONSE_CODE_COMMAND_UNSUPPORTED, NCSI_REASON_CODE_UNKNOWN_UNSUPPORTED);
     }
+
+    NCSI_traceCommand(frame, start);
 }
 
-void resetChannel(unsigned int ch)
+static void clearChannel(unsigned int ch)
 {
     NetworkPort_t *port = gPackageState.port[ch];
 
@@ -700,18 +1215,38 @@ void resetChannel(unsigned int ch)
     port->shm_channel->NcsiChannelNcsiTx.r32 = 0;
     port->shm_channel->NcsiChannelNetworkRx.r32 = 0;
     port->shm_channel->NcsiChannelNetworkTx.r32 = 0;
+    port->shm_channel->NcsiChannelNcsiCommands.r32 = 0;
+    port->shm_channel->NcsiChannelNcsiCommandErrors.r32 = 0;
+    port->shm_channel->NcsiChannelNcsiCommandsDropped.r32 = 0;
+    port->shm_channel->NcsiChannelAenTx.r32 = 0;
+    port->shm_channel->NcsiChannelAen.r32 = 0;
+    port->shm_channel->NcsiChannelNcsiDropped.r32 = 0;
+    port->shm_channel->NcsiChannelNcsiNoBlocks.r32 = 0;
+    port->shm_channel->NcsiChannelNetworkDropped.r32 = 0;
+    port->shm_channel->NcsiChannelNetworkDeferred.r32 = 0;
+    port->shm_channel->NcsiChannelNetworkErrors.r32 = 0;
+    port->shm_channel->NcsiChannelReloadMaxTime.r32 = 0;
+    port->shm_channel->NcsiChannelLinkDown.r32 = 0;
+    port->shm_channel->NcsiChannelLinkRestarts.r32 = 0;
+    port->shm_channel->NcsiChannelLinkReadvertise.r32 = 0;
+    port->shm_channel->NcsiChannelLinkResets.r32 = 0;
+    port->shm_channel->NcsiChannelLinkDownMaxTime.r32 = 0;
+    for (int i = 0; i < NETWORK_LINK_DOWN_BUCKETS; i++)
+    {
+        port->shm_channel->NcsiChannelLinkDownHistogram[i].r32 = 0;
+    }
     port->shm_channel->NcsiChannelInfo.bits.Ready = false;
 
-    uint8_t phy = MII_getPhy(port->device);
-    bool success;
-    APE_aquireLock();
-    success = MII_reset(port->device, phy);
-    APE_releaseLock();
+    // Filters return to their defaults with the cleared channel info.
+    Network_InitFilters(port);
+}
 
-    if (!success)
-    {
-        debug("resetChannel: Error writing register.\n");
-    }
+void resetChannel(unsigned int ch)
+{
+    clearChannel(ch);
+
+    // Completes in the background, see Network_resetLink.
+    Network_resetLink(gPackageState.port[ch]);
 }
 
 void reloadChannel(unsigned int ch, reload_type_t reset_phy)
@@ -721,6 +1256,10 @@ void reloadChannel(unsigned int ch, reload_type_t reset_phy)
     port->shm_channel->NcsiChannelNcsiTx.r32 = 0;
     port->shm_channel->NcsiChannelNetworkRx.r32 = 0;
     port->shm_channel->NcsiChannelNetworkTx.r32 = 0;
+    port->shm_channel->NcsiChannelNcsiCommands.r32 = 0;
+    port->shm_channel->NcsiChannelNcsiCommandErrors.r32 = 0;
+    port->shm_channel->NcsiChannelNcsiCommandsDropped.r32 = 0;
+    port->shm_channel->NcsiChannelAenTx.r32 = 0;
 
     uint32_t low = port->shm_channel->NcsiChannelMac0Mid.r32 << 16 | port->shm_channel->NcsiChannelMac0Low.r32;
     uint16_t high = (uint16_t)port->shm_channel->NcsiChannelMac0High.r32;
@@ -731,6 +1270,9 @@ void reloadChannel(unsigned int ch, reload_type_t reset_phy)
     Network_InitPort(gPackageState.port[ch], reset_phy);
 }
 
+NETWORK_FIFO_COPY_KERNEL(NCSI_copyLeWords, RegAPE_PERIBmcToNcTxBuffer_t, false)
+NETWORK_FIFO_COPY_KERNEL(NCSI_copyBeWords, RegAPE_PERIBmcToNcTxBuffer_t, true)
+
 static inline bool NCSI_TxPacket_internal(const uint32_t *packet, uint32_t packet_len, bool big_endian)
 {
     uint32_t packetWords = DIVIDE_RND_UP(packet_len, sizeof(uint32_t));
@@ -739,6 +1281,9 @@ static inline bool NCSI_TxPacket_internal(const uint32_t *packet, uint32_t packe
     txControl.r32 = 0;
     txControl.bits.LastByteCount = packet_len; /* 2 bits - automatically rounded. */
 
+    // A passthrough frame may be part way through the fifo, finish it first.
+    Network_PassthroughRxFlush();
+
     // Wait for enough free space.
     int max_loops = 0x10000;
     while (APE_PERI.BmcToNcTxStatus.bits.InFifo < packetWords && --max_loops)
@@ -750,34 +1295,18 @@ static inline bool NCSI_TxPacket_internal(const uint32_t *packet, uint32_t packe
     }
 
     // Transmit.
-    for (unsigned int i = 0; i < packetWords - 1; i++)
-    {
-        uint32_t word;
-        if (big_endian)
-        {
-            word = be32toh(packet[i]);
-        }
-        else
-        {
-            word = packet[i];
-        }
-
-        APE_PERI.BmcToNcTxBuffer.r32 = word;
-    }
-
-    APE_PERI.BmcToNcTxControl = txControl;
-
-    uint32_t last_word;
     if (big_endian)
     {
-        last_word = be32toh(packet[packetWords - 1]);
+        NCSI_copyBeWords(&APE_PERI.BmcToNcTxBuffer, packet, packetWords - 1);
     }
     else
     {
-        last_word = packet[packetWords - 1];
+        NCSI_copyLeWords(&APE_PERI.BmcToNcTxBuffer, packet, packetWords - 1);
     }
 
-    APE_PERI.BmcToNcTxBufferLast.r32 = last_word;
+    APE_PERI.BmcToNcTxControl = txControl;
+
+    APE_PERI.BmcToNcTxBufferLast.r32 = NETWORK_COPY_WORD(big_endian, packet[packetWords - 1]);
 
     return true;
 }
@@ -786,8 +1315,18 @@ void NCSI_TxPacket(const uint32_t *packet, uint32_t packet_len)
 {
     if (NCSI_TxPacket_internal(packet, packet_len, false))
     {
-        NetworkPort_t *port = gPackageState.port[0];
-        ++port->shm_channel->NcsiChannelNcsiTx.r32;
+        // Account the response to the channel it was sent for, package responses go to channel 0.
+        unsigned int ch = ((const NetworkFrame_t *)packet)->controlPacket.ChannelID & CHANNEL_ID_MASK;
+        if (ch >= gPackageState.num_channels)
+        {
+            ch = 0;
+        }
+
+        if (gPackageState.num_channels)
+        {
+            NetworkPort_t *port = gPackageState.port[ch];
+            ++port->shm_channel->NcsiChannelNcsiTx.r32;
+        }
     }
     else
     {
@@ -802,7 +1341,8 @@ void NCSI_TxBePacket(const uint32_t *packet, uint32_t packet_len)
 
 void sendNCSILinkStatusResponse(uint8_t InstanceID, uint8_t channelID, uint32_t LinkStatus, uint32_t OEMLinkStatus, uint32_t OtherIndications)
 {
-    uint32_t packetSize = MAX(sizeof(gLinkStatusResponseFrame.linkStatusResponse), ETHERNET_FRAME_MIN);
+    uint32_t saved[NCSI_RESPONSE_MAX_WORDS];
+    NCSI_beginResponse(&gLinkStatusResponse, saved);
 
     gLinkStatusResponseFrame.linkStatusResponse.ChannelID = channelID;
     gLinkStatusResponseFrame.linkStatusResponse.InstanceID = InstanceID;
@@ -816,12 +1356,13 @@ void sendNCSILinkStatusResponse(uint8_t InstanceID, uint8_t channelID, uint32_t
     gLinkStatusResponseFrame.linkStatusResponse.OtherIndications_High = OtherIndications >> 16;
     gLinkStatusResponseFrame.linkStatusResponse.OtherIndications_Low = OtherIndications & 0xffff;
 
-    NCSI_TxPacket((const uint32_t *)&gLinkStatusResponseFrame, packetSize);
+    NCSI_sendResponse(&gLinkStatusResponse, saved);
 }
 
 void sendNCSIResponse(uint8_t InstanceID, uint8_t channelID, uint16_t controlID, uint16_t response_code, uint16_t reasons_code)
 {
-    uint32_t packetSize = MAX(sizeof(gResponseFrame.responsePacket), ETHERNET_FRAME_MIN);
+    uint32_t saved[NCSI_RESPONSE_MAX_WORDS];
+    NCSI_beginResponse(&gResponse, saved);
 
     gResponseFrame.responsePacket.ChannelID = channelID;
     gResponseFrame.responsePacket.ControlPacketType = controlID | CONTROL_PACKET_TYPE_RESPONSE;
@@ -830,41 +1371,198 @@ void sendNCSIResponse(uint8_t InstanceID, uint8_t channelID, uint16_t controlID,
     gResponseFrame.responsePacket.ResponseCode = response_code;
     gResponseFrame.responsePacket.ReasonCode = reasons_code;
 
-    NCSI_TxPacket((const uint32_t *)&gResponseFrame, packetSize);
+    NCSI_sendResponse(&gResponse, saved);
 }
 
-void NCSI_init(void)
+static bool NCSI_beginAEN(ncsi_response_t *aen, unsigned int ch, uint32_t enable, uint32_t *saved)
+{
+    VOLATILE SHM_CHANNEL_t *shm_ch = gPackageState.port[ch]->shm_channel;
+
+    // AENs are only sent after the channel left the initial state and the BMC enabled them.
+    if (!shm_ch->NcsiChannelInfo.bits.Ready || !(shm_ch->NcsiChannelAen.r32 & enable))
+    {
+        return false;
+    }
+
+    uint8_t mcid = (uint8_t)shm_ch->NcsiChannelMcid.r32;
+    if (aen->frame->controlPacket.ManagmentControllerID != mcid)
+    {
+        // The MC ID is not one of the dynamic words, recalculate the checksum from scratch.
+        aen->frame->controlPacket.ManagmentControllerID = mcid;
+        aen->checksum_offset = 0;
+    }
+
+    NCSI_beginResponse(aen, saved);
+    aen->frame->controlPacket.ChannelID = ch;
+
+    return true;
+}
+
+static void NCSI_sendAEN(ncsi_response_t *aen, unsigned int ch, const uint32_t *saved)
+{
+    NCSI_sendResponse(aen, saved);
+    ++gPackageState.port[ch]->shm_channel->NcsiChannelAenTx.r32;
+}
+
+static bool NCSI_getChannel(const NetworkPort_t *port, unsigned int *ch)
+{
+    for (unsigned int i = 0; i < gPackageState.num_channels; i++)
+    {
+        if (gPackageState.port[i] == port)
+        {
+            *ch = i;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void NCSI_sendLinkStatusAEN(NetworkPort_t *port)
+{
+    unsigned int ch;
+    if (!NCSI_getChannel(port, &ch))
+    {
+        return;
+    }
+
+    uint32_t LinkStatus = NCSI_updateLinkStatus(ch).r32;
+    uint32_t OEMLinkStatus = 0;
+
+    uint32_t saved[NCSI_RESPONSE_MAX_WORDS];
+    if (NCSI_beginAEN(&gLinkStatusAEN, ch, AEN_CONTROL_LINK_STATUS_CHANGE, saved))
+    {
+        gLinkStatusAENFrame.linkStatusAEN.LinkStatus_High = LinkStatus >> 16;
+        gLinkStatusAENFrame.linkStatusAEN.LinkStatus_Low = LinkStatus & 0xffff;
+        gLinkStatusAENFrame.linkStatusAEN.OEMLinkStatus_High = OEMLinkStatus >> 16;
+        gLinkStatusAENFrame.linkStatusAEN.OEMLinkStatus_Low = OEMLinkStatus & 0xffff;
+
+        NCSI_sendAEN(&gLinkStatusAEN, ch, saved);
+    }
+}
+
+void NCSI_sendHostDriverStatusAEN(NetworkPort_t *port, bool running)
 {
-    debug("Resetting channels...\n");
-    for (unsigned int i = 0; i < ARRAY_ELEMENTS(gPackageState.port); i++)
+    uint32_t HostDriverStatus = running ? HOST_DRIVER_STATUS_OPERATIONAL : 0;
+
+    unsigned int ch;
+    if (!NCSI_getChannel(port, &ch))
+    {
+        return;
+    }
+
+    uint32_t saved[NCSI_RESPONSE_MAX_WORDS];
+    if (NCSI_beginAEN(&gHostDriverStatusAEN, ch, AEN_CONTROL_HOST_DRIVER_STATUS_CHANGE, saved))
+    {
+        gHostDriverStatusAENFrame.hostDriverStatusAEN.HostDriverStatus_High = HostDriverStatus >> 16;
+        gHostDriverStatusAENFrame.hostDriverStatusAEN.HostDriverStatus_Low = HostDriverStatus & 0xffff;
+
+        NCSI_sendAEN(&gHostDriverStatusAEN, ch, saved);
+    }
+}
+
+static void NCSI_sendConfigurationRequiredAEN(unsigned int ch)
+{
+    uint32_t saved[NCSI_RESPONSE_MAX_WORDS];
+    if (NCSI_beginAEN(&gConfigurationRequiredAEN, ch, AEN_CONTROL_CONFIGURATION_REQUIRED, saved))
     {
-        resetChannel(i);
+        NCSI_sendAEN(&gConfigurationRequiredAEN, ch, saved);
     }
+}
+
+void NCSI_init(void)
+{
     SHM.SegSig.r32 = 0; // (1u << command);
+    SHM.NcsiTraceIndex.r32 = 0;
+}
+
+void NCSI_initPort(NetworkPort_t *port, reload_type_t reset_phy)
+{
+    unsigned int ch;
+    if (!NCSI_getChannel(port, &ch))
+    {
+        return;
+    }
+
+    debug("Resetting channel %d...\n", ch);
+
+    // Let a BMC that configured the channel know that it's about to be lost.
+    NCSI_sendConfigurationRequiredAEN(ch);
+
+    if (NEVER_RESET == reset_phy)
+    {
+        // The host driver owns the PHY.
+        clearChannel(ch);
+    }
+    else
+    {
+        resetChannel(ch);
+    }
 }
 
 void NCSI_reload(reload_type_t reset_phy)
 {
-    for (unsigned int i = 0; i < ARRAY_ELEMENTS(gPackageState.port); i++)
+    for (unsigned int i = 0; i < gPackageState.num_channels; i++)
     {
         reloadChannel(i, reset_phy);
     }
 }
 
-void NCSI_handlePassthrough(void)
+void NCSI_reloadPort(NetworkPort_t *port, reload_type_t reset_phy)
 {
-    for (unsigned int ch = 0; ch < ARRAY_ELEMENTS(gPackageState.port); ch++)
+    unsigned int ch;
+    if (NCSI_getChannel(port, &ch))
     {
+        reloadChannel(ch, reset_phy);
+    }
+}
+
+unsigned int NCSI_handlePassthrough(void)
+{
+    unsigned int num_channels = gPackageState.num_channels;
+    unsigned int first = gPackageState.passthrough_channel;
+    unsigned int frames = 0;
+
+    if (first >= num_channels)
+    {
+        first = 0;
+    }
+
+    // Service each channel once, round robin. Start after the last channel
+    // that delivered a frame so that a busy channel can't starve the others
+    // when the RBT fifo fills up.
+    for (unsigned int i = 0; i < num_channels; i++)
+    {
+        unsigned int ch = first + i;
+        if (ch >= num_channels)
+        {
+            ch -= num_channels;
+        }
+
         NetworkPort_t *port = gPackageState.port[ch];
         VOLATILE SHM_CHANNEL_t *shm_ch = port->shm_channel;
 
-        if (shm_ch->NcsiChannelInfo.bits.Ready)
+        // Deferrals, RX errors and drops are counted per reason by the network layer.
+        if (shm_ch->NcsiChannelInfo.bits.Ready && PASSTHROUGH_DELIVERED == Network_PassthroughRxPatcket(port))
         {
-            if (!Network_PassthroughRxPatcket(port))
-            {
-                // Mark packet as dropped due to an error.
-                shm_ch->NcsiChannelNetworkDropped.r32 = shm_ch->NcsiChannelNetworkDropped.r32 + 1;
-            }
+            gPackageState.passthrough_channel = ch + 1;
+            frames++;
         }
     }
+
+    return frames;
+}
+
+bool NCSI_passthroughPending(void)
+{
+    for (unsigned int ch = 0; ch < gPackageState.num_channels; ch++)
+    {
+        NetworkPort_t *port = gPackageState.port[ch];
+        if (port->shm_channel->NcsiChannelInfo.bits.Ready && Network_PassthroughRxPending(port))
+        {
+            return true;
+        }
+    }
+
+    return false;
 }
@@ -1,9 +1,11 @@
 #include "gtest/gtest.h"
-// #include <APE_APE.h>
+#include <APE_APE.h>
 #include <APE_APE_PERI.h>
 #include <Ethernet.h>
 #include <NCSI.h>
+#include <Timer.h>
 #include <bcm5719-endian.h>
+#include <string.h>
 
 uint32_t *gPacket;
 uint32_t gPacketLen;
@@ -199,6 +201,78 @@ void print_packet(uint32_t *packet_u32, size_t len)
 
 }
 
+static uint32_t be32_at(const uint8_t *packet, uint32_t offset)
+{
+    return (uint32_t)packet[offset] << 24 | packet[offset + 1] << 16 | packet[offset + 2] << 8 | packet[offset + 3];
+}
+
+static uint32_t payload_length(const uint8_t *packet)
+{
+    return (packet[20] & 0xF) << 8 | packet[21];
+}
+
+// The NC-SI checksum is the two's complement of the 32 bit sum of all 16 bit
+// words from the start of the NC-SI header to the end of the payload.
+static bool checksum_valid(const uint8_t *packet)
+{
+    uint32_t end = CONTROL_PACKET_HEADER_LENGTH + payload_length(packet);
+    uint32_t sum = 0;
+    for (uint32_t i = 14; i < end; i += 2)
+    {
+        sum += packet[i] << 8 | packet[i + 1];
+    }
+
+    return 0 == sum + be32_at(packet, end);
+}
+
+static uint8_t *tx_packet(void)
+{
+    return (uint8_t *)gTXPacket;
+}
+
+// Builds a command frame for channel in package 0, the checksum is left as 0.
+static uint8_t *build_command(uint8_t type, uint8_t channel, uint8_t iid, const uint8_t *payload, uint32_t len)
+{
+    static uint32_t command[ETHERNET_FRAME_MIN / 4];
+    uint8_t *packet = (uint8_t *)command;
+
+    memset(command, 0, sizeof(command));
+    memset(packet, 0xff, 12);
+    packet[12] = 0x88; // NCSI Type
+    packet[13] = 0xf8;
+    packet[15] = 0x01; // Header Revision
+    packet[17] = iid;
+    packet[18] = type;
+    packet[19] = channel;
+    packet[21] = len;
+    if (len)
+    {
+        memcpy(&packet[CONTROL_PACKET_HEADER_LENGTH], payload, len);
+    }
+
+    return packet;
+}
+
+static void init_harness(void)
+{
+    static bool installed = false;
+
+    NCSI_usePort(Network_getPort(0));
+    if (installed)
+    {
+        // Callbacks are chained, only install them once.
+        return;
+    }
+    installed = true;
+
+    APE_PERI.BmcToNcRxStatus.r32.installReadCallback(read_rx_status, NULL);
+    APE_PERI.BmcToNcReadBuffer.r32.installReadCallback(read_packet, NULL);
+    APE_PERI.BmcToNcTxStatus.r32.installReadCallback(read_tx_status, NULL);
+
+    APE_PERI.BmcToNcTxBuffer.r32.installWriteCallback(write_packet, NULL);
+    APE_PERI.BmcToNcTxBufferLast.r32.installWriteCallback(write_packet, NULL);
+}
+
 void send_packet(uint8_t *packet, uint32_t len)
 {
     gTXPacketPos = 0; // reset response position.
@@ -235,13 +309,14 @@ void send_packet(uint8_t *packet, uint32_t len)
         }
         else if (!stat.bits.Passthru)
         {
-            handleNCSIFrame(frame);
+            handleNCSIFrame(frame, Timer_getCurrentTime1MHz());
             EXPECT_EQ(gTXPacket[0], 0xffffffff); // Source MAC
             EXPECT_EQ(gTXPacket[1], 0xffffffff); // Source/Dest MAC
             EXPECT_EQ(gTXPacket[2], 0xffffffff); // Dest MAC
             EXPECT_EQ(be32toh(gTXPacket[3]), 0x88f80001); // NCSI Type, Revision 1.
             EXPECT_EQ(be32toh(gTXPacket[4]),
                       buffer[4] |0x8000); // IID, Channel, Package, Command | 0x80
+            EXPECT_TRUE(checksum_valid(tx_packet()));
 
             print_packet((uint32_t*)gTXPacket, gTXPacketPos);
         }
@@ -259,13 +334,7 @@ namespace
 
 TEST(Packet, SelectPackage)
 {
-    NCSI_usePort(Network_getPort(0));
-    APE_PERI.BmcToNcRxStatus.r32.installReadCallback(read_rx_status, NULL);
-    APE_PERI.BmcToNcReadBuffer.r32.installReadCallback(read_packet, NULL);
-    APE_PERI.BmcToNcTxStatus.r32.installReadCallback(read_tx_status, NULL);
-
-    APE_PERI.BmcToNcTxBuffer.r32.installWriteCallback(write_packet, NULL);
-    APE_PERI.BmcToNcTxBufferLast.r32.installWriteCallback(write_packet, NULL);
+    init_harness();
 
     send_packet(deselect_package, deselect_package_len);
     // send_packet(select_package1, select_package1_len);
@@ -274,6 +343,309 @@ TEST(Packet, SelectPackage)
     // send_packet(get_capabilities, get_capabilities_len);
 }
 
+TEST(Packet, ResponseChecksum)
+{
+    init_harness();
+    send_packet(clear_initial_state, clear_initial_state_len);
+
+    // Every instance ID patches the template, the checksum has to follow.
+    for (unsigned int iid = 1; iid <= 0xFF; iid++)
+    {
+        uint8_t *command = build_command(CONTROL_PACKET_TYPE_CLEAR_INITIAL_STATE, 0, iid, NULL, 0);
+        send_packet(command, ETHERNET_FRAME_MIN);
+        EXPECT_EQ(tx_packet()[17], iid);
+    }
+
+    // The same response must be identical regardless of the responses sent before it.
+    send_packet(build_command(CONTROL_PACKET_TYPE_CLEAR_INITIAL_STATE, 0, 0x42, NULL, 0), ETHERNET_FRAME_MIN);
+    uint8_t first[sizeof(gTXPacket)];
+    uint32_t first_len = gTXPacketPos * 4;
+    memcpy(first, tx_packet(), first_len);
+
+    send_packet(build_command(CONTROL_PACKET_TYPE_GET_PARAMETERS, 0, 0x43, NULL, 0), ETHERNET_FRAME_MIN);
+    EXPECT_EQ(be32_at(tx_packet(), 30), NCSI_RESPONSE_CODE_COMMAND_UNSUPPORTED << 16 | NCSI_REASON_CODE_UNKNOWN_UNSUPPORTED);
+    send_packet(build_command(CONTROL_PACKET_TYPE_ENABLE_VLAN, 0, 0x44, NULL, 0), ETHERNET_FRAME_MIN);
+    EXPECT_EQ(be32_at(tx_packet(), 30), NCSI_RESPONSE_CODE_COMMAND_FAILED << 16 | NCSI_REASON_CODE_INVALID_PAYLOAD_LENGTH);
+    send_packet(select_package1, select_package1_len);
+    send_packet(get_capabilities, get_capabilities_len);
+
+    send_packet(build_command(CONTROL_PACKET_TYPE_CLEAR_INITIAL_STATE, 0, 0x42, NULL, 0), ETHERNET_FRAME_MIN);
+    EXPECT_EQ(gTXPacketPos * 4, first_len);
+    EXPECT_EQ(memcmp(first, tx_packet(), first_len), 0);
+}
+
+TEST(Packet, ControllerPacketStatistics)
+{
+    init_harness();
+    send_packet(clear_initial_state, clear_initial_state_len);
+
+    send_packet(build_command(CONTROL_PACKET_TYPE_GET_CONTROLLER_PACKET_STATS, 0, 0x18, NULL, 0), ETHERNET_FRAME_MIN);
+
+    // The MAC statistics clear on read and belong to the host driver, the command is not supported.
+    uint8_t *packet = tx_packet();
+    EXPECT_EQ(packet[17], 0x18);
+    EXPECT_EQ(packet[18], CONTROL_PACKET_TYPE_RESPONSE | CONTROL_PACKET_TYPE_GET_CONTROLLER_PACKET_STATS);
+    EXPECT_EQ(packet[19], 0);
+    EXPECT_EQ(payload_length(packet), 4);
+    EXPECT_EQ(be32_at(packet, 30), NCSI_RESPONSE_CODE_COMMAND_UNSUPPORTED << 16 | NCSI_REASON_CODE_UNKNOWN_UNSUPPORTED);
+}
+
+TEST(Packet, NCSIStatistics)
+{
+    init_harness();
+    send_packet(clear_initial_state, clear_initial_state_len);
+
+    VOLATILE SHM_CHANNEL_t *shm_ch = Network_getPort(0)->shm_channel;
+    shm_ch->NcsiChannelNcsiCommands.r32 = 10;
+    shm_ch->NcsiChannelNcsiCommandsDropped.r32 = 2;
+    shm_ch->NcsiChannelNcsiDropped.r32 = 9; // Pass-through drops are not NC-SI command drops.
+    shm_ch->NcsiChannelNcsiCommandErrors.r32 = 4;
+    shm_ch->NcsiChannelNcsiRx.r32 = 20;
+    shm_ch->NcsiChannelNcsiTx.r32 = 5;
+    shm_ch->NcsiChannelAenTx.r32 = 6;
+
+    // A command with the wrong payload length is dropped.
+    send_packet(build_command(CONTROL_PACKET_TYPE_ENABLE_VLAN, 0, 0x18, NULL, 0), ETHERNET_FRAME_MIN);
+    EXPECT_EQ(be32_at(tx_packet(), 30), NCSI_RESPONSE_CODE_COMMAND_FAILED << 16 | NCSI_REASON_CODE_INVALID_PAYLOAD_LENGTH);
+
+    send_packet(build_command(CONTROL_PACKET_TYPE_GET_NCSI_STATS, 0, 0x19, NULL, 0), ETHERNET_FRAME_MIN);
+
+    // The command itself is counted before the response is built, the failed command's response was sent.
+    uint8_t *packet = tx_packet();
+    EXPECT_EQ(packet[18], CONTROL_PACKET_TYPE_RESPONSE | CONTROL_PACKET_TYPE_GET_NCSI_STATS);
+    EXPECT_EQ(payload_length(packet), NCSI_STATISTICS_PAYLOAD_LENGTH);
+    EXPECT_EQ(be32_at(packet, 30), NCSI_RESPONSE_CODE_COMMAND_COMPLETE << 16 | NCSI_REASON_CODE_NONE);
+    EXPECT_EQ(be32_at(packet, CONTROL_PACKET_HEADER_LENGTH + NCSI_STATISTICS_COMMANDS), 11);
+    EXPECT_EQ(be32_at(packet, CONTROL_PACKET_HEADER_LENGTH + NCSI_STATISTICS_DROPPED), 3);
+    EXPECT_EQ(be32_at(packet, CONTROL_PACKET_HEADER_LENGTH + NCSI_STATISTICS_COMMAND_TYPE_ERRORS), 4);
+    EXPECT_EQ(be32_at(packet, CONTROL_PACKET_HEADER_LENGTH + NCSI_STATISTICS_CHECKSUM_ERRORS), 0);
+    EXPECT_EQ(be32_at(packet, CONTROL_PACKET_HEADER_LENGTH + NCSI_STATISTICS_RX_PACKETS), 21);
+    EXPECT_EQ(be32_at(packet, CONTROL_PACKET_HEADER_LENGTH + NCSI_STATISTICS_TX_PACKETS), 6);
+    EXPECT_EQ(be32_at(packet, CONTROL_PACKET_HEADER_LENGTH + NCSI_STATISTICS_AENS), 6);
+}
+
+TEST(Packet, PassthroughStatistics)
+{
+    init_harness();
+    send_packet(clear_initial_state, clear_initial_state_len);
+
+    VOLATILE SHM_CHANNEL_t *shm_ch = Network_getPort(0)->shm_channel;
+    shm_ch->NcsiChannelNcsiCommands.r32 = 10;
+    shm_ch->NcsiChannelNcsiRx.r32 = 110;
+    shm_ch->NcsiChannelNcsiDropped.r32 = 7;
+    shm_ch->NcsiChannelNetworkRx.r32 = 200;
+    shm_ch->NcsiChannelNetworkDropped.r32 = 8;
+
+    send_packet(build_command(CONTROL_PACKET_TYPE_GET_NCSI_PASSTHRU_STATS, 0, 0x1A, NULL, 0), ETHERNET_FRAME_MIN);
+
+    uint8_t *packet = tx_packet();
+    EXPECT_EQ(packet[18], CONTROL_PACKET_TYPE_RESPONSE | CONTROL_PACKET_TYPE_GET_NCSI_PASSTHRU_STATS);
+    EXPECT_EQ(payload_length(packet), PASSTHROUGH_STATISTICS_PAYLOAD_LENGTH);
+    EXPECT_EQ(be32_at(packet, 30), NCSI_RESPONSE_CODE_COMMAND_COMPLETE << 16 | NCSI_REASON_CODE_NONE);
+    EXPECT_EQ(be32_at(packet, CONTROL_PACKET_HEADER_LENGTH + PASSTHROUGH_STATISTICS_TX_PACKETS), 0);
+    EXPECT_EQ(be32_at(packet, CONTROL_PACKET_HEADER_LENGTH + PASSTHROUGH_STATISTICS_TX_PACKETS + 4), 100);
+    EXPECT_EQ(be32_at(packet, CONTROL_PACKET_HEADER_LENGTH + PASSTHROUGH_STATISTICS_TX_DROPPED), 7);
+    EXPECT_EQ(be32_at(packet, CONTROL_PACKET_HEADER_LENGTH + PASSTHROUGH_STATISTICS_TX_CHANNEL_ERRORS), 0);
+    EXPECT_EQ(be32_at(packet, CONTROL_PACKET_HEADER_LENGTH + PASSTHROUGH_STATISTICS_TX_UNDERSIZED), 0);
+    EXPECT_EQ(be32_at(packet, CONTROL_PACKET_HEADER_LENGTH + PASSTHROUGH_STATISTICS_TX_OVERSIZED), 0);
+    EXPECT_EQ(be32_at(packet, CONTROL_PACKET_HEADER_LENGTH + PASSTHROUGH_STATISTICS_RX_PACKETS), 200);
+    EXPECT_EQ(be32_at(packet, CONTROL_PACKET_HEADER_LENGTH + PASSTHROUGH_STATISTICS_RX_DROPPED), 8);
+    EXPECT_EQ(be32_at(packet, CONTROL_PACKET_HEADER_LENGTH + PASSTHROUGH_STATISTICS_RX_CHANNEL_ERRORS), 0);
+    EXPECT_EQ(be32_at(packet, CONTROL_PACKET_HEADER_LENGTH + PASSTHROUGH_STATISTICS_RX_UNDERSIZED), 0);
+    EXPECT_EQ(be32_at(packet, CONTROL_PACKET_HEADER_LENGTH + PASSTHROUGH_STATISTICS_RX_OVERSIZED), 0);
+}
+
+TEST(Packet, VLAN)
+{
+    init_harness();
+    send_packet(clear_initial_state, clear_initial_state_len);
+
+    VOLATILE SHM_CHANNEL_t *shm_ch = Network_getPort(0)->shm_channel;
+    uint8_t mode[4] = { 0, 0, 0, VLAN_MODE_VLAN_NON_VLAN };
+    send_packet(build_command(CONTROL_PACKET_TYPE_ENABLE_VLAN, 0, 1, mode, sizeof(mode)), ETHERNET_FRAME_MIN);
+    EXPECT_EQ(tx_packet()[18], CONTROL_PACKET_TYPE_RESPONSE | CONTROL_PACKET_TYPE_ENABLE_VLAN);
+    EXPECT_EQ(payload_length(tx_packet()), 4);
+    EXPECT_EQ(be32_at(tx_packet(), 30), NCSI_RESPONSE_CODE_COMMAND_COMPLETE << 16 | NCSI_REASON_CODE_NONE);
+    EXPECT_EQ((uint32_t)shm_ch->NcsiChannelVlan.r32, VLAN_MODE_VLAN_NON_VLAN);
+    EXPECT_EQ((uint32_t)shm_ch->NcsiChannelInfo.bits.VLAN, 1);
+
+    // Reserved modes are rejected and leave the current mode alone.
+    mode[3] = 0;
+    send_packet(build_command(CONTROL_PACKET_TYPE_ENABLE_VLAN, 0, 2, mode, sizeof(mode)), ETHERNET_FRAME_MIN);
+    EXPECT_EQ(be32_at(tx_packet(), 30), NCSI_RESPONSE_CODE_COMMAND_FAILED << 16 | NCSI_REASON_CODE_INVALID_PARAM);
+    mode[3] = VLAN_MODE_ANY_VLAN_NON_VLAN + 1;
+    send_packet(build_command(CONTROL_PACKET_TYPE_ENABLE_VLAN, 0, 3, mode, sizeof(mode)), ETHERNET_FRAME_MIN);
+    EXPECT_EQ(be32_at(tx_packet(), 30), NCSI_RESPONSE_CODE_COMMAND_FAILED << 16 | NCSI_REASON_CODE_INVALID_PARAM);
+    EXPECT_EQ((uint32_t)shm_ch->NcsiChannelVlan.r32, VLAN_MODE_VLAN_NON_VLAN);
+
+    send_packet(build_command(CONTROL_PACKET_TYPE_DISABLE_VLAN, 0, 4, NULL, 0), ETHERNET_FRAME_MIN);
+    EXPECT_EQ(tx_packet()[18], CONTROL_PACKET_TYPE_RESPONSE | CONTROL_PACKET_TYPE_DISABLE_VLAN);
+    EXPECT_EQ(be32_at(tx_packet(), 30), NCSI_RESPONSE_CODE_COMMAND_COMPLETE << 16 | NCSI_REASON_CODE_NONE);
+    EXPECT_EQ((uint32_t)shm_ch->NcsiChannelInfo.bits.VLAN, 0);
+}
+
+TEST(Packet, BroadcastFilter)
+{
+    init_harness();
+    send_packet(clear_initial_state, clear_initial_state_len);
+
+    // Settings outside of the advertised capabilities are ignored.
+    VOLATILE SHM_CHANNEL_t *shm_ch = Network_getPort(0)->shm_channel;
+    uint8_t settings[4] = { 0xff, 0xff, 0xff, 0xff };
+    send_packet(build_command(CONTROL_PACKET_TYPE_ENABLE_BROADCAST_FILTERING, 0, 1, settings, sizeof(settings)), ETHERNET_FRAME_MIN);
+    EXPECT_EQ(tx_packet()[18], CONTROL_PACKET_TYPE_RESPONSE | CONTROL_PACKET_TYPE_ENABLE_BROADCAST_FILTERING);
+    EXPECT_EQ(payload_length(tx_packet()), 4);
+    EXPECT_EQ(be32_at(tx_packet(), 30), NCSI_RESPONSE_CODE_COMMAND_COMPLETE << 16 | NCSI_REASON_CODE_NONE);
+    EXPECT_EQ((uint32_t)shm_ch->NcsiChannelBfilt.r32, 0xF);
+    EXPECT_EQ((uint32_t)shm_ch->NcsiChannelInfo.bits.BFILT, 1);
+
+    send_packet(build_command(CONTROL_PACKET_TYPE_DISABLE_BROADCAST_FILTERING, 0, 2, NULL, 0), ETHERNET_FRAME_MIN);
+    EXPECT_EQ(tx_packet()[18], CONTROL_PACKET_TYPE_RESPONSE | CONTROL_PACKET_TYPE_DISABLE_BROADCAST_FILTERING);
+    EXPECT_EQ(be32_at(tx_packet(), 30), NCSI_RESPONSE_CODE_COMMAND_COMPLETE << 16 | NCSI_REASON_CODE_NONE);
+    EXPECT_EQ((uint32_t)shm_ch->NcsiChannelInfo.bits.BFILT, 0);
+
+    // A missing payload is rejected without touching the filter.
+    send_packet(build_command(CONTROL_PACKET_TYPE_ENABLE_BROADCAST_FILTERING, 0, 3, NULL, 0), ETHERNET_FRAME_MIN);
+    EXPECT_EQ(be32_at(tx_packet(), 30), NCSI_RESPONSE_CODE_COMMAND_FAILED << 16 | NCSI_REASON_CODE_INVALID_PAYLOAD_LENGTH);
+    EXPECT_EQ((uint32_t)shm_ch->NcsiChannelInfo.bits.BFILT, 0);
+}
+
+TEST(Packet, MulticastFilter)
+{
+    init_harness();
+    send_packet(clear_initial_state, clear_initial_state_len);
+
+    VOLATILE SHM_CHANNEL_t *shm_ch = Network_getPort(0)->shm_channel;
+    uint8_t settings[4] = { 0xff, 0xff, 0xff, 0xff };
+    send_packet(build_command(CONTROL_PACKET_TYPE_ENABLE_GLOBAL_MULTICAST_FILTERING, 0, 1, settings, sizeof(settings)), ETHERNET_FRAME_MIN);
+    EXPECT_EQ(tx_packet()[18], CONTROL_PACKET_TYPE_RESPONSE | CONTROL_PACKET_TYPE_ENABLE_GLOBAL_MULTICAST_FILTERING);
+    EXPECT_EQ(payload_length(tx_packet()), 4);
+    EXPECT_EQ(be32_at(tx_packet(), 30), NCSI_RESPONSE_CODE_COMMAND_COMPLETE << 16 | NCSI_REASON_CODE_NONE);
+    EXPECT_EQ((uint32_t)shm_ch->NcsiChannelMfilt.r32, 0x7);
+    EXPECT_EQ((uint32_t)shm_ch->NcsiChannelInfo.bits.MFILT, 1);
+
+    send_packet(build_command(CONTROL_PACKET_TYPE_DISABLE_GLOBAL_MULTICAST_FILTERING, 0, 2, NULL, 0), ETHERNET_FRAME_MIN);
+    EXPECT_EQ(tx_packet()[18], CONTROL_PACKET_TYPE_RESPONSE | CONTROL_PACKET_TYPE_DISABLE_GLOBAL_MULTICAST_FILTERING);
+    EXPECT_EQ(be32_at(tx_packet(), 30), NCSI_RESPONSE_CODE_COMMAND_COMPLETE << 16 | NCSI_REASON_CODE_NONE);
+    EXPECT_EQ((uint32_t)shm_ch->NcsiChannelInfo.bits.MFILT, 0);
+}
+
+// Lets the link status be reported from the cache instead of the PHY.
+static void cache_link_status(NetworkPort_t *port, bool up)
+{
+    RegMIIAuxiliaryStatusSummary_t stat;
+    stat.r16 = 0;
+    stat.bits.LinkStatus = up;
+    stat.bits.AutoNegotiationComplete = up;
+    port->link_status = stat.r16;
+    port->link_status_time = APE.Tick1khz.r32;
+    port->link_status_valid = true;
+}
+
+// Clears channel 0 and enables all AENs on it.
+static void enable_aens(void)
+{
+    init_harness();
+    NCSI_initPort(Network_getPort(0), NEVER_RESET);
+    send_packet(clear_initial_state, clear_initial_state_len);
+    send_packet(aen_enable, aen_enable_len);
+    gTXPacketPos = 0;
+}
+
+static void expect_aen(uint8_t type, uint32_t length)
+{
+    uint8_t *packet = tx_packet();
+
+    EXPECT_EQ(gTXPacket[0], 0xffffffff);
+    EXPECT_EQ(gTXPacket[1], 0xffffffff);
+    EXPECT_EQ(gTXPacket[2], 0xffffffff);
+    EXPECT_EQ(be32toh(gTXPacket[3]), 0x88f80001); // NCSI Type, MC ID 0, Revision 1.
+    EXPECT_EQ(packet[17], 0);                     // AENs use instance ID 0.
+    EXPECT_EQ(packet[18], CONTROL_PACKET_TYPE_AEN);
+    EXPECT_EQ(packet[19], 0);
+    EXPECT_EQ(payload_length(packet), length);
+    EXPECT_EQ(packet[33], type);
+    EXPECT_GE(gTXPacketPos * 4, CONTROL_PACKET_HEADER_LENGTH + length + 4);
+    EXPECT_TRUE(checksum_valid(packet));
+}
+
+TEST(AEN, NotEnabled)
+{
+    init_harness();
+    NetworkPort_t *port = Network_getPort(0);
+
+    // Not sent until the channel left the initial state.
+    NCSI_initPort(port, NEVER_RESET);
+    gTXPacketPos = 0;
+    NCSI_sendHostDriverStatusAEN(port, true);
+    EXPECT_EQ(gTXPacketPos, 0);
+
+    // Not sent until the BMC enabled them.
+    send_packet(clear_initial_state, clear_initial_state_len);
+    gTXPacketPos = 0;
+    NCSI_sendHostDriverStatusAEN(port, true);
+    cache_link_status(port, true);
+    NCSI_sendLinkStatusAEN(port);
+    port->link_status_valid = false;
+    EXPECT_EQ(gTXPacketPos, 0);
+
+    // Ports that are not part of the package never send one.
+    enable_aens();
+    NCSI_sendHostDriverStatusAEN(Network_getPort(1), true);
+    EXPECT_EQ(gTXPacketPos, 0);
+}
+
+TEST(AEN, HostDriverStatus)
+{
+    enable_aens();
+    NetworkPort_t *port = Network_getPort(0);
+
+    NCSI_sendHostDriverStatusAEN(port, true);
+    expect_aen(AEN_TYPE_HOST_DRIVER_STATUS_CHANGE, HOST_DRIVER_STATUS_AEN_PAYLOAD_LENGTH);
+    EXPECT_EQ(be32_at(tx_packet(), 34), HOST_DRIVER_STATUS_OPERATIONAL);
+    EXPECT_EQ((uint32_t)port->shm_channel->NcsiChannelAenTx.r32, 1);
+
+    gTXPacketPos = 0;
+    NCSI_sendHostDriverStatusAEN(port, false);
+    expect_aen(AEN_TYPE_HOST_DRIVER_STATUS_CHANGE, HOST_DRIVER_STATUS_AEN_PAYLOAD_LENGTH);
+    EXPECT_EQ(be32_at(tx_packet(), 34), 0);
+    EXPECT_EQ((uint32_t)port->shm_channel->NcsiChannelAenTx.r32, 2);
+}
+
+TEST(AEN, LinkStatus)
+{
+    enable_aens();
+    NetworkPort_t *port = Network_getPort(0);
+
+    cache_link_status(port, true);
+    NCSI_sendLinkStatusAEN(port);
+    expect_aen(AEN_TYPE_LINK_STATUS_CHANGE, LINK_STATUS_AEN_PAYLOAD_LENGTH);
+
+    RegSHM_CHANNELNcsiChannelStatus_t status;
+    status.r32 = be32_at(tx_packet(), 34);
+    EXPECT_EQ((uint32_t)status.bits.Linkup, 1);
+    EXPECT_EQ((uint32_t)status.bits.AutonegotiationComplete, 1);
+    EXPECT_EQ((uint32_t)status.r32, (uint32_t)port->shm_channel->NcsiChannelStatus.r32);
+    EXPECT_EQ(be32_at(tx_packet(), 38), 0); // OEM Link Status
+
+    port->link_status_valid = false;
+}
+
+TEST(AEN, ConfigurationRequired)
+{
+    enable_aens();
+    NetworkPort_t *port = Network_getPort(0);
+
+    NCSI_initPort(port, NEVER_RESET);
+    expect_aen(AEN_TYPE_CONFIGURATION_REQUIRED, CONFIGURATION_REQUIRED_AEN_PAYLOAD_LENGTH);
+
+    // The channel is back in the initial state with AENs disabled.
+    EXPECT_EQ((uint32_t)port->shm_channel->NcsiChannelInfo.bits.Ready, 0);
+    gTXPacketPos = 0;
+    NCSI_initPort(port, NEVER_RESET);
+    EXPECT_EQ(gTXPacketPos, 0);
+}
+
 // TEST(Packet, GetCapabilities)
 // {
 //     // APE_PERI.BmcToNcRxStatus.r32.installReadCallback(read_rx_status, NULL);
@@ -52,8 +52,57 @@
 #include <APE_RX_PORT0.h>
 #include <APE_TX_PORT0.h>
 #include <APE_SHM_CHANNEL0.h>
+#include <MII.h>
 #include <types.h>
 
+#define NETWORK_NUM_PORTS (4)
+
+#define NETWORK_TX_MAX_BLOCKS (ARRAY_ELEMENTS(((TX_PORT_t *)0)->Out) / TX_PORT_OUT_ALL_BLOCK_WORDS) /* Blocks in each port's TX pool. */
+#define NETWORK_RX_MAX_BLOCKS (ARRAY_ELEMENTS(((RX_PORT_t *)0)->In) / RX_PORT_IN_ALL_BLOCK_WORDS)  /* Blocks in each port's RX pool. */
+
+#define NETWORK_TX_CACHE_BLOCKS (16) /* Blocks prefetched per port, enough for a maximum sized standard frame. */
+#define NETWORK_TX_REFILL_BLOCKS (4) /* Maximum allocator round trips per call to Network_TX_refillBlocks. */
+
+/* Link recovery steps, from cheapest to most disruptive. */
+typedef enum {
+    NETWORK_RECOVERY_NONE,      /* Link up, or no recovery attempted yet */
+    NETWORK_RECOVERY_RESTART,   /* Autonegotiation restarted */
+    NETWORK_RECOVERY_ADVERTISE, /* Advertisement updated and autonegotiation restarted */
+    NETWORK_RECOVERY_RESET      /* PHY reset */
+} network_recovery_stage_t;
+
+/* EEE and MAC clock configuration, from lowest latency to lowest power. */
+typedef enum {
+    NETWORK_POWER_ACTIVE, /* EEE LPI off, full MAC clock */
+    NETWORK_POWER_IDLE,   /* EEE LPI on, the Network_InitPort default */
+    NETWORK_POWER_DEEP    /* EEE LPI on, reduced D0u MAC clock. Only usable below 1000Mb/s. */
+} network_power_profile_t;
+
+typedef struct
+{
+    uint32_t set;   /* Bits that must be set */
+    uint32_t clear; /* Bits that must be cleared, applied before set */
+} NetworkRegShadow_t;
+
+/* Intended DEVICE register configuration, applied by Network_InitPort when the hardware differs. */
+typedef struct
+{
+    bool valid;
+    NetworkRegShadow_t D0uClockPolicy;
+    NetworkRegShadow_t ReceiveMacMode;
+    NetworkRegShadow_t TransmitMacMode;
+    NetworkRegShadow_t EeeMode;
+    NetworkRegShadow_t BufferManagerMode;
+    NetworkRegShadow_t EmacMode;
+    NetworkRegShadow_t TransmitMacLengths;
+    NetworkRegShadow_t MiscellaneousConfig;
+    NetworkRegShadow_t LinkAwarePowerModeClockPolicy;
+    NetworkRegShadow_t ClockSpeedOverridePolicy;
+    NetworkRegShadow_t CpmuControl;
+    NetworkRegShadow_t ReceiveListPlacementMode;
+    NetworkRegShadow_t GrcModeControl;
+} NetworkPortShadow_t;
+
 typedef struct
 {
     /* Port Registers */
@@ -82,8 +131,50 @@ typedef struct
     /* State Trackking */
     bool link_state_printed;
     bool network_resetting;
+
+    /* PHY */
+    uint8_t function; /* PCIe function of the port, selects the APE PHY lock shared with its host driver */
+    uint8_t phy; /* MDIO address of the port PHY, 0 until looked up by Network_getPhy */
+    bool link_resetting; /* phy_reset is queued, the PHY lock is held until it completes */
+    mii_reset_t phy_reset;
+
+    /* Link Recovery */
+    network_recovery_stage_t link_recovery_stage; /* Last step taken since the link went down */
+    uint32_t link_recovery_time;                  /* 1KHz timestamp of the last completed step */
+    uint32_t link_recovery_backoff;               /* Milliseconds to wait for the link before the next step */
+    uint32_t link_down_time;                      /* 1KHz timestamp the link was seen going down, 0 while up */
+
+    /* Link Status Cache */
+    bool link_status_valid;
+    uint16_t link_status;       /* Last MII Auxiliary Status Summary read from the PHY */
+    uint32_t link_status_time;  /* 1KHz timestamp of link_status */
+
+    /* Passthrough State (Network to BMC), valid while passthrough_blocks is non-zero */
+    uint32_t passthrough_rxbuf;        /* Rxbufoffset value of the frame in progress */
+    uint32_t passthrough_blocks;       /* Upper bound on the blocks left, the chain ends at the block without not_last */
+    uint32_t passthrough_block;        /* Block being copied */
+    uint32_t passthrough_word;         /* Next payload word of passthrough_block */
+    uint32_t passthrough_retire;       /* First copied block that has not been retired */
+    uint32_t passthrough_retire_count; /* Copied blocks waiting for a retire write */
+
+    /* TX Free Block Cache, large enough to hold every block of the pool so released blocks are never handed back. */
+    uint16_t tx_cache[NETWORK_TX_MAX_BLOCKS];
+    uint32_t tx_cache_count;
+
+    /* Reload State */
+    NetworkPortShadow_t shadow;
+    uint32_t reload_writes; /* Registers written by the current Network_InitPort call */
 } NetworkPort_t;
 
+#define NETWORK_LINK_STATUS_MAX_AGE_MS  (5000) /* Re-read the PHY if no link change refreshed the cache in this long. */
+
+#define NETWORK_RECOVERY_RESTART_MS     (3000)  /* Time for autonegotiation to complete before escalating. */
+#define NETWORK_RECOVERY_RESET_MS       (5000)  /* Time for a reset PHY to bring the link up before resetting again. */
+#define NETWORK_RECOVERY_MAX_BACKOFF_MS (60000) /* Repeated resets back off up to this interval. */
+
+#define NETWORK_LINK_DOWN_BUCKETS   (6)   /* Entries in NcsiChannelLinkDownHistogram */
+#define NETWORK_LINK_DOWN_BUCKET_MS (250) /* Upper bound of the first bucket, each following bucket is 4 times longer. */
+
 typedef union
 {
     uint32_t r32;
@@ -102,35 +193,64 @@ typedef enum {
     ALWAYS_RESET /* Host was just turned off, reset phy */
 } reload_type_t;
 
+typedef enum {
+    PASSTHROUGH_IDLE,      /* No frame pending */
+    PASSTHROUGH_DELIVERED, /* A frame was sent to the BMC */
+    PASSTHROUGH_DEFERRED,  /* The RMU fifo is full or busy, the frame is resumed on the next pass */
+    PASSTHROUGH_RX_ERROR,  /* The RX pool reported an error, waiting for it to recover */
+    PASSTHROUGH_DROPPED    /* The frame was dropped after a fifo timeout or a bad block chain */
+} passthrough_status_t;
+
+typedef enum {
+    TX_PASSTHROUGH_SENT,      /* The frame was queued in the TX pool */
+    TX_PASSTHROUGH_DROPPED,   /* The frame was too short to send and was dropped */
+    TX_PASSTHROUGH_NO_BLOCKS, /* The TX pool is out of blocks for now, the frame was dropped */
+    TX_PASSTHROUGH_LOCKED_UP  /* The TX pool is halted or in error, the frame was dropped and the pool needs a reset */
+} tx_passthrough_status_t;
+
 NetworkPort_t *Network_getPort(int i);
 
 void Network_InitPort(NetworkPort_t *port, reload_type_t force_reset);
+void Network_InitFilters(NetworkPort_t *port); /* Programs the RX filters from the NC-SI filter settings in SHM. */
 
 void Network_resetTX(NetworkPort_t *port, reload_type_t reset_phy);
 void Network_resetRX(NetworkPort_t *port, reload_type_t reset_phy);
 
-void Network_checkPortState(NetworkPort_t *port);
+bool Network_checkPortState(NetworkPort_t *port); /* Returns true when a link change was handled. */
 bool Network_updatePortState(NetworkPort_t *port);
 bool Network_checkEnableState(NetworkPort_t *port);
+void Network_setPowerProfile(NetworkPort_t *port, network_power_profile_t profile); /* Kept across reloads. */
 
 bool Network_isLinkUp(NetworkPort_t *port);
-void Network_resetLink(NetworkPort_t *port);
+void Network_resetLink(NetworkPort_t *port); /* Queues a PHY reset, completed from MII_processQueue. */
+void Network_abortLinkReset(NetworkPort_t *port); /* Forgets a queued PHY reset after MII_abortQueue, the PHY lock is not released. */
+void Network_recoverLink(NetworkPort_t *port); /* Queues the next link recovery step once the previous one has had time to work. */
+
+uint8_t Network_getPhy(NetworkPort_t *port); /* Returns the MDIO address of the port PHY. */
+int32_t Network_getLinkStatus(NetworkPort_t *port); /* Returns the MII Auxiliary Status Summary, or a negative value on error. */
+void Network_invalidateLinkStatus(NetworkPort_t *port);
 
 
 uint32_t Network_TX_numBlocksNeeded(uint32_t frame_size);
+uint32_t Network_TX_maxFrameSize(void); /* Largest frame, without FCS, that fits in the TX pool. */
 int32_t Network_TX_allocateBlock(NetworkPort_t *port);
 void Network_TX_releaseBlock(NetworkPort_t *port, int32_t block);
+void Network_TX_refillBlocks(NetworkPort_t *port); /* Tops up the free block cache, call when idle. */
+void Network_TX_flushBlocks(NetworkPort_t *port);  /* Drops cached blocks, required whenever the TX pool is reset. */
 
 bool Network_TX_transmitBePacket(uint8_t *packet, uint32_t length, NetworkPort_t *port);
 bool Network_TX_transmitLePacket(uint8_t *packet, uint32_t length, NetworkPort_t *port);
 
-bool Network_TX_transmitPassthroughPacket(uint32_t length, NetworkPort_t *port);
+tx_passthrough_status_t Network_TX_transmitPassthroughPacket(uint32_t length, NetworkPort_t *port); /* length includes the FCS */
 
 // void Network_TX_transmitPassthroughPacket(RegAPE_PERIBmcToNcRxStatus_t
 // rx_status);
 
 bool Network_RxLePatcket(uint32_t *buffer, uint32_t *length, NetworkPort_t *port);
-bool Network_PassthroughRxPatcket(NetworkPort_t *port);
+passthrough_status_t Network_PassthroughRxPatcket(NetworkPort_t *port); /* Yields with PASSTHROUGH_DEFERRED if the RMU fifo is full. */
+bool Network_PassthroughRxPending(NetworkPort_t *port);                  /* A frame is partially sent or waiting in the RX pool. */
+void Network_PassthroughRxFlush(void);                                   /* Completes any partially sent frame, the RMU fifo is free afterwards. */
+void Network_PassthroughRxAbort(NetworkPort_t *port);
 
 void Network_SetMACAddr(NetworkPort_t *port, uint16_t high, uint32_t low, uint32_t index, bool enabled);
 
@@ -0,0 +1,149 @@
+////////////////////////////////////////////////////////////////////////////////
+///
+/// @file       NetworkCopy.h
+///
+/// @project
+///
+/// @brief      Word copy kernels for moving frames into the APE hardware
+///
+////////////////////////////////////////////////////////////////////////////////
+///
+////////////////////////////////////////////////////////////////////////////////
+///
+/// @copyright Copyright (c) 2019-2020, Evan Lojewski
+/// @cond
+///
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+/// 1. Redistributions of source code must retain the above copyright notice,
+/// this list of conditions and the following disclaimer.
+/// 2. Redistributions in binary form must reproduce the above copyright notice,
+/// this list of conditions and the following disclaimer in the documentation
+/// and/or other materials provided with the distribution.
+/// 3. Neither the name of the copyright holder nor the
+/// names of its contributors may be used to endorse or promote products
+/// derived from this software without specific prior written permission.
+///
+////////////////////////////////////////////////////////////////////////////////
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+/// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+/// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+/// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+/// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+/// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+/// POSSIBILITY OF SUCH DAMAGE.
+/// @endcond
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef NETWORK_COPY_H
+#define NETWORK_COPY_H
+
+#include <types.h>
+
+#define NETWORK_COPY_UNROLL (4) /* Words moved per loop iteration. */
+
+static inline uint32_t Network_swap32(uint32_t value)
+{
+    // A single REV instruction on the Cortex-M3.
+    return __builtin_bswap32(value);
+}
+
+#define NETWORK_COPY_WORD(__swap__, __word__) ((__swap__) ? Network_swap32(__word__) : (__word__))
+
+/*
+ * The kernels below are specialized per byte order at compile time, callers
+ * pick the kernel once per frame instead of testing the byte order per word.
+ *
+ * NETWORK_BLOCK_COPY_KERNEL(name, type, swap) defines
+ *      void name(VOLATILE type *dst, const uint32_t *src, uint32_t words)
+ * copying words into consecutive registers, e.g. a TX block.
+ *
+ * NETWORK_FIFO_COPY_KERNEL(name, type, swap) defines the same signature
+ * but writes every word to *dst, e.g. the RMU TX fifo.
+ */
+#ifdef CXX_SIMULATOR
+template <bool swap, bool fifo, typename T> static inline void Network_copyWords(T *dst, const uint32_t *src, uint32_t words)
+{
+    const int step = fifo ? 0 : 1;
+
+    while (words >= NETWORK_COPY_UNROLL)
+    {
+        dst[0 * step].r32 = NETWORK_COPY_WORD(swap, src[0]);
+        dst[1 * step].r32 = NETWORK_COPY_WORD(swap, src[1]);
+        dst[2 * step].r32 = NETWORK_COPY_WORD(swap, src[2]);
+        dst[3 * step].r32 = NETWORK_COPY_WORD(swap, src[3]);
+
+        dst += NETWORK_COPY_UNROLL * step;
+        src += NETWORK_COPY_UNROLL;
+        words -= NETWORK_COPY_UNROLL;
+    }
+
+    while (words--)
+    {
+        dst->r32 = NETWORK_COPY_WORD(swap, *src++);
+        dst += step;
+    }
+}
+
+#define NETWORK_BLOCK_COPY_KERNEL(__name__, __type__, __swap__)                                                                                                \
+    static inline void __name__(__type__ *dst, const uint32_t *src, uint32_t words)                                                                            \
+    {                                                                                                                                                          \
+        Network_copyWords<__swap__, false>(dst, src, words);                                                                                                   \
+    }
+
+#define NETWORK_FIFO_COPY_KERNEL(__name__, __type__, __swap__)                                                                                                 \
+    static inline void __name__(__type__ *dst, const uint32_t *src, uint32_t words)                                                                            \
+    {                                                                                                                                                          \
+        Network_copyWords<__swap__, true>(dst, src, words);                                                                                                    \
+    }
+#else
+#define NETWORK_BLOCK_COPY_KERNEL(__name__, __type__, __swap__)                                                                                                \
+    static inline void __name__(volatile __type__ *dst, const uint32_t *src, uint32_t words)                                                                   \
+    {                                                                                                                                                          \
+        while (words >= NETWORK_COPY_UNROLL)                                                                                                                   \
+        {                                                                                                                                                      \
+            dst[0].r32 = NETWORK_COPY_WORD(__swap__, src[0]);                                                                                                  \
+            dst[1].r32 = NETWORK_COPY_WORD(__swap__, src[1]);                                                                                                  \
+            dst[2].r32 = NETWORK_COPY_WORD(__swap__, src[2]);                                                                                                  \
+            dst[3].r32 = NETWORK_COPY_WORD(__swap__, src[3]);                                                                                                  \
+                                                                                                                                                               \
+            dst += NETWORK_COPY_UNROLL;                                                                                                                        \
+            src += NETWORK_COPY_UNROLL;                                                                                                                        \
+            words -= NETWORK_COPY_UNROLL;                                                                                                                      \
+        }                                                                                                                                                      \
+                                                                                                                                                               \
+        while (words--)                                                                                                                                        \
+        {                                                                                                                                                      \
+            (dst++)->r32 = NETWORK_COPY_WORD(__swap__, *src++);                                                                                                \
+        }                                                                                                                                                      \
+    }
+
+#define NETWORK_FIFO_COPY_KERNEL(__name__, __type__, __swap__)                                                                                                 \
+    static inline void __name__(volatile __type__ *dst, const uint32_t *src, uint32_t words)                                                                   \
+    {                                                                                                                                                          \
+        while (words >= NETWORK_COPY_UNROLL)                                                                                                                   \
+        {                                                                                                                                                      \
+            dst->r32 = NETWORK_COPY_WORD(__swap__, src[0]);                                                                                                    \
+            dst->r32 = NETWORK_COPY_WORD(__swap__, src[1]);                                                                                                    \
+            dst->r32 = NETWORK_COPY_WORD(__swap__, src[2]);                                                                                                    \
+            dst->r32 = NETWORK_COPY_WORD(__swap__, src[3]);                                                                                                    \
+                                                                                                                                                               \
+            src += NETWORK_COPY_UNROLL;                                                                                                                        \
+            words -= NETWORK_COPY_UNROLL;                                                                                                                      \
+        }                                                                                                                                                      \
+                                                                                                                                                               \
+        while (words--)                                                                                                                                        \
+        {                                                                                                                                                      \
+            dst->r32 = NETWORK_COPY_WORD(__swap__, *src++);                                                                                                    \
+        }                                                                                                                                                      \
+    }
+#endif /* CXX_SIMULATOR */
+
+#endif /* NETWORK_COPY_H */
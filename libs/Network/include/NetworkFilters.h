@@ -0,0 +1,111 @@
+////////////////////////////////////////////////////////////////////////////////
+///
+/// @file       NetworkFilters.h
+///
+/// @project
+///
+/// @brief      RX filter table image loaded from the NVM code directory
+///
+////////////////////////////////////////////////////////////////////////////////
+///
+////////////////////////////////////////////////////////////////////////////////
+///
+/// @copyright Copyright (c) 2019-2020, Evan Lojewski
+/// @cond
+///
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+/// 1. Redistributions of source code must retain the above copyright notice,
+/// this list of conditions and the following disclaimer.
+/// 2. Redistributions in binary form must reproduce the above copyright notice,
+/// this list of conditions and the following disclaimer in the documentation
+/// and/or other materials provided with the distribution.
+/// 3. Neither the name of the copyright holder nor the
+/// names of its contributors may be used to endorse or promote products
+/// derived from this software without specific prior written permission.
+///
+////////////////////////////////////////////////////////////////////////////////
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+/// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+/// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+/// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+/// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+/// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+/// POSSIBILITY OF SUCH DAMAGE.
+/// @endcond
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef NETWORK_FILTERS_H
+#define NETWORK_FILTERS_H
+
+#include <types.h>
+
+/*
+ * A filter table is stored in NVM as an APE user block in the code directory
+ * (BCM_CODE_DIRECTORY_CPU_APE, BCM_CODE_DIRECTORY_TYPE_USER_BLOCK). All words
+ * are stored big endian, followed by the usual code directory CRC word.
+ * The table is generated with bcmfilter and installed with bcmflash -f.
+ */
+#define NETWORK_FILTER_MAGIC   (0x46494C54u) /* 'FILT' */
+#define NETWORK_FILTER_VERSION (1u)
+
+#define NETWORK_FILTER_NUM_ELEMENTS (32u)
+#define NETWORK_FILTER_NUM_RULES    (31u) /* Rule sets S-1 through S-31 */
+
+/* The NC-SI filter commands control the elements and rule sets listed below. */
+#define NETWORK_FILTER_FLAG_NCSI (1u << 0)
+
+/* Elements and rule sets that are controlled by NC-SI commands. */
+#define FILTER_ELEMENT_VLAN             (19)
+#define FILTER_ELEMENT_IPV6_NA          (20)
+#define FILTER_ELEMENT_IPV6_RA          (21)
+#define FILTER_ELEMENT_DHCPV6           (22)
+
+#define FILTER_RULE_UNICAST_VLAN        (3)
+#define FILTER_RULE_UNICAST             (4)
+#define FILTER_RULE_BROADCAST_VLAN      (9)
+#define FILTER_RULE_BROADCAST_ARP       (10)
+#define FILTER_RULE_BROADCAST_DHCP_CLIENT   (11)
+#define FILTER_RULE_BROADCAST_DHCP_SERVER   (12)
+#define FILTER_RULE_BROADCAST_NETBIOS   (13)
+#define FILTER_RULE_BROADCAST           (14)
+#define FILTER_RULE_MULTICAST_VLAN      (18)
+#define FILTER_RULE_IPV6_NA             (28)
+#define FILTER_RULE_IPV6_RA             (29)
+#define FILTER_RULE_DHCPV6              (30)
+#define FILTER_RULE_MULTICAST           (31)
+
+#define FILTER_NCSI_ELEMENTS                                                                                                                                   \
+    ((1u << FILTER_ELEMENT_VLAN) | (1u << FILTER_ELEMENT_IPV6_NA) | (1u << FILTER_ELEMENT_IPV6_RA) | (1u << FILTER_ELEMENT_DHCPV6))
+
+#define FILTER_NCSI_RULES                                                                                                                                      \
+    ((1u << FILTER_RULE_UNICAST_VLAN) | (1u << FILTER_RULE_UNICAST) | (1u << FILTER_RULE_BROADCAST_VLAN) | (1u << FILTER_RULE_BROADCAST_ARP) |                 \
+     (1u << FILTER_RULE_BROADCAST_DHCP_CLIENT) | (1u << FILTER_RULE_BROADCAST_DHCP_SERVER) | (1u << FILTER_RULE_BROADCAST_NETBIOS) |                           \
+     (1u << FILTER_RULE_BROADCAST) | (1u << FILTER_RULE_MULTICAST_VLAN) | (1u << FILTER_RULE_IPV6_NA) | (1u << FILTER_RULE_IPV6_RA) |                          \
+     (1u << FILTER_RULE_DHCPV6) | (1u << FILTER_RULE_MULTICAST))
+
+typedef struct
+{
+    uint32_t magic;   /* NETWORK_FILTER_MAGIC */
+    uint32_t version; /* NETWORK_FILTER_VERSION */
+    uint32_t flags;   /* NETWORK_FILTER_FLAG_* */
+
+    uint32_t element_config[NETWORK_FILTER_NUM_ELEMENTS];  /* FILTERS.ElementConfig[n] */
+    uint32_t element_pattern[NETWORK_FILTER_NUM_ELEMENTS]; /* FILTERS.ElementPattern[n] */
+    uint32_t rule_set[NETWORK_FILTER_NUM_RULES];           /* FILTERS.RuleSet[n], rule set S-(n+1) */
+    uint32_t rule_mask[NETWORK_FILTER_NUM_RULES];          /* FILTERS.RuleMask[n], rule set S-(n+1) */
+} NetworkFilterTable_t;
+
+/* Table length in words, including the trailing CRC word. */
+#define NETWORK_FILTER_TABLE_WORDS ((sizeof(NetworkFilterTable_t) / sizeof(uint32_t)) + 1)
+
+bool Network_ReadFilterTable(NetworkFilterTable_t *table); /* Reads the table from NVM, the NVM lock must be held. */
+
+#endif /* NETWORK_FILTERS_H */
@@ -59,8 +59,14 @@
 #include <APE_TX_PORT1.h>
 #include <APE_TX_PORT2.h>
 #include <APE_TX_PORT3.h>
+#include <Ethernet.h>
 #include <MII.h>
+#include <NVRam.h>
 #include <Network.h>
+#include <NetworkCopy.h>
+#include <NetworkFilters.h>
+#include <Timer.h>
+#include <bcm5719_eeprom.h>
 
 #ifdef CXX_SIMULATOR
 #include <stdio.h>
@@ -93,6 +99,8 @@ NetworkPort_t gPort0 = {
         .r32 = 0,
     },
 #endif
+
+    .function = 0,
 };
 
 NetworkPort_t gPort1 = {
@@ -120,6 +128,8 @@ NetworkPort_t gPort1 = {
         .r32 = 0,
     },
 #endif
+
+    .function = 1,
 };
 
 NetworkPort_t gPort2 = {
@@ -147,6 +157,8 @@ NetworkPort_t gPort2 = {
         .r32 = APE_MODE_2_CHANNEL_0_ENABLE_MASK | APE_MODE_2_CHANNEL_2_ENABLE_MASK,
     },
 #endif
+
+    .function = 2,
 };
 
 NetworkPort_t gPort3 = {
@@ -174,6 +186,8 @@ NetworkPort_t gPort3 = {
         .r32 = APE_MODE_2_CHANNEL_1_ENABLE_MASK | APE_MODE_2_CHANNEL_3_ENABLE_MASK,
     },
 #endif
+
+    .function = 3,
 };
 
 NetworkPort_t *Network_getPort(int i)
@@ -192,6 +206,56 @@ NetworkPort_t *Network_getPort(int i)
             return &gPort3;
     }
 }
+
+#ifdef CXX_SIMULATOR
+/* NVRam_read leaves the words in NVM byte order on the host, decode them like stage1 does. */
+#define nvm_to_cpu(__x__) Network_swap32(__x__)
+#define crc_swap(__x__)   (__x__)
+#else
+/* The APE reads each NVM word most significant byte first. */
+#define nvm_to_cpu(__x__) (__x__)
+#define crc_swap(__x__)   Network_swap32(__x__)
+#endif
+
+bool Network_ReadFilterTable(NetworkFilterTable_t *table)
+{
+    NVRAMCodeDirectory_t directory[8];
+    uint32_t *words = (uint32_t *)table;
+    bool found = false;
+
+    NVRam_read(sizeof(NVRAMHeader_t), (uint32_t *)directory, ARRAY_ELEMENTS(directory) * (sizeof(NVRAMCodeDirectory_t) / sizeof(uint32_t)));
+
+    for (size_t i = 0; i < ARRAY_ELEMENTS(directory) && !found; i++)
+    {
+        uint32_t info = nvm_to_cpu(directory[i].codeInfo);
+        if (BCM_CODE_DIRECTORY_CPU_APE != BCM_CODE_DIRECTORY_GET_CPU(info) || BCM_CODE_DIRECTORY_TYPE_USER_BLOCK != BCM_CODE_DIRECTORY_GET_TYPE(info) ||
+            NETWORK_FILTER_TABLE_WORDS != BCM_CODE_DIRECTORY_GET_LENGTH(info))
+        {
+            continue;
+        }
+
+        uint32_t offset = nvm_to_cpu(directory[i].directoryOffset);
+        uint32_t crc_word;
+        NVRam_read(offset, words, NETWORK_FILTER_TABLE_WORDS - 1);
+        NVRam_read(offset + sizeof(*table), &crc_word, 1);
+
+        // The CRC covers the table bytes as stored in NVM, words are stored most significant byte first.
+        uint32_t crc = 0xffffffff;
+        for (size_t j = 0; j < NETWORK_FILTER_TABLE_WORDS - 1; j++)
+        {
+            words[j] = nvm_to_cpu(words[j]);
+
+            uint8_t bytes[4] = {(uint8_t)(words[j] >> 24), (uint8_t)(words[j] >> 16), (uint8_t)(words[j] >> 8), (uint8_t)words[j]};
+            crc = NVRam_crc(bytes, sizeof(bytes), crc);
+        }
+
+        // Like the other code directory entries, the CRC word itself is stored least significant byte first.
+        found = (crc_swap(crc_word) == ~crc) && (NETWORK_FILTER_MAGIC == table->magic) && (NETWORK_FILTER_VERSION == table->version);
+    }
+
+    return found;
+}
+
 #ifndef CXX_SIMULATOR
 typedef struct
 {
@@ -763,7 +827,7 @@ static const FilterRuleInit_t gRuleInit[32] = {
         .mask = {.r32 = 0x40200000},
     },
 
-    // S-30. ACTION=TO_APE_AND_HOST, COUNT=0, ENABLE=0, MASK=0x4020_0000.
+    // S-30. ACTION=TO_APE_AND_HOST, COUNT=0, ENABLE=0, MASK=0x4040_0000.
     [30] = {
         .set = {.bits = {
             .Action = FILTERS_RULE_SET_ACTION_TO_APE_AND_HOST,
@@ -772,7 +836,7 @@ static const FilterRuleInit_t gRuleInit[32] = {
             .reserved_30_19 = 0,
             .Enable = 0,
         }},
-        .mask = {.r32 = 0x40200000},
+        .mask = {.r32 = 0x40400000},
     },
 
     // S-31. ACTION=TO_APE_AND_HOST, COUNT=0, ENABLE=0, MASK=0x8000_0000.
@@ -787,6 +851,125 @@ static const FilterRuleInit_t gRuleInit[32] = {
         .mask = {.r32 = 0x80000000},
     },
 };
+
+#define FILTER_BIT(__index__, __enable__) ((__enable__) ? (1u << (__index__)) : 0)
+
+typedef struct
+{
+    uint32_t element_enable; /* Bit n enables element n */
+    uint32_t rule_enable;    /* Bit n enables rule set S-n */
+    uint32_t vlan_pattern;   /* Pattern for FILTER_ELEMENT_VLAN */
+} FilterProgram_t;
+
+/* Filter table in use, either loaded from NVM or built from the tables above. */
+static NetworkFilterTable_t gFilterTable;
+static bool gFilterTableLoaded;
+
+static void Network_DefaultFilterTable(NetworkFilterTable_t *table)
+{
+    table->magic = NETWORK_FILTER_MAGIC;
+    table->version = NETWORK_FILTER_VERSION;
+    table->flags = NETWORK_FILTER_FLAG_NCSI;
+    for (int i = 0; i < NETWORK_FILTER_NUM_ELEMENTS; i++)
+    {
+        table->element_config[i] = gElementInit[i].cfg.r32;
+        table->element_pattern[i] = gElementInit[i].pat.r32;
+    }
+    for (int i = 0; i < NETWORK_FILTER_NUM_RULES; i++)
+    {
+        table->rule_set[i] = gRuleInit[i + 1].set.r32;
+        table->rule_mask[i] = gRuleInit[i + 1].mask.r32;
+    }
+}
+
+static void Network_LoadFilterTable(void)
+{
+    if (gFilterTableLoaded)
+    {
+        return;
+    }
+
+    if (NVRam_acquireLock())
+    {
+        NVRam_enable();
+        if (Network_ReadFilterTable(&gFilterTable))
+        {
+            printf("Using NVM filter table (flags 0x%x)\n", gFilterTable.flags);
+        }
+        else
+        {
+            Network_DefaultFilterTable(&gFilterTable);
+        }
+        NVRam_releaseLock();
+
+        gFilterTableLoaded = true;
+    }
+    else
+    {
+        // NVM is busy, use the built in table and try again on the next update.
+        Network_DefaultFilterTable(&gFilterTable);
+    }
+}
+
+static void Network_CompileFilters(NetworkPort_t *port, FilterProgram_t *program)
+{
+    VOLATILE SHM_CHANNEL_t *shm = port->shm_channel;
+    RegSHM_CHANNELNcsiChannelInfo_t info = shm->NcsiChannelInfo;
+    RegSHM_CHANNELNcsiChannelBfilt_t bfilt = shm->NcsiChannelBfilt;
+    RegSHM_CHANNELNcsiChannelMfilt_t mfilt = shm->NcsiChannelMfilt;
+
+    program->element_enable = 0;
+    program->rule_enable = 0;
+    for (int i = 0; i < NETWORK_FILTER_NUM_ELEMENTS; i++)
+    {
+        program->element_enable |= FILTER_BIT(i, GET_FILTERS0_ELEMENT_CONFIG_RULE_ENABLE(gFilterTable.element_config[i]));
+    }
+    for (int i = 1; i <= NETWORK_FILTER_NUM_RULES; i++)
+    {
+        program->rule_enable |= FILTER_BIT(i, GET_FILTERS0_RULE_SET_ENABLE(gFilterTable.rule_set[i - 1]));
+    }
+    program->vlan_pattern = gFilterTable.element_pattern[FILTER_ELEMENT_VLAN];
+
+    if (!(gFilterTable.flags & NETWORK_FILTER_FLAG_NCSI))
+    {
+        // Custom table without the NC-SI slot layout, program it as is.
+        return;
+    }
+
+    // Broadcast filter disabled: forward all broadcasts, otherwise only the selected types.
+    bool all_broadcast = !info.bits.BFILT;
+    program->rule_enable &= ~(FILTER_BIT(FILTER_RULE_BROADCAST_VLAN, 1) | FILTER_BIT(FILTER_RULE_BROADCAST, 1) |
+                              FILTER_BIT(FILTER_RULE_BROADCAST_ARP, 1) | FILTER_BIT(FILTER_RULE_BROADCAST_DHCP_CLIENT, 1) |
+                              FILTER_BIT(FILTER_RULE_BROADCAST_DHCP_SERVER, 1) | FILTER_BIT(FILTER_RULE_BROADCAST_NETBIOS, 1));
+    program->rule_enable |= FILTER_BIT(FILTER_RULE_BROADCAST_VLAN, all_broadcast) | FILTER_BIT(FILTER_RULE_BROADCAST, all_broadcast) |
+                            FILTER_BIT(FILTER_RULE_BROADCAST_ARP, all_broadcast || bfilt.bits.ARPPacket) |
+                            FILTER_BIT(FILTER_RULE_BROADCAST_DHCP_CLIENT, all_broadcast || bfilt.bits.DHCPClientPacket) |
+                            FILTER_BIT(FILTER_RULE_BROADCAST_DHCP_SERVER, all_broadcast || bfilt.bits.DHCPServerPacket) |
+                            FILTER_BIT(FILTER_RULE_BROADCAST_NETBIOS, all_broadcast || bfilt.bits.NetBIOSPacket);
+
+    // Global multicast filter disabled: forward all multicasts, otherwise only the selected IPv6 types.
+    bool all_multicast = !info.bits.MFILT;
+    bool na = !all_multicast && mfilt.bits.IPv6NeighbourAdvertisement;
+    bool ra = !all_multicast && mfilt.bits.IPv6RouterAdvertisement;
+    bool dhcpv6 = !all_multicast && mfilt.bits.DHCPv6RelayandServerMulticast;
+    program->element_enable &= ~(FILTER_BIT(FILTER_ELEMENT_IPV6_NA, 1) | FILTER_BIT(FILTER_ELEMENT_IPV6_RA, 1) | FILTER_BIT(FILTER_ELEMENT_DHCPV6, 1));
+    program->element_enable |= FILTER_BIT(FILTER_ELEMENT_IPV6_NA, na) | FILTER_BIT(FILTER_ELEMENT_IPV6_RA, ra) | FILTER_BIT(FILTER_ELEMENT_DHCPV6, dhcpv6);
+    program->rule_enable &= ~(FILTER_BIT(FILTER_RULE_MULTICAST_VLAN, 1) | FILTER_BIT(FILTER_RULE_MULTICAST, 1) |
+                              FILTER_BIT(FILTER_RULE_IPV6_NA, 1) | FILTER_BIT(FILTER_RULE_IPV6_RA, 1) | FILTER_BIT(FILTER_RULE_DHCPV6, 1));
+    program->rule_enable |= FILTER_BIT(FILTER_RULE_MULTICAST_VLAN, all_multicast) | FILTER_BIT(FILTER_RULE_MULTICAST, all_multicast) |
+                            FILTER_BIT(FILTER_RULE_IPV6_NA, na) | FILTER_BIT(FILTER_RULE_IPV6_RA, ra) | FILTER_BIT(FILTER_RULE_DHCPV6, dhcpv6);
+
+    // VLAN: the VLAN element matches any tag unless a VLAN filter is in use.
+    bool vlan_only = false;
+    if (info.bits.VLAN && VLAN_MODE_ANY_VLAN_NON_VLAN != shm->NcsiChannelVlan.r32 && shm->NcsiChannelMac0VlanValid.r32)
+    {
+        // Value in the upper 16 bits, mask in the lower 16 bits. Only the VLAN ID is compared.
+        program->vlan_pattern = ((shm->NcsiChannelMac0Vlan.r32 & 0xFFF) << 16) | 0xFFF;
+        vlan_only = (VLAN_MODE_VLAN_ONLY == shm->NcsiChannelVlan.r32);
+    }
+    program->rule_enable &= ~(FILTER_BIT(FILTER_RULE_UNICAST_VLAN, 1) | FILTER_BIT(FILTER_RULE_UNICAST, 1));
+    program->rule_enable |= FILTER_BIT(FILTER_RULE_UNICAST_VLAN, 1) | FILTER_BIT(FILTER_RULE_UNICAST, !vlan_only);
+}
 #endif
 
 void Network_InitFilters(NetworkPort_t *port)
@@ -794,16 +977,49 @@ void Network_InitFilters(NetworkPort_t *port)
 #ifdef CXX_SIMULATOR
     (void)port;
 #else
-    for (int i = 0; i < 32; i++)
+    FilterProgram_t program;
+    Network_LoadFilterTable();
+    Network_CompileFilters(port, &program);
+
+    // Only touch registers that change so traffic matching unchanged rules is not disturbed.
+    for (int i = 0; i < NETWORK_FILTER_NUM_ELEMENTS; i++)
     {
-        port->filters->ElementConfig[i] = gElementInit[i].cfg;
-        port->filters->ElementPattern[i] = gElementInit[i].pat;
+        uint32_t cfg = gFilterTable.element_config[i] & ~FILTERS0_ELEMENT_CONFIG_RULE_ENABLE_MASK;
+        uint32_t pat = gFilterTable.element_pattern[i];
+        cfg |= SET_FILTERS0_ELEMENT_CONFIG_RULE_ENABLE((program.element_enable >> i) & 1);
+        if (FILTER_ELEMENT_VLAN == i)
+        {
+            pat = program.vlan_pattern;
+        }
+
+        if (port->filters->ElementPattern[i].r32 != pat)
+        {
+            port->filters->ElementPattern[i].r32 = pat;
+            port->reload_writes++;
+        }
+        if (port->filters->ElementConfig[i].r32 != cfg)
+        {
+            port->filters->ElementConfig[i].r32 = cfg;
+            port->reload_writes++;
+        }
     }
 
-    for (int i = 1; i < 32; i++)
+    for (int i = 1; i <= NETWORK_FILTER_NUM_RULES; i++)
     {
-        port->filters->RuleSet[i - 1] = gRuleInit[i].set;
-        port->filters->RuleMask[i - 1] = gRuleInit[i].mask;
+        uint32_t set = gFilterTable.rule_set[i - 1] & ~FILTERS0_RULE_SET_ENABLE_MASK;
+        uint32_t mask = gFilterTable.rule_mask[i - 1];
+        set |= SET_FILTERS0_RULE_SET_ENABLE((program.rule_enable >> i) & 1);
+
+        if (port->filters->RuleMask[i - 1].r32 != mask)
+        {
+            port->filters->RuleMask[i - 1].r32 = mask;
+            port->reload_writes++;
+        }
+        if (port->filters->RuleSet[i - 1].r32 != set)
+        {
+            port->filters->RuleSet[i - 1].r32 = set;
+            port->reload_writes++;
+        }
     }
 
     port->filters->RuleConfiguration.r32 = 0;
@@ -820,6 +1036,12 @@ void Network_resetTX(NetworkPort_t *port, reload_type_t reset_phy)
         *(port->tx_mode) = txMode;
     }
 
+    if (txMode.bits.Reset || !txMode.bits.Enable)
+    {
+        // Any cached blocks belong to the old pool.
+        Network_TX_flushBlocks(port);
+    }
+
     if (!txMode.bits.Enable)
     {
         txMode.bits.Reset = 0;
@@ -833,6 +1055,8 @@ void Network_resetRX(NetworkPort_t *port, reload_type_t reset_phy)
     RegAPERxPoolModeStatus_t rxMode = *port->rx_mode;
     if ((ALWAYS_RESET == reset_phy) || rxMode.bits.Error)
     {
+        Network_PassthroughRxAbort(port);
+
         // Enable RX
         rxMode.bits.Reset = 1;
         *(port->rx_mode) = rxMode;
@@ -863,94 +1087,67 @@ bool Network_checkEnableState(NetworkPort_t *port)
     return true;
 }
 
-void Network_InitPort(NetworkPort_t *port, reload_type_t reset_phy)
+/* Applies the shadow entry for __reg__, writing the register only when the hardware differs. */
+#define NETWORK_SHADOW_APPLY(__port__, __reg__)                                                                                                                \
+    do                                                                                                                                                         \
+    {                                                                                                                                                          \
+        uint32_t current = (__port__)->device->__reg__.r32;                                                                                                    \
+        uint32_t wanted = (current & ~(__port__)->shadow.__reg__.clear) | (__port__)->shadow.__reg__.set;                                                      \
+        if (current != wanted)                                                                                                                                 \
+        {                                                                                                                                                      \
+            (__port__)->device->__reg__.r32 = wanted;                                                                                                          \
+            (__port__)->reload_writes++;                                                                                                                       \
+        }                                                                                                                                                      \
+    } while (0)
+
+static void Network_InitShadow(NetworkPortShadow_t *shadow)
 {
-    RegMIIStatus_t stat;
-    RegMIIIeeeExtendedStatus_t ext_stat;
-    RegSHM_CHANNELNcsiChannelStatus_t linkStatus;
-    uint8_t phy = MII_getPhy(port->device);
-
-    if ((ALWAYS_RESET == reset_phy) || (AS_NEEDED == reset_phy && !Network_isLinkUp(port)))
-    {
-        APE_aquireLock();
-        MII_reset(port->device, phy);
-        APE_releaseLock();
-    }
-    else
-    {
-        bool updated;
-
-        // Ensure the PHY is advertising all capabilities and updating if needed.
-        APE_aquireLock();
-        updated = MII_UpdateAdvertisement(port->device, phy);
-        APE_releaseLock();
-
-        if (updated)
-        {
-            printf("Advert updated\n");
-        }
-    }
-
     // 1000Mb/s mode only works if D0u is 0 when the host is off.
     // Note: Per ortega, this should possibly tansition between 0 and  6.25MHz depending on the power / clock states for power consumption reasons.
-    port->device->D0uClockPolicy.r32 = 0;
-
-    Network_InitFilters(port);
-
-    Network_resetTX(port, reset_phy);
-    Network_resetRX(port, reset_phy);
-
-    APE.Mode.r32 |= port->APEModeEnable.r32;
-    APE.Mode2.r32 |= port->APEMode2Enable.r32;
+    // See Network_setPowerProfile.
+    shadow->D0uClockPolicy.clear = ~0u;
+    shadow->D0uClockPolicy.set = 0;
 
     // Ensure REG_RECEIVE_MAC_MODE has ENABLE set.
     // I recommend also setting APE_PROMISCUOUS_MODE and PROMISCUOUS_MODE,
     // as these will cause you less headaches during development.
     RegDEVICEReceiveMacMode_t macMode;
-    macMode = port->device->ReceiveMacMode;
+    macMode.r32 = 0;
     macMode.bits.Enable = 1;
+    shadow->ReceiveMacMode.set = macMode.r32;
     // When set, allows APE to RX without having to reset the network configuration after a power off
     // When set, can cause the network to APE hardware blocks to lock up when the host is activly using the interface, so set to 0.
-    macMode.bits.APEPromiscuousMode = 0;
-    if (port->device->ReceiveMacMode.r32 != macMode.r32)
-    {
-        port->device->ReceiveMacMode = macMode;
-    }
+    macMode.bits.APEPromiscuousMode = 1;
+    shadow->ReceiveMacMode.clear = macMode.r32;
 
     // Enable RX/TX
     RegDEVICETransmitMacMode_t txMacMode;
-    txMacMode = port->device->TransmitMacMode;
+    txMacMode.r32 = 0;
     txMacMode.bits.EnableTDE = 1;
     // txMacMode.bits.EnableFlowControl = 1;
-    if (port->device->TransmitMacMode.r32 != txMacMode.r32)
-    {
-        port->device->TransmitMacMode = txMacMode;
-    }
+    shadow->TransmitMacMode.set = txMacMode.r32;
+    shadow->TransmitMacMode.clear = txMacMode.r32;
 
     RegDEVICEEeeMode_t eeeMode;
-    eeeMode = port->device->EeeMode;
+    eeeMode.r32 = 0;
     eeeMode.bits.APETXDetectionEnable = 1;
     eeeMode.bits.EEELinkIdleDetectionEnable = 1;
     eeeMode.bits.SendIndexDetectionEnable = 1;
     eeeMode.bits.TXLPIEnable = 1;
     eeeMode.bits.RXLPIEnable = 1;
-    if (port->device->EeeMode.r32 != eeeMode.r32)
-    {
-        port->device->EeeMode = eeeMode;
-    }
+    shadow->EeeMode.set = eeeMode.r32;
+    shadow->EeeMode.clear = eeeMode.r32;
 
     RegDEVICEBufferManagerMode_t bmm;
     bmm.r32 = 0;
     bmm.bits.Enable = 1;
     bmm.bits.AttentionEnable = 1;
     bmm.bits.ResetRXMBUFPointer = 1;
-    if (port->device->BufferManagerMode.r32 != bmm.r32)
-    {
-        port->device->BufferManagerMode = bmm;
-    }
+    shadow->BufferManagerMode.set = bmm.r32;
+    shadow->BufferManagerMode.clear = ~0u;
 
     RegDEVICEEmacMode_t emacMode;
-    emacMode = port->device->EmacMode;
+    emacMode.r32 = 0;
     emacMode.bits.EnableAPERXPath = 1;
     emacMode.bits.EnableAPETXPath = 1;
 
@@ -959,41 +1156,165 @@ void Network_InitPort(NetworkPort_t *port, reload_type_t reset_phy)
     emacMode.bits.EnableRDE = 1;
 
     emacMode.bits.KeepFrameInWOL = 1;
-    emacMode.bits.MACLoopbackModeControl = 0;
-    if (port->device->EmacMode.r32 != emacMode.r32)
-    {
-        port->device->EmacMode = emacMode;
-    }
+    shadow->EmacMode.set = emacMode.r32;
+    shadow->EmacMode.clear = emacMode.r32 | DEVICE_EMAC_MODE_MAC_LOOPBACK_MODE_CONTROL_MASK;
+
+    shadow->TransmitMacLengths.set = SET_DEVICE_TRANSMIT_MAC_LENGTHS_SLOT_TIME_LENGTH(0x20) | SET_DEVICE_TRANSMIT_MAC_LENGTHS_IPG_LENGTH(0x6) |
+                                     SET_DEVICE_TRANSMIT_MAC_LENGTHS_IPG_CRS_LENGTH(0x2);
+    shadow->TransmitMacLengths.clear = DEVICE_TRANSMIT_MAC_LENGTHS_SLOT_TIME_LENGTH_MASK | DEVICE_TRANSMIT_MAC_LENGTHS_IPG_LENGTH_MASK |
+                                       DEVICE_TRANSMIT_MAC_LENGTHS_IPG_CRS_LENGTH_MASK;
+
+    RegDEVICEMiscellaneousConfig_t misc;
+    misc.r32 = 0;
+    misc.bits.DisableGRCReset = 1;
+    shadow->MiscellaneousConfig.set = misc.r32;
+    shadow->MiscellaneousConfig.clear = misc.r32;
 
-    RegDEVICETransmitMacLengths_t txMacLengths;
-    txMacLengths = port->device->TransmitMacLengths;
-    txMacLengths.bits.SlotTimeLength = 0x20;
-    txMacLengths.bits.IPGLength = 0x6;
-    txMacLengths.bits.IPGCRSLength = 0x2;
-    port->device->TransmitMacLengths = txMacLengths;
+    shadow->LinkAwarePowerModeClockPolicy.set =
+        SET_DEVICE_LINK_AWARE_POWER_MODE_CLOCK_POLICY_MAC_CLOCK_SWITCH(DEVICE_LINK_AWARE_POWER_MODE_CLOCK_POLICY_MAC_CLOCK_SWITCH_6_25MHZ);
+    shadow->LinkAwarePowerModeClockPolicy.clear = DEVICE_LINK_AWARE_POWER_MODE_CLOCK_POLICY_MAC_CLOCK_SWITCH_MASK;
 
-    port->device->MiscellaneousConfig.bits.DisableGRCReset = 1;
-    port->device->LinkAwarePowerModeClockPolicy.bits.MACClockSwitch = DEVICE_LINK_AWARE_POWER_MODE_CLOCK_POLICY_MAC_CLOCK_SWITCH_6_25MHZ;
-    port->device->ClockSpeedOverridePolicy.r32 = 0;
+    shadow->ClockSpeedOverridePolicy.set = 0;
+    shadow->ClockSpeedOverridePolicy.clear = ~0u;
 
     RegDEVICECpmuControl_t cmm;
-    cmm = port->device->CpmuControl;
+    cmm.r32 = 0;
     cmm.bits.LinkIdlePowerModeEnable = 1;
     cmm.bits.LinkAwarePowerModeEnable = 1;
     cmm.bits.LinkSpeedPowerModeEnable = 1;
-    if (port->device->CpmuControl.r32 != cmm.r32)
+    shadow->CpmuControl.set = cmm.r32;
+    shadow->CpmuControl.clear = cmm.r32;
+
+    // EmacMode always enables FHDE and RDE above, which need the receive list placement.
+    RegDEVICEReceiveListPlacementMode_t rlp;
+    rlp.r32 = 0;
+    rlp.bits.Enable = 1;
+    shadow->ReceiveListPlacementMode.set = rlp.r32;
+    shadow->ReceiveListPlacementMode.clear = rlp.r32;
+
+    RegDEVICEGrcModeControl_t grcMode;
+    grcMode.r32 = 0;
+    grcMode.bits.HostStackUp = 1; // Enable packet RX
+    shadow->GrcModeControl.set = grcMode.r32;
+    shadow->GrcModeControl.clear = grcMode.r32;
+
+    shadow->valid = true;
+}
+
+void Network_setPowerProfile(NetworkPort_t *port, network_power_profile_t profile)
+{
+    if (!port->shadow.valid)
     {
-        port->device->CpmuControl = cmm;
+        Network_InitShadow(&port->shadow);
     }
 
-    if (port->device->EmacMode.bits.EnableFHDE || port->device->EmacMode.bits.EnableRDE)
+    // LPI saves power while the link is idle, but every frame sent after a quiet period waits for the LPI exit time.
+    RegDEVICEEeeMode_t eeeMode;
+    eeeMode.r32 = 0;
+    eeeMode.bits.TXLPIEnable = 1;
+    eeeMode.bits.RXLPIEnable = 1;
+    if (NETWORK_POWER_ACTIVE == profile)
     {
-        port->device->ReceiveListPlacementMode.bits.Enable = 1;
+        port->shadow.EeeMode.set &= ~eeeMode.r32;
+    }
+    else
+    {
+        port->shadow.EeeMode.set |= eeeMode.r32;
+    }
+
+    // 1000Mb/s mode only works if D0u is 0 when the host is off, the caller must only select the slower clock below that.
+    if (NETWORK_POWER_DEEP == profile)
+    {
+        port->shadow.D0uClockPolicy.set = SET_DEVICE_D0U_CLOCK_POLICY_MAC_CLOCK_SWITCH(DEVICE_D0U_CLOCK_POLICY_MAC_CLOCK_SWITCH_6_25MHZ);
+    }
+    else
+    {
+        port->shadow.D0uClockPolicy.set = 0;
     }
 
-    port->device->GrcModeControl.bits.HostStackUp = 1; // Enable packet RX
+    NETWORK_SHADOW_APPLY(port, D0uClockPolicy);
+    NETWORK_SHADOW_APPLY(port, EeeMode);
+}
 
-    APE_aquireLock();
+uint8_t Network_getPhy(NetworkPort_t *port)
+{
+    if (!port->phy)
+    {
+        // Function number and media selection are fixed by the straps, PHY address 0 is never used by a port.
+        port->phy = MII_getPhy(port->device);
+    }
+
+    return port->phy;
+}
+
+static void Network_updateMdioCacheStats(NetworkPort_t *port)
+{
+    uint8_t phy = Network_getPhy(port);
+
+    port->shm_channel->NcsiChannelMdioCacheHits.r32 = MII_getCacheHits(phy);
+    port->shm_channel->NcsiChannelMdioCacheMisses.r32 = MII_getCacheMisses(phy);
+}
+
+void Network_InitPort(NetworkPort_t *port, reload_type_t reset_phy)
+{
+    RegMIIStatus_t stat;
+    RegMIIIeeeExtendedStatus_t ext_stat;
+    RegSHM_CHANNELNcsiChannelStatus_t linkStatus;
+    uint8_t phy = Network_getPhy(port);
+    uint32_t start = Timer_getCurrentTime1MHz();
+
+    port->reload_writes = 0;
+    if (!port->shadow.valid)
+    {
+        Network_InitShadow(&port->shadow);
+    }
+
+    if ((ALWAYS_RESET == reset_phy) || (AS_NEEDED == reset_phy && !Network_isLinkUp(port)))
+    {
+        APE_aquireLock(port->function);
+        MII_reset(port->device, phy);
+        APE_releaseLock(port->function);
+    }
+    else
+    {
+        bool updated;
+
+        // Ensure the PHY is advertising all capabilities and updating if needed.
+        APE_aquireLock(port->function);
+        updated = MII_UpdateAdvertisement(port->device, phy);
+        APE_releaseLock(port->function);
+
+        if (updated)
+        {
+            printf("Advert updated\n");
+        }
+    }
+
+    NETWORK_SHADOW_APPLY(port, D0uClockPolicy);
+
+    Network_InitFilters(port);
+
+    Network_resetTX(port, reset_phy);
+    Network_resetRX(port, reset_phy);
+
+    APE.Mode.r32 |= port->APEModeEnable.r32;
+    APE.Mode2.r32 |= port->APEMode2Enable.r32;
+
+    // Remaining port configuration, in the order the registers were always programmed.
+    NETWORK_SHADOW_APPLY(port, ReceiveMacMode);
+    NETWORK_SHADOW_APPLY(port, TransmitMacMode);
+    NETWORK_SHADOW_APPLY(port, EeeMode);
+    NETWORK_SHADOW_APPLY(port, BufferManagerMode);
+    NETWORK_SHADOW_APPLY(port, EmacMode);
+    NETWORK_SHADOW_APPLY(port, TransmitMacLengths);
+    NETWORK_SHADOW_APPLY(port, MiscellaneousConfig);
+    NETWORK_SHADOW_APPLY(port, LinkAwarePowerModeClockPolicy);
+    NETWORK_SHADOW_APPLY(port, ClockSpeedOverridePolicy);
+    NETWORK_SHADOW_APPLY(port, CpmuControl);
+    NETWORK_SHADOW_APPLY(port, ReceiveListPlacementMode);
+    NETWORK_SHADOW_APPLY(port, GrcModeControl);
+
+    APE_aquireLock(port->function);
 
     Network_updatePortState(port);
 
@@ -1005,7 +1326,7 @@ void Network_InitPort(NetworkPort_t *port, reload_type_t reset_phy)
         ext_stat.r16 = ext_status_value;
     }
 
-    APE_releaseLock();
+    APE_releaseLock(port->function);
 
     // Set link status capabilities.
     linkStatus.r32 = 0;
@@ -1020,10 +1341,80 @@ void Network_InitPort(NetworkPort_t *port, reload_type_t reset_phy)
     linkStatus.bits.LinkSpeed10M_THalfDuplexCapable = stat.bits._10BASE_THalfDuplexCapable;
 
     port->shm_channel->NcsiChannelStatus = linkStatus;
+
+    uint32_t elapsed = Timer_getCurrentTime1MHz() - start;
+    port->shm_channel->NcsiChannelReloadTime.r32 = elapsed;
+    port->shm_channel->NcsiChannelReloadWrites.r32 = port->reload_writes;
+    if (elapsed > port->shm_channel->NcsiChannelReloadMaxTime.r32)
+    {
+        port->shm_channel->NcsiChannelReloadMaxTime.r32 = elapsed;
+    }
+
+    Network_updateMdioCacheStats(port);
+}
+
+static uint32_t Network_getLinkDownBucket(uint32_t duration)
+{
+    uint32_t bucket = 0;
+    uint32_t limit = NETWORK_LINK_DOWN_BUCKET_MS;
+
+    while (bucket < (NETWORK_LINK_DOWN_BUCKETS - 1) && duration >= limit)
+    {
+        bucket++;
+        limit *= 4;
+    }
+
+    return bucket;
 }
 
-void Network_checkPortState(NetworkPort_t *port)
+static void Network_trackLinkState(NetworkPort_t *port, bool linkup, uint32_t now)
 {
+    if (!linkup)
+    {
+        if (!port->link_down_time)
+        {
+            port->link_down_time = now;
+            if (!port->link_down_time)
+            {
+                // We use 0 to mean that the link is up. Make sure this value is never 0.
+                port->link_down_time--;
+            }
+            ++port->shm_channel->NcsiChannelLinkDown.r32;
+        }
+    }
+    else if (port->link_down_time)
+    {
+        uint32_t duration = now - port->link_down_time;
+        port->link_down_time = 0;
+
+        ++port->shm_channel->NcsiChannelLinkDownHistogram[Network_getLinkDownBucket(duration)].r32;
+        if (duration > port->shm_channel->NcsiChannelLinkDownMaxTime.r32)
+        {
+            port->shm_channel->NcsiChannelLinkDownMaxTime.r32 = duration;
+        }
+
+        // Start from the cheapest step the next time the link drops.
+        port->link_recovery_stage = NETWORK_RECOVERY_NONE;
+        port->link_recovery_backoff = 0;
+    }
+}
+
+static inline void Network_cacheLinkStatus(NetworkPort_t *port, uint16_t status)
+{
+    RegMIIAuxiliaryStatusSummary_t summary;
+    summary.r16 = status;
+
+    port->link_status = status;
+    port->link_status_time = Timer_getCurrentTime1KHz();
+    port->link_status_valid = true;
+
+    Network_trackLinkState(port, summary.bits.LinkStatus, port->link_status_time);
+}
+
+bool Network_checkPortState(NetworkPort_t *port)
+{
+    bool updated = false;
+
     if (port->device->EmacStatus.bits.LinkStateChanged)
     {
         if (!port->link_state_printed)
@@ -1032,8 +1423,15 @@ void Network_checkPortState(NetworkPort_t *port)
             port->link_state_printed = true;
         }
 
+        // The PHY may have been reset or renegotiated by the host.
+        MII_invalidateCache(Network_getPhy(port));
+
         // Update state to match latest.
-        if (Network_updatePortState(port))
+        APE_aquireLock(port->function);
+        bool changed = Network_updatePortState(port);
+        APE_releaseLock(port->function);
+
+        if (changed)
         {
             RegDEVICEEmacStatus_t clearState;
             clearState.r32 = 0;
@@ -1045,13 +1443,18 @@ void Network_checkPortState(NetworkPort_t *port)
 
             printf("Link Status Updated\n");
             port->link_state_printed = false;
+            updated = true;
+
+            Network_updateMdioCacheStats(port);
         }
     }
+
+    return updated;
 }
 
 bool Network_updatePortState(NetworkPort_t *port)
 {
-    uint8_t phy = MII_getPhy(port->device);
+    uint8_t phy = Network_getPhy(port);
     RegMIIAuxiliaryStatusSummary_t status;
     RegMIIControl_t control;
     bool updated = false;
@@ -1060,10 +1463,13 @@ bool Network_updatePortState(NetworkPort_t *port)
     if (control.bits.RestartAutonegotiation)
     {
         // Link down, negotiation restarting, don't update mac mode.
+        Network_invalidateLinkStatus(port);
     }
     else
     {
         status.r16 = MII_readRegister(port->device, phy, (mii_reg_t)REG_MII_AUXILIARY_STATUS_SUMMARY);
+        Network_cacheLinkStatus(port, status.r16);
+
         if (control.bits.AutoNegotiationEnable && !status.bits.AutoNegotiationComplete)
         {
             // Link down, attempting to negotiate, don't update mac mode.
@@ -1160,22 +1566,180 @@ bool Network_updatePortState(NetworkPort_t *port)
     return updated;
 }
 
+static void Network_resetLinkComplete(mii_reset_t *reset)
+{
+    NetworkPort_t *port = (NetworkPort_t *)reset->context;
+
+    APE_releaseLock(port->function);
+
+    port->link_resetting = false;
+    Network_invalidateLinkStatus(port);
+
+    // Give the PHY time to bring the link up before taking the next recovery step.
+    port->link_recovery_time = Timer_getCurrentTime1KHz();
+
+    if (!reset->success)
+    {
+        if (MII_RESET_STATE_POLL == reset->state)
+        {
+            // The reset bit never cleared, keep backing off in case the PHY is absent.
+            printf("PHY reset timeout\n");
+        }
+        else
+        {
+            if (MII_RESET_STATE_RESET == reset->state)
+            {
+                printf("PHY reset failed\n");
+            }
+
+            // Nothing changed on the PHY, there is no point waiting for it.
+            port->link_recovery_backoff = 0;
+        }
+    }
+}
+
+static uint8_t Network_beginLinkReset(NetworkPort_t *port, uint32_t backoff)
+{
+    // The PHY lock is held for the whole sequence, as it was when the reset was done synchronously.
+    APE_aquireLock(port->function);
+
+    port->link_resetting = true;
+    port->link_recovery_backoff = backoff;
+    Network_invalidateLinkStatus(port);
+
+    return Network_getPhy(port);
+}
+
 void Network_resetLink(NetworkPort_t *port)
 {
-    uint8_t phy = MII_getPhy(port->device);
-    APE_aquireLock();
-    MII_reset(port->device, phy);
-    APE_releaseLock();
+    if (port->link_resetting)
+    {
+        // Already queued.
+        return;
+    }
+
+    uint8_t phy = Network_beginLinkReset(port, NETWORK_RECOVERY_RESET_MS);
+    MII_startReset(&port->phy_reset, port->device, phy, Network_resetLinkComplete, port);
+}
+
+void Network_abortLinkReset(NetworkPort_t *port)
+{
+    if (port->link_resetting)
+    {
+        port->link_resetting = false;
+        Network_invalidateLinkStatus(port);
+    }
+}
+
+void Network_recoverLink(NetworkPort_t *port)
+{
+    uint8_t phy;
+
+    if (port->link_resetting || !Timer_didTimeElapsed1KHz(port->link_recovery_time, port->link_recovery_backoff))
+    {
+        // The previous step is still in progress or may yet bring the link up.
+        return;
+    }
+
+    switch (port->link_recovery_stage)
+    {
+        case NETWORK_RECOVERY_NONE:
+            printf("Restarting autonegotiation.\n");
+            ++port->shm_channel->NcsiChannelLinkRestarts.r32;
+            port->link_recovery_stage = NETWORK_RECOVERY_RESTART;
+
+            phy = Network_beginLinkReset(port, NETWORK_RECOVERY_RESTART_MS);
+            MII_startRestart(&port->phy_reset, port->device, phy, Network_resetLinkComplete, port);
+            break;
+
+        case NETWORK_RECOVERY_RESTART:
+            printf("Updating advertisement.\n");
+            ++port->shm_channel->NcsiChannelLinkReadvertise.r32;
+            port->link_recovery_stage = NETWORK_RECOVERY_ADVERTISE;
+
+            phy = Network_beginLinkReset(port, NETWORK_RECOVERY_RESTART_MS);
+            MII_startAdvertise(&port->phy_reset, port->device, phy, Network_resetLinkComplete, port);
+            break;
+
+        case NETWORK_RECOVERY_ADVERTISE:
+            printf("Resetting link.\n");
+            ++port->shm_channel->NcsiChannelLinkResets.r32;
+            port->link_recovery_stage = NETWORK_RECOVERY_RESET;
+
+            phy = Network_beginLinkReset(port, NETWORK_RECOVERY_RESET_MS);
+            MII_startReset(&port->phy_reset, port->device, phy, Network_resetLinkComplete, port);
+            break;
+
+        default:
+        case NETWORK_RECOVERY_RESET:
+        {
+            // Keep resetting, but back off so a link that is never coming back doesn't keep the PHY busy.
+            uint32_t backoff = port->link_recovery_backoff ? port->link_recovery_backoff * 2 : NETWORK_RECOVERY_RESET_MS;
+            if (backoff > NETWORK_RECOVERY_MAX_BACKOFF_MS)
+            {
+                backoff = NETWORK_RECOVERY_MAX_BACKOFF_MS;
+            }
+
+            printf("Resetting link.\n");
+            ++port->shm_channel->NcsiChannelLinkResets.r32;
+
+            phy = Network_beginLinkReset(port, backoff);
+            MII_startReset(&port->phy_reset, port->device, phy, Network_resetLinkComplete, port);
+            break;
+        }
+    }
+}
+
+void Network_invalidateLinkStatus(NetworkPort_t *port)
+{
+    port->link_status_valid = false;
+}
+
+int32_t Network_getLinkStatus(NetworkPort_t *port)
+{
+    if (port->link_status_valid && !Timer_didTimeElapsed1KHz(port->link_status_time, NETWORK_LINK_STATUS_MAX_AGE_MS))
+    {
+        // Kept up to date by the link change handler, no need to touch the MDIO bus.
+        return port->link_status;
+    }
+
+    if (port->link_resetting)
+    {
+        // The link is down until the PHY reset completes, don't wait behind the queued reset.
+        return 0;
+    }
+
+    uint8_t phy = Network_getPhy(port);
+    APE_aquireLock(port->function);
+    int32_t reg = MII_readRegister(port->device, phy, (mii_reg_t)REG_MII_AUXILIARY_STATUS_SUMMARY);
+    APE_releaseLock(port->function);
+
+    if (reg >= 0)
+    {
+        Network_cacheLinkStatus(port, (uint16_t)reg);
+    }
+
+    return reg;
 }
 
 bool Network_isLinkUp(NetworkPort_t *port)
 {
-    uint8_t phy = MII_getPhy(port->device);
+    uint8_t phy = Network_getPhy(port);
     RegMIIAuxiliaryStatusSummary_t status;
     RegMIIControl_t control;
     bool linkup;
 
+    if (port->link_resetting)
+    {
+        // PHY reset queued, link not yet up, but in progress
+        return true;
+    }
+
+    APE_aquireLock(port->function);
     control.r16 = MII_readRegister(port->device, phy, (mii_reg_t)REG_MII_CONTROL);
+    status.r16 = MII_readRegister(port->device, phy, (mii_reg_t)REG_MII_AUXILIARY_STATUS_SUMMARY);
+    APE_releaseLock(port->function);
+
     if (control.bits.RestartAutonegotiation)
     {
         // Renegotiating, link not yet up, but in progress
@@ -1183,7 +1747,6 @@ bool Network_isLinkUp(NetworkPort_t *port)
     }
     else
     {
-        status.r16 = MII_readRegister(port->device, phy, (mii_reg_t)REG_MII_AUXILIARY_STATUS_SUMMARY);
         if (control.bits.AutoNegotiationEnable && !status.bits.AutoNegotiationComplete)
         {
             // Renegotiating, link not yet up, but in progress
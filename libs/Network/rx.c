@@ -129,142 +129,281 @@ bool Network_RxLePatcket(uint32_t *buffer, uint32_t *bytes, NetworkPort_t *port)
     }
 }
 
-bool Network_PassthroughRxPatcket(NetworkPort_t *port)
+// Port whose frame is partially written to the RMU TX fifo. Nothing else may
+// be written to the fifo until that frame has been completed or aborted.
+static NetworkPort_t *gPassthroughPort;
+
+// Largest block range a single RxPoolRetire write can describe.
+#define RX_RETIRE_MAX_BLOCKS (APE_RX_POOL_RETIRE_0_COUNT_MASK >> APE_RX_POOL_RETIRE_0_COUNT_SHIFT)
+
+static inline void Network_PassthroughRxRetire(NetworkPort_t *port, uint32_t head, uint32_t tail, uint32_t count)
 {
-    RegAPERxbufoffset_t rxbuf;
-    rxbuf = *((RegAPERxbufoffset_t *)port->rx_offset);
-    if ((int)rxbuf.bits.Valid)
+    RegAPERxPoolRetire_t retire;
+    retire.r32 = (1 << 24);
+    retire.bits.Count = count;
+    retire.bits.Head = head;
+    retire.bits.Tail = tail;
+    *((RegAPERxPoolRetire_t *)port->rx_retire) = retire;
+}
+
+static void Network_PassthroughRxDrop(NetworkPort_t *port, bool retire)
+{
+    if (retire)
     {
-        port->network_resetting = false;
+        // Drop all blocks that remain, following the chain and batching as Network_PassthroughRxSend does.
+        RegAPERxbufoffset_t rxbuf;
+        rxbuf.r32 = port->passthrough_rxbuf;
+        uint32_t head = port->passthrough_retire_count ? port->passthrough_retire : port->passthrough_block;
+        uint32_t block = head;
+        uint32_t count = 0;
+        uint32_t remaining = NETWORK_RX_MAX_BLOCKS;
 
-#if CXX_SIMULATOR
-        rxbuf.print();
-#endif
+        for (;;)
+        {
+            network_control_t control;
+            control.r32 = port->rx_port->In[RX_PORT_IN_ALL_BLOCK_WORDS * block].r32;
+            count++;
 
-        VOLATILE RX_PORT_t *rx_port = port->rx_port;
-        network_control_t control;
-        int count = rxbuf.bits.Count;
-        // int tailid = rxbuf.bits.Tail;
-        int blockid = rxbuf.bits.Head;
+            if (block == rxbuf.bits.Tail || !control.bits.not_last || !--remaining)
+            {
+                Network_PassthroughRxRetire(port, head, block, count);
+                break;
+            }
 
-        RegAPERxPoolRetire_t retire;
-        retire.r32 = (1 << 24);
-        retire.bits.Count = 1;
+            if (RX_RETIRE_MAX_BLOCKS == count)
+            {
+                Network_PassthroughRxRetire(port, head, block, count);
+                head = control.bits.next_block;
+                count = 0;
+            }
 
-        while (count--)
-        {
-            // printf("Block at %x\n", blockid);
-            RegRX_PORTIn_t *block = (RegRX_PORTIn_t *)&rx_port->In[RX_PORT_IN_ALL_BLOCK_WORDS * blockid];
-            // printf("Control %x\n", (uint32_t)block[0].r32);
-            control.r32 = block[0].r32;
-            // printf(" Payload Len %d\n", control.bits.payload_length);
-            // printf(" Next Block %d\n", control.bits.next_block);
-            // printf(" First %d\n", control.bits.first);
-            // printf(" Not Last %d\n", control.bits.not_last);
+            block = control.bits.next_block;
+        }
+
+        rxbuf.bits.Finished = 1;
+        *((RegAPERxbufoffset_t *)port->rx_offset) = rxbuf;
+    }
+
+    if (gPassthroughPort == port)
+    {
+        // Tell the hardware that there are no more bytes to send.
+        APE_PERI.BmcToNcTxBufferLast.r32 = 0;
+        gPassthroughPort = NULL;
+    }
+
+    port->passthrough_blocks = 0;
+    port->passthrough_retire_count = 0;
+
+    ++port->shm_channel->NcsiChannelNetworkDropped.r32;
+}
+
+// Copies as much of the frame in progress to the RMU as the fifo allows.
+// With wait set, spins for fifo space instead of yielding.
+static passthrough_status_t Network_PassthroughRxSend(NetworkPort_t *port, bool wait)
+{
+    VOLATILE RX_PORT_t *rx_port = port->rx_port;
+    network_control_t control;
+    uint32_t space = APE_PERI.BmcToNcTxStatus.bits.InFifo;
+
+    while (port->passthrough_blocks)
+    {
+        RegRX_PORTIn_t *block = (RegRX_PORTIn_t *)&rx_port->In[RX_PORT_IN_ALL_BLOCK_WORDS * port->passthrough_block];
+        control.r32 = block[0].r32;
 #if CXX_SIMULATOR
-            printf("%d bytes in block.\n", control.bits.payload_length);
+        printf("%d bytes in block.\n", control.bits.payload_length);
 #endif
-            int i;
-            int32_t offset;
-            int32_t words = DIVIDE_RND_UP(control.bits.payload_length, sizeof(uint32_t));
+        int32_t offset;
+        uint32_t bytes = control.bits.payload_length;
+        bool close;
 
-            if (control.bits.first)
+        if (control.bits.first)
+        {
+            offset = RX_PORT_IN_ALL_FIRST_PAYLOAD_WORD;
+        }
+        else
+        {
+            offset = RX_PORT_IN_ALL_ADDITIONAL_PAYLOAD_WORD;
+        }
+
+        // Drop the FCS. When the last block holds nothing but FCS bytes, the frame is closed on the block before it.
+        if (!control.bits.not_last)
+        {
+            if (bytes > ETHERNET_FCS_LENGTH)
             {
-                offset = RX_PORT_IN_ALL_FIRST_PAYLOAD_WORD;
+                bytes -= ETHERNET_FCS_LENGTH;
+                close = true;
             }
             else
             {
-                offset = RX_PORT_IN_ALL_ADDITIONAL_PAYLOAD_WORD;
+                // Already closed, unless this is the only block.
+                bytes = 0;
+                close = control.bits.first;
             }
+        }
+        else
+        {
+            network_control_t next;
+            next.r32 = rx_port->In[RX_PORT_IN_ALL_BLOCK_WORDS * control.bits.next_block].r32;
 
-            if (!control.bits.not_last)
+            close = !next.bits.not_last && next.bits.payload_length <= ETHERNET_FCS_LENGTH;
+            if (close)
             {
-                // Ignore last word - drop the FCS
-                words--;
+                bytes -= ETHERNET_FCS_LENGTH - next.bits.payload_length;
             }
+        }
 
-            if (control.bits.first && APE_PERI.BmcToNcTxStatus.bits.InFifo < words)
+        uint32_t words = DIVIDE_RND_UP(bytes, sizeof(uint32_t));
+
+        if (!gPassthroughPort)
+        {
+            if (space < words)
             {
-                // Not enough space in the fifo.
+                // Not enough space in the fifo for the first block.
                 // Exit and check back next loop - after the network has been reset if needed.
-                return false;
+                ++port->shm_channel->NcsiChannelNetworkDeferred.r32;
+                return PASSTHROUGH_DEFERRED;
             }
-            else
+
+            gPassthroughPort = port;
+        }
+
+        if (close && 0 == port->passthrough_word)
+        {
+            RegAPE_PERIBmcToNcTxControl_t ctrl;
+            ctrl.r32 = 0;
+            ctrl.bits.LastByteCount = bytes % sizeof(uint32_t);
+            APE_PERI.BmcToNcTxControl.r32 = ctrl.r32;
+
+            if (!words)
             {
+                // Nothing left to send, the frame still has to be closed.
+                APE_PERI.BmcToNcTxBufferLast.r32 = 0;
+            }
+        }
+
+        while (port->passthrough_word < words)
+        {
+            if (!space)
+            {
+                space = APE_PERI.BmcToNcTxStatus.bits.InFifo;
+
                 // This can hang durning network reconfiguration events.
                 // Timeout if no packets are draining - recovery code outside of this block will handle it.
                 int max_loops = 0x10000;
-                while (APE_PERI.BmcToNcTxStatus.bits.InFifo < words && --max_loops)
+                while (wait && !space && --max_loops)
                 {
-                    // TODO: This should check for a network problem and exit if that is the case.
+                    space = APE_PERI.BmcToNcTxStatus.bits.InFifo;
                 }
 
-                if (!max_loops)
+                if (!space)
                 {
-                    printf("Error waiting for fifo space. Network may be down.\n");
-                    // Drop all packets that remain and exit.
-                    retire.bits.Head = blockid;
-                    retire.bits.Tail = rxbuf.bits.Tail;
-                    *((RegAPERxPoolRetire_t *)port->rx_retire) = retire;
-
-                    // Tell the hardware that there are no more bytes to send.
-                    APE_PERI.BmcToNcTxBufferLast.r32 = 0;
+                    if (wait)
+                    {
+                        printf("Error waiting for fifo space. Network may be down.\n");
+                        Network_PassthroughRxDrop(port, true);
+                        return PASSTHROUGH_DROPPED;
+                    }
+
+                    // Resume from here on the next pass.
+                    ++port->shm_channel->NcsiChannelNetworkDeferred.r32;
+                    return PASSTHROUGH_DEFERRED;
                 }
             }
 
-            if (control.bits.not_last)
+            uint32_t i = port->passthrough_word++;
+            space--;
+
+            if (!close || i < words - 1)
             {
-                for (i = 0; i < words; i++)
-                {
-                    APE_PERI.BmcToNcTxBuffer.r32 = block[i + offset].r32;
-                }
+                APE_PERI.BmcToNcTxBuffer.r32 = block[i + offset].r32;
+            }
+            else if (0 == bytes % sizeof(uint32_t))
+            {
+                // Last word
+                APE_PERI.BmcToNcTxBuffer.r32 = block[i + offset].r32;
+                APE_PERI.BmcToNcTxBufferLast.r32 = 0;
             }
             else
             {
-                RegAPE_PERIBmcToNcTxControl_t ctrl;
-                ctrl.r32 = 0;
-                ctrl.bits.LastByteCount = control.bits.payload_length % sizeof(uint32_t);
-                APE_PERI.BmcToNcTxControl.r32 = ctrl.r32;
+                APE_PERI.BmcToNcTxBufferLast.r32 = block[i + offset].r32;
+            }
+        }
 
-                for (i = 0; i < words - 1; i++)
-                {
-                    APE_PERI.BmcToNcTxBuffer.r32 = block[i + offset].r32;
-                }
+        // Retire the frame with a single write, or in batches when the chain is too long for one.
+        if (!port->passthrough_retire_count)
+        {
+            port->passthrough_retire = port->passthrough_block;
+        }
+        port->passthrough_retire_count++;
 
-                // Last word to send.
-                if (0 == control.bits.payload_length % sizeof(uint32_t))
-                {
-                    // Last word
-                    APE_PERI.BmcToNcTxBuffer.r32 = block[i + offset].r32;
-                    APE_PERI.BmcToNcTxBufferLast.r32 = 0;
-                }
-                else
-                {
-                    APE_PERI.BmcToNcTxBufferLast.r32 = block[i + offset].r32;
-                }
+        if (!control.bits.not_last || (RX_RETIRE_MAX_BLOCKS == port->passthrough_retire_count))
+        {
+            Network_PassthroughRxRetire(port, port->passthrough_retire, port->passthrough_block, port->passthrough_retire_count);
+            port->passthrough_retire_count = 0;
+        }
 
-                // Ignore last word - drop the FCS.
-                // data = block[i + offset + 1].r32;
-                // (void)data;
-            }
+        port->passthrough_block = control.bits.next_block;
+        port->passthrough_word = 0;
+        if (!control.bits.not_last)
+        {
+            port->passthrough_blocks = 0;
+        }
+        else if (!--port->passthrough_blocks)
+        {
+            printf("RX chain longer than the pool, dropping frame.\n");
+            Network_PassthroughRxDrop(port, true);
+            return PASSTHROUGH_DROPPED;
+        }
+    }
 
-            // Retire this block.
-            retire.bits.Head = blockid;
-            retire.bits.Tail = blockid;
-            *((RegAPERxPoolRetire_t *)port->rx_retire) = retire;
+    gPassthroughPort = NULL;
 
-            blockid = control.bits.next_block;
-        }
+    // Mark the frame as read.
+    RegAPERxbufoffset_t rxbuf;
+    rxbuf.r32 = port->passthrough_rxbuf;
+    rxbuf.bits.Finished = 1;
+    *((RegAPERxbufoffset_t *)port->rx_offset) = rxbuf;
 
-        // Mark the frame as read.
-        rxbuf.bits.Finished = 1;
-        *((RegAPERxbufoffset_t *)port->rx_offset) = rxbuf;
+    // Packet recieved (RX via Network and transmitted via NCSI).
+    ++port->shm_channel->NcsiChannelNetworkRx.r32;
+    ++port->shm_channel->NcsiChannelNcsiTx.r32;
 
-        // Packet recieved (RX via Network and transmitted via NCSI).
-        ++port->shm_channel->NcsiChannelNetworkRx.r32;
-        ++port->shm_channel->NcsiChannelNcsiTx.r32;
+    return PASSTHROUGH_DELIVERED;
+}
 
-        return true;
+passthrough_status_t Network_PassthroughRxPatcket(NetworkPort_t *port)
+{
+    if (gPassthroughPort && gPassthroughPort != port)
+    {
+        // Another port owns the fifo until its frame is complete.
+        // Not counted, this port may not have a frame pending at all.
+        return PASSTHROUGH_DEFERRED;
+    }
+
+    if (port->passthrough_blocks)
+    {
+        // Continue the frame that was in progress.
+        return Network_PassthroughRxSend(port, false);
+    }
+
+    RegAPERxbufoffset_t rxbuf;
+    rxbuf = *((RegAPERxbufoffset_t *)port->rx_offset);
+    if ((int)rxbuf.bits.Valid)
+    {
+        port->network_resetting = false;
+
+#if CXX_SIMULATOR
+        rxbuf.print();
+#endif
+
+        port->passthrough_rxbuf = rxbuf.r32;
+        // Count is only 4 bits and wraps for jumbo frames, follow the chain to the last block instead.
+        port->passthrough_blocks = NETWORK_RX_MAX_BLOCKS;
+        port->passthrough_block = rxbuf.bits.Head;
+        port->passthrough_word = 0;
+        port->passthrough_retire_count = 0;
+
+        return Network_PassthroughRxSend(port, false);
     }
     else if (!port->network_resetting)
     {
@@ -279,8 +418,38 @@ bool Network_PassthroughRxPatcket(NetworkPort_t *port)
             //       Instead, we just flag this as a problem spot and wait.
             //       for the system to recover on its own.
             port->network_resetting = true;
+            ++port->shm_channel->NcsiChannelNetworkErrors.r32;
         }
     }
 
-    return false;
+    return port->network_resetting ? PASSTHROUGH_RX_ERROR : PASSTHROUGH_IDLE;
+}
+
+bool Network_PassthroughRxPending(NetworkPort_t *port)
+{
+    if (port->passthrough_blocks)
+    {
+        return true;
+    }
+
+    RegAPERxbufoffset_t rxbuf;
+    rxbuf.r32 = port->rx_offset->r32;
+    return (int)rxbuf.bits.Valid;
+}
+
+void Network_PassthroughRxFlush(void)
+{
+    if (gPassthroughPort)
+    {
+        (void)Network_PassthroughRxSend(gPassthroughPort, true);
+    }
+}
+
+void Network_PassthroughRxAbort(NetworkPort_t *port)
+{
+    if (port->passthrough_blocks)
+    {
+        // The RX pool is being reset, the blocks are gone.
+        Network_PassthroughRxDrop(port, false);
+    }
 }
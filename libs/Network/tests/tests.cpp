@@ -0,0 +1,126 @@
+#include "gtest/gtest.h"
+#include <../bcm5719_NVM.h>
+#include <NetworkFilters.h>
+#include <bcm5719-endian.h>
+#include <bcm5719_eeprom.h>
+#include <stdio.h>
+#include <string.h>
+
+#define TABLE_OFFSET (0x400u)
+
+// NVM contents, as stored in the flash.
+static uint8_t gNVM[0x800];
+static uint32_t gNVMAddr;
+
+static uint32_t write_addr(uint32_t val, uint32_t offset, void *args)
+{
+    gNVMAddr = val;
+    return val;
+}
+
+static uint32_t read_command(uint32_t val, uint32_t offset, void *args)
+{
+    return val | NVM_COMMAND_DONE_MASK;
+}
+
+static uint32_t read_data(uint32_t val, uint32_t offset, void *args)
+{
+    // The read register returns the word most significant byte first.
+    uint32_t word = 0xffffffff;
+    if (gNVMAddr + sizeof(word) <= sizeof(gNVM))
+    {
+        memcpy(&word, &gNVM[gNVMAddr], sizeof(word));
+    }
+
+    return be32toh(word);
+}
+
+static void init_harness(void)
+{
+    static bool installed = false;
+
+    if (!installed)
+    {
+        // Callbacks are chained, only install them once.
+        installed = true;
+        NVM.Addr.r32.installWriteCallback(write_addr, NULL);
+        NVM.Command.r32.installReadCallback(read_command, NULL);
+        NVM.Read.r32.installReadCallback(read_data, NULL);
+    }
+
+    memset(gNVM, 0xff, sizeof(gNVM));
+    memset(((NVRAMContents_t *)gNVM)->directory, 0, sizeof(((NVRAMContents_t *)gNVM)->directory));
+    gNVMAddr = 0;
+}
+
+// Places the table written by bcmfilter from default.filters in code directory entry 'index'.
+static void install_table(int index)
+{
+    FILE *in = fopen(FILTER_TABLE, "r");
+    ASSERT_NE(nullptr, in);
+    size_t read = fread(&gNVM[TABLE_OFFSET], 1, NETWORK_FILTER_TABLE_WORDS * sizeof(uint32_t), in);
+    fclose(in);
+    ASSERT_EQ(NETWORK_FILTER_TABLE_WORDS * sizeof(uint32_t), read);
+
+    uint32_t info = 0;
+    info = BCM_CODE_DIRECTORY_SET_LENGTH(info, NETWORK_FILTER_TABLE_WORDS);
+    info = BCM_CODE_DIRECTORY_SET_CPU(info, BCM_CODE_DIRECTORY_CPU_APE);
+    info = BCM_CODE_DIRECTORY_SET_TYPE(info, BCM_CODE_DIRECTORY_TYPE_USER_BLOCK);
+
+    NVRAMCodeDirectory_t *cd = &((NVRAMContents_t *)gNVM)->directory[index];
+    cd->codeInfo = htobe32(info);
+    cd->codeAddress = htobe32(0);
+    cd->directoryOffset = htobe32(TABLE_OFFSET);
+}
+
+TEST(Filters, RoundTrip)
+{
+    NetworkFilterTable_t table;
+
+    init_harness();
+    install_table(2);
+
+    // bcmfilter writes the table words big endian.
+    uint32_t expected[NETWORK_FILTER_TABLE_WORDS - 1];
+    memcpy(expected, &gNVM[TABLE_OFFSET], sizeof(expected));
+    for (size_t i = 0; i < ARRAY_ELEMENTS(expected); i++)
+    {
+        expected[i] = be32toh(expected[i]);
+    }
+
+    memset(&table, 0, sizeof(table));
+    EXPECT_TRUE(Network_ReadFilterTable(&table));
+    EXPECT_EQ(0, memcmp(expected, &table, sizeof(table)));
+
+    // default.filters describes the built in table.
+    EXPECT_EQ(NETWORK_FILTER_MAGIC, table.magic);
+    EXPECT_EQ(NETWORK_FILTER_VERSION, table.version);
+    EXPECT_EQ(NETWORK_FILTER_FLAG_NCSI, table.flags);
+    EXPECT_EQ(0x40400000u, table.rule_mask[29]); /* S-30 */
+    EXPECT_EQ(0x80000000u, table.rule_mask[30]); /* S-31 */
+}
+
+TEST(Filters, BadCRC)
+{
+    NetworkFilterTable_t table;
+
+    init_harness();
+    install_table(0);
+
+    // Change a rule mask.
+    gNVM[TABLE_OFFSET + sizeof(table) - 1] ^= 0x01;
+    EXPECT_FALSE(Network_ReadFilterTable(&table));
+}
+
+TEST(Filters, NoEntry)
+{
+    NetworkFilterTable_t table;
+
+    init_harness();
+    install_table(1);
+
+    // Same table, but not marked as an APE user block.
+    NVRAMCodeDirectory_t *cd = &((NVRAMContents_t *)gNVM)->directory[1];
+    cd->codeInfo = htobe32(BCM_CODE_DIRECTORY_SET_TYPE(be32toh(cd->codeInfo), BCM_CODE_DIRECTORY_TYPE_MBA));
+    EXPECT_FALSE(Network_ReadFilterTable(&table));
+}
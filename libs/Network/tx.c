@@ -47,22 +47,18 @@
 #include <APE_TX_PORT0.h>
 #include <Ethernet.h>
 #include <Network.h>
+#include <NetworkCopy.h>
 #include <types.h>
 
 #ifdef CXX_SIMULATOR
-#include <bcm5719-endian.h>
 #include <stdio.h>
 #else
 #include <printf.h>
-/* ARM */
-static inline uint32_t be32toh(uint32_t be32)
-{
-    uint32_t he32 = ((be32 & 0xFF000000) >> 24) | ((be32 & 0x00FF0000) >> 8) | ((be32 & 0x0000FF00) << 8) | ((be32 & 0x000000FF) << 24);
-
-    return he32;
-}
 #endif
 
+NETWORK_BLOCK_COPY_KERNEL(Network_TX_copyLeWords, RegTX_PORTOut_t, false)
+NETWORK_BLOCK_COPY_KERNEL(Network_TX_copyBeWords, RegTX_PORTOut_t, true)
+
 #define FIRST_FRAME_MAX ((TX_PORT_OUT_ALL_BLOCK_WORDS - TX_PORT_OUT_ALL_FIRST_PAYLOAD_WORD) * sizeof(uint32_t))
 #define ADDITIONAL_FRAME_MAX ((TX_PORT_OUT_ALL_BLOCK_WORDS - TX_PORT_OUT_ALL_ADDITIONAL_PAYLOAD_WORD) * sizeof(uint32_t))
 
@@ -80,7 +76,12 @@ uint32_t Network_TX_numBlocksNeeded(uint32_t frame_size)
     return blocks;
 }
 
-int32_t __attribute__((noinline)) Network_TX_allocateBlock(NetworkPort_t *port)
+uint32_t Network_TX_maxFrameSize(void)
+{
+    return FIRST_FRAME_MAX + ((NETWORK_TX_MAX_BLOCKS - 1) * ADDITIONAL_FRAME_MAX);
+}
+
+static int32_t __attribute__((noinline)) Network_TX_requestBlock(NetworkPort_t *port)
 {
     int32_t block;
 
@@ -100,7 +101,6 @@ int32_t __attribute__((noinline)) Network_TX_allocateBlock(NetworkPort_t *port)
     if (APE_TX_TO_NET_BUFFER_ALLOCATOR_STATE_ALLOCATION_OK != status.bits.State)
     {
         block = -1;
-        printf("TX Alloc Error.\n");
     }
     else
     {
@@ -110,6 +110,92 @@ int32_t __attribute__((noinline)) Network_TX_allocateBlock(NetworkPort_t *port)
     return block;
 }
 
+int32_t Network_TX_allocateBlock(NetworkPort_t *port)
+{
+    if (port->tx_cache_count)
+    {
+        return port->tx_cache[--port->tx_cache_count];
+    }
+
+    int32_t block = Network_TX_requestBlock(port);
+    if (block < 0)
+    {
+        printf("TX Alloc Error.\n");
+    }
+
+    return block;
+}
+
+void Network_TX_releaseBlock(NetworkPort_t *port, int32_t block)
+{
+    if (block < 0)
+    {
+        return;
+    }
+
+    // Keep it for the next packet instead of paying for another allocation.
+    // The cache holds the whole pool, so there is always room.
+    if (port->tx_cache_count < ARRAY_ELEMENTS(port->tx_cache))
+    {
+        port->tx_cache[port->tx_cache_count++] = block;
+    }
+}
+
+void Network_TX_refillBlocks(NetworkPort_t *port)
+{
+    RegAPETxToNetPoolModeStatus_t txMode = *port->tx_mode;
+    if (!txMode.bits.Enable || txMode.bits.Reset)
+    {
+        return;
+    }
+
+    for (int i = 0; i < NETWORK_TX_REFILL_BLOCKS && port->tx_cache_count < NETWORK_TX_CACHE_BLOCKS; i++)
+    {
+        int32_t block = Network_TX_requestBlock(port);
+        if (block < 0)
+        {
+            // Pool is empty, try again later.
+            break;
+        }
+
+        port->tx_cache[port->tx_cache_count++] = block;
+    }
+}
+
+void Network_TX_flushBlocks(NetworkPort_t *port)
+{
+    port->tx_cache_count = 0;
+}
+
+static bool Network_TX_allocateChain(NetworkPort_t *port, uint16_t *chain, uint32_t blocks)
+{
+    if (blocks > NETWORK_TX_MAX_BLOCKS)
+    {
+        printf("TX Frame too large.\n");
+        return false;
+    }
+
+    // Blocks come from the cache first, only the remainder pays for an allocator round trip.
+    for (uint32_t i = 0; i < blocks; i++)
+    {
+        int32_t block = Network_TX_allocateBlock(port);
+        if (block < 0)
+        {
+            // Hand back everything allocated so far.
+            while (i--)
+            {
+                Network_TX_releaseBlock(port, chain[i]);
+            }
+
+            return false;
+        }
+
+        chain[i] = block;
+    }
+
+    return true;
+}
+
 static uint32_t inline Network_TX_initFirstBlock(RegTX_PORTOut_t *block, uint32_t length, int32_t blocks, int32_t next_block, uint32_t *packet, bool big_endian)
 {
     network_control_t control;
@@ -145,23 +231,14 @@ static uint32_t inline Network_TX_initFirstBlock(RegTX_PORTOut_t *block, uint32_
     // block[11] = uninitialized;
 
     // Copy Payload Data.
-    int num_words = (copy_length + sizeof(uint32_t) - 1) / sizeof(uint32_t);
-    for (i = 0; i < num_words; i++)
+    int num_words = DIVIDE_RND_UP(copy_length, sizeof(uint32_t));
+    if (big_endian)
     {
-        if (big_endian)
-        {
-#if CXX_SIMULATOR
-            printf("1st[%d] = 0x%08X\n", i, be32toh(packet[i]));
-#endif
-            block[TX_PORT_OUT_ALL_FIRST_PAYLOAD_WORD + i].r32 = be32toh(packet[i]);
-        }
-        else
-        {
-#if CXX_SIMULATOR
-            printf("1LE[%d] = 0x%08X\n", i, (packet[i]));
-#endif
-            block[TX_PORT_OUT_ALL_FIRST_PAYLOAD_WORD + i].r32 = (packet[i]);
-        }
+        Network_TX_copyBeWords(&block[TX_PORT_OUT_ALL_FIRST_PAYLOAD_WORD], packet, num_words);
+    }
+    else
+    {
+        Network_TX_copyLeWords(&block[TX_PORT_OUT_ALL_FIRST_PAYLOAD_WORD], packet, num_words);
     }
 
     // Pad if too small.
@@ -169,8 +246,8 @@ static uint32_t inline Network_TX_initFirstBlock(RegTX_PORTOut_t *block, uint32_
     {
         copy_length = ETHERNET_FRAME_MIN;
 
-        num_words = DIVIDE_RND_UP(copy_length, sizeof(uint32_t));
-        for (; i < num_words; i++)
+        int pad_words = DIVIDE_RND_UP(copy_length, sizeof(uint32_t));
+        for (i = num_words; i < pad_words; i++)
         {
             // Pad remaining with 0's
             block[TX_PORT_OUT_ALL_FIRST_PAYLOAD_WORD + i].r32 = 0;
@@ -186,7 +263,6 @@ static uint32_t inline Network_TX_initFirstBlock(RegTX_PORTOut_t *block, uint32_
 
 static uint32_t inline Network_TX_initAdditionalBlock(RegTX_PORTOut_t *block, int32_t next_block, uint32_t length, uint32_t *packet, bool big_endian)
 {
-    int i;
     network_control_t control;
 
     control.r32 = 0;
@@ -210,16 +286,13 @@ static uint32_t inline Network_TX_initAdditionalBlock(RegTX_PORTOut_t *block, in
 
     // Copy payload data.
     int num_words = DIVIDE_RND_UP(length, sizeof(uint32_t));
-    for (i = 0; i < num_words; i++)
+    if (big_endian)
     {
-        if (big_endian)
-        {
-            block[TX_PORT_OUT_ALL_ADDITIONAL_PAYLOAD_WORD + i].r32 = be32toh(packet[i]);
-        }
-        else
-        {
-            block[TX_PORT_OUT_ALL_ADDITIONAL_PAYLOAD_WORD + i].r32 = (packet[i]);
-        }
+        Network_TX_copyBeWords(&block[TX_PORT_OUT_ALL_ADDITIONAL_PAYLOAD_WORD], packet, num_words);
+    }
+    else
+    {
+        Network_TX_copyLeWords(&block[TX_PORT_OUT_ALL_ADDITIONAL_PAYLOAD_WORD], packet, num_words);
     }
 
     block[TX_PORT_OUT_ALL_CONTROL_WORD].r32 = control.r32;
@@ -239,43 +312,24 @@ static inline bool Network_TX_transmitPacket_internal(uint8_t *packet, uint32_t
     uint32_t blocks = Network_TX_numBlocksNeeded(length);
     int total_blocks = blocks;
 
-    // First block
-    int32_t tail;
-    int32_t first = tail = Network_TX_allocateBlock(port);
-    if (first < 0)
+    uint16_t chain[NETWORK_TX_MAX_BLOCKS];
+    if (!Network_TX_allocateChain(port, chain, blocks))
     {
-        // Error
         return false;
     }
-    int32_t next_block = -1;
-    if (blocks > 1)
-    {
-        next_block = Network_TX_allocateBlock(port);
-        if (next_block < 0)
-        {
-            // TODO: Cleanup allocated blocks.
-            return false;
-        }
-    }
+
+    // First block
+    int32_t first = chain[0];
+    int32_t tail = chain[blocks - 1];
+    int32_t next_block = (blocks > 1) ? chain[1] : -1;
     RegTX_PORTOut_t *block = (RegTX_PORTOut_t *)&port->tx_port->Out[TX_PORT_OUT_ALL_BLOCK_WORDS * first];
 
     consumed += Network_TX_initFirstBlock(block, length, blocks, next_block, &packet_32[consumed / 4], big_endian);
-    blocks -= 1;
-    while (blocks--)
+    for (uint32_t i = 1; i < blocks; i++)
     {
-
-        block = (RegTX_PORTOut_t *)&port->tx_port->Out[TX_PORT_OUT_ALL_BLOCK_WORDS * next_block];
-        if (blocks)
-        {
-            next_block = Network_TX_allocateBlock(port);
-            consumed += Network_TX_initAdditionalBlock(block, next_block, length - consumed, &packet_32[consumed / 4], big_endian);
-        }
-        else
-        {
-            Network_TX_initAdditionalBlock(block, 0, length - consumed, &packet_32[consumed / 4], big_endian);
-        }
-
-        tail = next_block;
+        block = (RegTX_PORTOut_t *)&port->tx_port->Out[TX_PORT_OUT_ALL_BLOCK_WORDS * chain[i]];
+        next_block = (i + 1 < blocks) ? chain[i + 1] : 0;
+        consumed += Network_TX_initAdditionalBlock(block, next_block, length - consumed, &packet_32[consumed / 4], big_endian);
     }
 
     RegAPETxToNetDoorbell_t doorbell;
@@ -402,8 +456,8 @@ static uint32_t inline Network_TX_initAdditionalPassthroughBlock(RegTX_PORTOut_t
 static void drainPassthroughBytes(uint32_t bytes)
 {
     printf("Dropping %d bytes\n", bytes);
-    // Drain any passthrough bytes to ensure that the NCSI input buffers are not locked up.
-    int num_words = DIVIDE_RND_UP(bytes, sizeof(uint32_t)) + 1; // +1 for FCS word.
+    // Drain any passthrough bytes, including the FCS, to ensure that the NCSI input buffers are not locked up.
+    int num_words = DIVIDE_RND_UP(bytes, sizeof(uint32_t));
     for (int i = 0; i < num_words; i++)
     {
         uint32_t word = APE_PERI.BmcToNcReadBuffer.r32;
@@ -411,60 +465,52 @@ static void drainPassthroughBytes(uint32_t bytes)
     }
 }
 
-bool Network_TX_transmitPassthroughPacket(uint32_t length, NetworkPort_t *port)
+tx_passthrough_status_t Network_TX_transmitPassthroughPacket(uint32_t length, NetworkPort_t *port)
 {
-    if (!length)
+    if (length <= sizeof(uint32_t))
     {
-        return false;
+        // Nothing but the FCS, there is no frame to send.
+        drainPassthroughBytes(length);
+        ++port->shm_channel->NcsiChannelNcsiDropped.r32;
+        return TX_PASSTHROUGH_DROPPED;
     }
+
     // Drop the FCS word. It will be generated by hardware.
     length -= 4;
 
-    int32_t tail;
-    int32_t first = tail = Network_TX_allocateBlock(port);
-    if (first < 0)
-    {
-        // Unable to allocate block.
-        drainPassthroughBytes(length);
-        return false;
-    }
-    int32_t next_block = -1;
     uint32_t blocks = Network_TX_numBlocksNeeded(length);
     int total_blocks = blocks;
 
-    if (blocks > 1)
+    uint16_t chain[NETWORK_TX_MAX_BLOCKS];
+    if (!Network_TX_allocateChain(port, chain, blocks))
     {
-        next_block = Network_TX_allocateBlock(port);
-        if (next_block < 0)
+        // Unable to allocate blocks.
+        drainPassthroughBytes(length + sizeof(uint32_t));
+        ++port->shm_channel->NcsiChannelNcsiDropped.r32;
+
+        // An empty pool refills as the MAC sends the queued frames, a halted or failed pool does not.
+        RegAPETxToNetPoolModeStatus_t txMode = *port->tx_mode;
+        if (txMode.bits.Error || txMode.bits.Halt || !txMode.bits.Enable)
         {
-            drainPassthroughBytes(length);
-            return false;
+            return TX_PASSTHROUGH_LOCKED_UP;
         }
+
+        ++port->shm_channel->NcsiChannelNcsiNoBlocks.r32;
+        return TX_PASSTHROUGH_NO_BLOCKS;
     }
+
+    // Stream straight from the RMU fifo into the chain.
+    int32_t first = chain[0];
+    int32_t tail = chain[blocks - 1];
+    int32_t next_block = (blocks > 1) ? chain[1] : -1;
     RegTX_PORTOut_t *block = (RegTX_PORTOut_t *)&port->tx_port->Out[TX_PORT_OUT_ALL_BLOCK_WORDS * first];
 
     length -= Network_TX_initFirstPassthroughBlock(block, length, blocks, next_block);
-    blocks -= 1;
-
-    while (blocks--)
+    for (uint32_t i = 1; i < blocks; i++)
     {
-        block = (RegTX_PORTOut_t *)&port->tx_port->Out[TX_PORT_OUT_ALL_BLOCK_WORDS * next_block];
-        if (blocks)
-        {
-            next_block = Network_TX_allocateBlock(port);
-            if (next_block < 0)
-            {
-                drainPassthroughBytes(length);
-                return false;
-            }
-            length -= Network_TX_initAdditionalPassthroughBlock(block, next_block, length);
-        }
-        else
-        {
-            Network_TX_initAdditionalPassthroughBlock(block, 0, length);
-        }
-
-        tail = next_block;
+        block = (RegTX_PORTOut_t *)&port->tx_port->Out[TX_PORT_OUT_ALL_BLOCK_WORDS * chain[i]];
+        next_block = (i + 1 < blocks) ? chain[i + 1] : 0;
+        length -= Network_TX_initAdditionalPassthroughBlock(block, next_block, length);
     }
 
     RegAPETxToNetDoorbell_t doorbell;
@@ -482,5 +528,5 @@ bool Network_TX_transmitPassthroughPacket(uint32_t length, NetworkPort_t *port)
     // Packet transmitted.
     ++port->shm_channel->NcsiChannelNetworkTx.r32;
 
-    return true;
+    return TX_PASSTHROUGH_SENT;
 }
@@ -0,0 +1,649 @@
+////////////////////////////////////////////////////////////////////////////////
+///
+/// @file       APEModel.cpp
+///
+/// @project
+///
+/// @brief      In-process model of the APE packet path
+///
+////////////////////////////////////////////////////////////////////////////////
+///
+////////////////////////////////////////////////////////////////////////////////
+///
+/// @copyright Copyright (c) 2020, Evan Lojewski
+/// @cond
+///
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+/// 1. Redistributions of source code must retain the above copyright notice,
+/// this list of conditions and the following disclaimer.
+/// 2. Redistributions in binary form must reproduce the above copyright notice,
+/// this list of conditions and the following disclaimer in the documentation
+/// and/or other materials provided with the distribution.
+/// 3. Neither the name of the copyright holder nor the
+/// names of its contributors may be used to endorse or promote products
+/// derived from this software without specific prior written permission.
+///
+////////////////////////////////////////////////////////////////////////////////
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+/// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+/// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+/// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+/// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+/// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+/// POSSIBILITY OF SUCH DAMAGE.
+/// @endcond
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include <APEModel.hpp>
+#include <APE_RX_PORT0.h>
+#include <APE_RX_PORT1.h>
+#include <APE_RX_PORT2.h>
+#include <APE_RX_PORT3.h>
+#include <APE_TX_PORT0.h>
+#include <APE_TX_PORT1.h>
+#include <APE_TX_PORT2.h>
+#include <APE_TX_PORT3.h>
+#include <HAL.hpp>
+#include <bcm5719_APE.h>
+#include <bcm5719_APE_PERI.h>
+#include <bcm5719_SHM.h>
+#include <bcm5719_SHM_CHANNEL0.h>
+#include <bcm5719_SHM_CHANNEL1.h>
+#include <bcm5719_SHM_CHANNEL2.h>
+#include <bcm5719_SHM_CHANNEL3.h>
+
+#include <string.h>
+#include <time.h>
+
+#include <deque>
+#include <vector>
+
+#define MODEL_APE_MEMORY_SIZE (0x10000) /* Size of the APE BAR */
+
+#define MODEL_RX_WORDS  (ARRAY_ELEMENTS(RX_PORT0.In))
+#define MODEL_TX_WORDS  (ARRAY_ELEMENTS(TX_PORT0.Out))
+#define MODEL_RX_BLOCKS (MODEL_RX_WORDS / RX_PORT_IN_ALL_BLOCK_WORDS)
+#define MODEL_TX_BLOCKS (MODEL_TX_WORDS / TX_PORT_OUT_ALL_BLOCK_WORDS)
+
+#define MODEL_BMC_TX_FIFO_WORDS (0x200) /* Free space reported to the firmware, the modelled BMC drains instantly. */
+
+/* Block control word, see network_control_t. */
+#define CONTROL_PAYLOAD_LENGTH(__w__) ((__w__)&0x7Fu)
+#define CONTROL_NEXT_BLOCK(__w__)     (((__w__) >> 7) & 0x7FFFFFu)
+#define CONTROL_FIRST                 (1u << 30)
+#define CONTROL_NOT_LAST              (1u << 31)
+
+#define RX_FIRST_PAYLOAD_BYTES      ((RX_PORT_IN_ALL_BLOCK_WORDS - RX_PORT_IN_ALL_FIRST_PAYLOAD_WORD) * sizeof(uint32_t))
+#define RX_ADDITIONAL_PAYLOAD_BYTES ((RX_PORT_IN_ALL_BLOCK_WORDS - RX_PORT_IN_ALL_ADDITIONAL_PAYLOAD_WORD) * sizeof(uint32_t))
+
+#define FCS_BYTES (sizeof(uint32_t))
+
+typedef struct
+{
+    uint32_t head;
+    uint32_t tail;
+    uint32_t blocks;
+} rx_frame_t;
+
+typedef struct
+{
+    std::vector<uint32_t> words;
+    uint32_t length; /* Including the FCS, as reported by BmcToNcRxStatus */
+    bool passthrough;
+} bmc_frame_t;
+
+typedef struct
+{
+    uint32_t rx_mem[MODEL_RX_WORDS];
+    uint32_t tx_mem[MODEL_TX_WORDS];
+
+    bool rx_used[MODEL_RX_BLOCKS];
+    bool tx_used[MODEL_TX_BLOCKS];
+    std::deque<uint32_t> rx_free;
+    std::deque<uint32_t> tx_free;
+
+    std::deque<rx_frame_t> rx_frames; /* Frames waiting in Rxbufoffset, front is presented */
+    uint32_t tx_allocator;            /* Result of the last allocation request */
+} port_model_t;
+
+static uint8_t gAPEMemory[MODEL_APE_MEMORY_SIZE];
+static port_model_t gPorts[APE_MODEL_PORTS];
+static ape_model_stats_t gStats;
+static struct timespec gStartTime;
+
+static std::deque<bmc_frame_t> gBMCFrames;
+static bool gBMCFrameActive; /* Front frame was presented by BmcToNcRxStatus */
+static uint32_t gBMCFrameWord;
+
+static uint32_t gBMCTxBytes;
+static uint32_t gBMCTxLastByteCount;
+
+static uint64_t elapsedMicroseconds(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (uint64_t)(now.tv_sec - gStartTime.tv_sec) * 1000000 + (now.tv_nsec - gStartTime.tv_nsec) / 1000;
+}
+
+static uint32_t read_tick_1mhz(uint32_t val, uint32_t offset, void *args)
+{
+    gStats.reads++;
+    return (uint32_t)elapsedMicroseconds();
+}
+
+static uint32_t read_tick_1khz(uint32_t val, uint32_t offset, void *args)
+{
+    gStats.reads++;
+    return (uint32_t)(elapsedMicroseconds() / 1000);
+}
+
+static uint32_t read_tick_10hz(uint32_t val, uint32_t offset, void *args)
+{
+    gStats.reads++;
+    return (uint32_t)(elapsedMicroseconds() / 100000);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Port block memory
+////////////////////////////////////////////////////////////////////////////////
+static uint32_t read_rx_mem(uint32_t val, uint32_t offset, void *args)
+{
+    gStats.reads++;
+    return ((port_model_t *)args)->rx_mem[offset / sizeof(uint32_t)];
+}
+
+static uint32_t write_rx_mem(uint32_t val, uint32_t offset, void *args)
+{
+    gStats.writes++;
+    ((port_model_t *)args)->rx_mem[offset / sizeof(uint32_t)] = val;
+    return val;
+}
+
+static uint32_t read_tx_mem(uint32_t val, uint32_t offset, void *args)
+{
+    gStats.reads++;
+    return ((port_model_t *)args)->tx_mem[offset / sizeof(uint32_t)];
+}
+
+static uint32_t write_tx_mem(uint32_t val, uint32_t offset, void *args)
+{
+    gStats.writes++;
+    ((port_model_t *)args)->tx_mem[offset / sizeof(uint32_t)] = val;
+    return val;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// TX pool
+////////////////////////////////////////////////////////////////////////////////
+static void releaseTxBlock(port_model_t *port, uint32_t block)
+{
+    if (block >= MODEL_TX_BLOCKS || !port->tx_used[block])
+    {
+        // Double free or a block that was never allocated.
+        gStats.errors++;
+        return;
+    }
+
+    port->tx_used[block] = false;
+    port->tx_free.push_back(block);
+}
+
+static uint32_t read_tx_allocator(uint32_t val, uint32_t offset, void *args)
+{
+    gStats.reads++;
+    return ((port_model_t *)args)->tx_allocator;
+}
+
+static uint32_t write_tx_allocator(uint32_t val, uint32_t offset, void *args)
+{
+    port_model_t *port = (port_model_t *)args;
+    gStats.writes++;
+
+    if (val & APE_TX_TO_NET_BUFFER_ALLOCATOR_0_REQUEST_ALLOCATION_MASK)
+    {
+        if (port->tx_free.empty())
+        {
+            gStats.tx_alloc_failures++;
+            port->tx_allocator = SET_APE_TX_TO_NET_BUFFER_ALLOCATOR_0_STATE(APE_TX_TO_NET_BUFFER_ALLOCATOR_STATE_ERROR__EMPTY);
+        }
+        else
+        {
+            uint32_t block = port->tx_free.front();
+            port->tx_free.pop_front();
+            port->tx_used[block] = true;
+
+            port->tx_allocator = SET_APE_TX_TO_NET_BUFFER_ALLOCATOR_0_STATE(APE_TX_TO_NET_BUFFER_ALLOCATOR_STATE_ALLOCATION_OK) |
+                                 SET_APE_TX_TO_NET_BUFFER_ALLOCATOR_0_INDEX(block);
+        }
+    }
+
+    return val;
+}
+
+static uint32_t write_tx_return(uint32_t val, uint32_t offset, void *args)
+{
+    gStats.writes++;
+    releaseTxBlock((port_model_t *)args, GET_APE_TX_TO_NET_BUFFER_ALLOCATOR_0_INDEX(val));
+    return val;
+}
+
+static uint32_t write_tx_doorbell(uint32_t val, uint32_t offset, void *args)
+{
+    port_model_t *port = (port_model_t *)args;
+    uint32_t head = GET_APE_TX_TO_NET_DOORBELL_FUNC0_HEAD(val);
+    uint32_t tail = GET_APE_TX_TO_NET_DOORBELL_FUNC0_TAIL(val);
+    uint32_t blocks = 0;
+    gStats.writes++;
+
+    if (head >= MODEL_TX_BLOCKS || !port->tx_used[head] || !(port->tx_mem[head * TX_PORT_OUT_ALL_BLOCK_WORDS] & CONTROL_FIRST))
+    {
+        gStats.errors++;
+        return val;
+    }
+
+    uint32_t length = port->tx_mem[head * TX_PORT_OUT_ALL_BLOCK_WORDS + TX_PORT_OUT_ALL_FRAME_LEN_WORD];
+
+    // The frame goes out on the wire immediately, hand the chain straight back to the pool.
+    uint32_t block = head;
+    for (;;)
+    {
+        if (block >= MODEL_TX_BLOCKS || !port->tx_used[block] || blocks >= MODEL_TX_BLOCKS)
+        {
+            gStats.errors++;
+            break;
+        }
+
+        uint32_t control = port->tx_mem[block * TX_PORT_OUT_ALL_BLOCK_WORDS + TX_PORT_OUT_ALL_CONTROL_WORD];
+        releaseTxBlock(port, block);
+        blocks++;
+
+        if (!(control & CONTROL_NOT_LAST))
+        {
+            if (block != tail)
+            {
+                gStats.errors++;
+            }
+            break;
+        }
+
+        block = CONTROL_NEXT_BLOCK(control);
+    }
+
+    if (GET_APE_TX_TO_NET_DOORBELL_FUNC0_LENGTH(SET_APE_TX_TO_NET_DOORBELL_FUNC0_LENGTH(blocks)) != GET_APE_TX_TO_NET_DOORBELL_FUNC0_LENGTH(val))
+    {
+        gStats.errors++;
+    }
+
+    gStats.network_tx_frames++;
+    gStats.network_tx_bytes += length;
+
+    return val;
+}
+
+static uint32_t read_tx_mode(uint32_t val, uint32_t offset, void *args)
+{
+    gStats.reads++;
+    return APE_TX_TO_NET_POOL_MODE_STATUS_0_ENABLE_MASK;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// RX pool
+////////////////////////////////////////////////////////////////////////////////
+static uint32_t read_rx_offset(uint32_t val, uint32_t offset, void *args)
+{
+    port_model_t *port = (port_model_t *)args;
+    gStats.reads++;
+
+    if (port->rx_frames.empty())
+    {
+        return 0;
+    }
+
+    const rx_frame_t &frame = port->rx_frames.front();
+
+    // Count is only 4 bits, the hardware wraps it for long chains.
+    return APE_RXBUFOFFSET_FUNC0_VALID_MASK | SET_APE_RXBUFOFFSET_FUNC0_HEAD(frame.head) | SET_APE_RXBUFOFFSET_FUNC0_TAIL(frame.tail) |
+           SET_APE_RXBUFOFFSET_FUNC0_COUNT(frame.blocks);
+}
+
+static uint32_t write_rx_offset(uint32_t val, uint32_t offset, void *args)
+{
+    port_model_t *port = (port_model_t *)args;
+    gStats.writes++;
+
+    if (val & APE_RXBUFOFFSET_FUNC0_FINISHED_MASK)
+    {
+        if (port->rx_frames.empty() || GET_APE_RXBUFOFFSET_FUNC0_HEAD(val) != port->rx_frames.front().head)
+        {
+            gStats.errors++;
+        }
+        else
+        {
+            port->rx_frames.pop_front();
+            gStats.network_rx_frames++;
+        }
+    }
+
+    return val;
+}
+
+static uint32_t write_rx_retire(uint32_t val, uint32_t offset, void *args)
+{
+    port_model_t *port = (port_model_t *)args;
+    gStats.writes++;
+
+    if (!(val & APE_RX_POOL_RETIRE_0_RETIRE_MASK))
+    {
+        return val;
+    }
+
+    // Blocks from Head through Tail go back to the pool.
+    uint32_t block = GET_APE_RX_POOL_RETIRE_0_HEAD(val);
+    uint32_t tail = GET_APE_RX_POOL_RETIRE_0_TAIL(val);
+    for (uint32_t retired = 0;; retired++)
+    {
+        if (block >= MODEL_RX_BLOCKS || !port->rx_used[block] || retired >= MODEL_RX_BLOCKS)
+        {
+            gStats.errors++;
+            break;
+        }
+
+        uint32_t control = port->rx_mem[block * RX_PORT_IN_ALL_BLOCK_WORDS + RX_PORT_IN_ALL_CONTROL_WORD];
+        port->rx_used[block] = false;
+        port->rx_free.push_back(block);
+
+        if (block == tail)
+        {
+            break;
+        }
+
+        block = CONTROL_NEXT_BLOCK(control);
+    }
+
+    return val;
+}
+
+static uint32_t read_rx_mode(uint32_t val, uint32_t offset, void *args)
+{
+    gStats.reads++;
+    return APE_RX_POOL_MODE_STATUS_0_ENABLE_MASK;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// RMU fifos
+////////////////////////////////////////////////////////////////////////////////
+static uint32_t read_bmc_rx_status(uint32_t val, uint32_t offset, void *args)
+{
+    gStats.reads++;
+
+    if (!gBMCFrameActive && !gBMCFrames.empty())
+    {
+        gBMCFrameActive = true;
+        gBMCFrameWord = 0;
+    }
+
+    if (!gBMCFrameActive)
+    {
+        return 0;
+    }
+
+    const bmc_frame_t &frame = gBMCFrames.front();
+    return APE_PERI_BMC_TO_NC_RX_STATUS_NEW_MASK | (frame.passthrough ? APE_PERI_BMC_TO_NC_RX_STATUS_PASSTHRU_MASK : 0) |
+           SET_APE_PERI_BMC_TO_NC_RX_STATUS_PACKET_LENGTH(frame.length);
+}
+
+static uint32_t read_bmc_read_buffer(uint32_t val, uint32_t offset, void *args)
+{
+    gStats.reads++;
+
+    if (!gBMCFrameActive)
+    {
+        // Read past the end of the frame, or before the status was checked.
+        gStats.errors++;
+        return 0;
+    }
+
+    const bmc_frame_t &frame = gBMCFrames.front();
+    uint32_t word = frame.words[gBMCFrameWord++];
+    if (gBMCFrameWord == frame.words.size())
+    {
+        gBMCFrames.pop_front();
+        gBMCFrameActive = false;
+        gStats.bmc_rx_frames++;
+    }
+
+    return word;
+}
+
+static uint32_t read_bmc_tx_status(uint32_t val, uint32_t offset, void *args)
+{
+    gStats.reads++;
+    return SET_APE_PERI_BMC_TO_NC_TX_STATUS_IN_FIFO(MODEL_BMC_TX_FIFO_WORDS);
+}
+
+static uint32_t write_bmc_tx_control(uint32_t val, uint32_t offset, void *args)
+{
+    gStats.writes++;
+    gBMCTxLastByteCount = GET_APE_PERI_BMC_TO_NC_TX_CONTROL_LAST_BYTE_COUNT(val);
+    return val;
+}
+
+static uint32_t write_bmc_tx_buffer(uint32_t val, uint32_t offset, void *args)
+{
+    gStats.writes++;
+    gBMCTxBytes += sizeof(uint32_t);
+    return val;
+}
+
+static uint32_t write_bmc_tx_buffer_last(uint32_t val, uint32_t offset, void *args)
+{
+    gStats.writes++;
+
+    // A zero byte count closes the frame without adding data.
+    gStats.bmc_tx_bytes += gBMCTxBytes + gBMCTxLastByteCount;
+    gStats.bmc_tx_frames++;
+    gBMCTxBytes = 0;
+
+    return val;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Setup
+////////////////////////////////////////////////////////////////////////////////
+static void initPortModel(port_model_t *port, RX_PORT_t &rx_port, TX_PORT_t &tx_port, RegAPETxToNetBufferAllocator_t &tx_allocator,
+                          RegAPETxToNetBufferReturn_t &tx_return, RegAPETxToNetDoorbell_t &tx_doorbell, RegAPETxToNetPoolModeStatus_t &tx_mode,
+                          RegAPERxbufoffset_t &rx_offset, RegAPERxPoolRetire_t &rx_retire, RegAPERxPoolModeStatus_t &rx_mode)
+{
+    for (size_t i = 0; i < ARRAY_ELEMENTS(rx_port.In); i++)
+    {
+        rx_port.In[i].r32.installReadCallback(read_rx_mem, port);
+        rx_port.In[i].r32.installWriteCallback(write_rx_mem, port);
+    }
+
+    for (size_t i = 0; i < ARRAY_ELEMENTS(tx_port.Out); i++)
+    {
+        tx_port.Out[i].r32.installReadCallback(read_tx_mem, port);
+        tx_port.Out[i].r32.installWriteCallback(write_tx_mem, port);
+    }
+
+    for (uint32_t i = 0; i < MODEL_RX_BLOCKS; i++)
+    {
+        port->rx_free.push_back(i);
+    }
+
+    for (uint32_t i = 0; i < MODEL_TX_BLOCKS; i++)
+    {
+        port->tx_free.push_back(i);
+    }
+
+    tx_allocator.r32.installReadCallback(read_tx_allocator, port);
+    tx_allocator.r32.installWriteCallback(write_tx_allocator, port);
+    tx_return.r32.installWriteCallback(write_tx_return, port);
+    tx_doorbell.r32.installWriteCallback(write_tx_doorbell, port);
+    tx_mode.r32.installReadCallback(read_tx_mode, port);
+
+    rx_offset.r32.installReadCallback(read_rx_offset, port);
+    rx_offset.r32.installWriteCallback(write_rx_offset, port);
+    rx_retire.r32.installWriteCallback(write_rx_retire, port);
+    rx_mode.r32.installReadCallback(read_rx_mode, port);
+}
+
+void initAPEModel(void)
+{
+    clock_gettime(CLOCK_MONOTONIC, &gStartTime);
+
+    // Same layout as the APE BAR, see initHAL.
+    gAPEBase = gAPEMemory;
+
+    init_bcm5719_APE();
+    init_bcm5719_APE_sim(gAPEMemory);
+
+    init_bcm5719_APE_PERI();
+    init_bcm5719_APE_PERI_sim(&gAPEMemory[0x8000]);
+
+    init_bcm5719_SHM();
+    init_bcm5719_SHM_sim(&gAPEMemory[0x4000]);
+
+    init_bcm5719_SHM_CHANNEL0();
+    init_bcm5719_SHM_CHANNEL0_sim(&gAPEMemory[0x4900]);
+    init_bcm5719_SHM_CHANNEL1();
+    init_bcm5719_SHM_CHANNEL1_sim(&gAPEMemory[0x4a00]);
+    init_bcm5719_SHM_CHANNEL2();
+    init_bcm5719_SHM_CHANNEL2_sim(&gAPEMemory[0x4b00]);
+    init_bcm5719_SHM_CHANNEL3();
+    init_bcm5719_SHM_CHANNEL3_sim(&gAPEMemory[0x4c00]);
+
+    // The model callbacks run after the RAM callbacks and override the value read.
+    APE.Tick1mhz.r32.installReadCallback(read_tick_1mhz, NULL);
+    APE.Tick1khz.r32.installReadCallback(read_tick_1khz, NULL);
+    APE.Tick10hz.r32.installReadCallback(read_tick_10hz, NULL);
+
+    initPortModel(&gPorts[0], RX_PORT0, TX_PORT0, APE.TxToNetBufferAllocator0, APE.TxToNetBufferReturn0, APE.TxToNetDoorbellFunc0,
+                  APE.TxToNetPoolModeStatus0, APE.RxbufoffsetFunc0, APE.RxPoolRetire0, APE.RxPoolModeStatus0);
+    initPortModel(&gPorts[1], RX_PORT1, TX_PORT1, APE.TxToNetBufferAllocator1, APE.TxToNetBufferReturn1, APE.TxToNetDoorbellFunc1,
+                  APE.TxToNetPoolModeStatus1, APE.RxbufoffsetFunc1, APE.RxPoolRetire1, APE.RxPoolModeStatus1);
+    initPortModel(&gPorts[2], RX_PORT2, TX_PORT2, APE.TxToNetBufferAllocator2, APE.TxToNetBufferReturn2, APE.TxToNetDoorbellFunc2,
+                  APE.TxToNetPoolModeStatus2, APE.RxbufoffsetFunc2, APE.RxPoolRetire2, APE.RxPoolModeStatus2);
+    initPortModel(&gPorts[3], RX_PORT3, TX_PORT3, APE.TxToNetBufferAllocator3, APE.TxToNetBufferReturn3, APE.TxToNetDoorbellFunc3,
+                  APE.TxToNetPoolModeStatus3, APE.RxbufoffsetFunc3, APE.RxPoolRetire3, APE.RxPoolModeStatus3);
+
+    APE_PERI.BmcToNcRxStatus.r32.installReadCallback(read_bmc_rx_status, NULL);
+    APE_PERI.BmcToNcReadBuffer.r32.installReadCallback(read_bmc_read_buffer, NULL);
+    APE_PERI.BmcToNcTxStatus.r32.installReadCallback(read_bmc_tx_status, NULL);
+    APE_PERI.BmcToNcTxControl.r32.installWriteCallback(write_bmc_tx_control, NULL);
+    APE_PERI.BmcToNcTxBuffer.r32.installWriteCallback(write_bmc_tx_buffer, NULL);
+    APE_PERI.BmcToNcTxBufferLast.r32.installWriteCallback(write_bmc_tx_buffer_last, NULL);
+}
+
+bool APEModel_queueBMCFrame(const uint8_t *frame, uint32_t length, bool passthrough)
+{
+    bmc_frame_t bmc;
+    bmc.length = length + FCS_BYTES;
+    bmc.passthrough = passthrough;
+
+    if (bmc.length > GET_APE_PERI_BMC_TO_NC_RX_STATUS_PACKET_LENGTH(APE_PERI_BMC_TO_NC_RX_STATUS_PACKET_LENGTH_MASK))
+    {
+        return false;
+    }
+
+    // The FCS is not checked by the firmware, leave it zero.
+    bmc.words.resize(DIVIDE_RND_UP(bmc.length, sizeof(uint32_t)), 0);
+    memcpy(bmc.words.data(), frame, length);
+
+    gBMCFrames.push_back(bmc);
+
+    return true;
+}
+
+unsigned int APEModel_pendingBMCFrames(void)
+{
+    return gBMCFrames.size();
+}
+
+bool APEModel_queueNetworkFrame(unsigned int port_index, const uint8_t *frame, uint32_t length)
+{
+    if (port_index >= APE_MODEL_PORTS)
+    {
+        return false;
+    }
+
+    port_model_t *port = &gPorts[port_index];
+    uint32_t bytes = length + FCS_BYTES;
+    uint32_t blocks = 1;
+    if (bytes > RX_FIRST_PAYLOAD_BYTES)
+    {
+        blocks += DIVIDE_RND_UP(bytes - RX_FIRST_PAYLOAD_BYTES, RX_ADDITIONAL_PAYLOAD_BYTES);
+    }
+
+    if (blocks > port->rx_free.size())
+    {
+        // Pool is full, the hardware would drop the frame.
+        return false;
+    }
+
+    // Frame data followed by a zero FCS.
+    std::vector<uint8_t> data(DIVIDE_RND_UP(bytes, sizeof(uint32_t)) * sizeof(uint32_t), 0);
+    memcpy(data.data(), frame, length);
+
+    rx_frame_t rx;
+    rx.blocks = blocks;
+    rx.head = port->rx_free.front();
+
+    uint32_t consumed = 0;
+    uint32_t block = rx.head;
+    port->rx_free.pop_front();
+    for (uint32_t i = 0; i < blocks; i++)
+    {
+        uint32_t *mem = &port->rx_mem[block * RX_PORT_IN_ALL_BLOCK_WORDS];
+        uint32_t offset = i ? RX_PORT_IN_ALL_ADDITIONAL_PAYLOAD_WORD : RX_PORT_IN_ALL_FIRST_PAYLOAD_WORD;
+        uint32_t payload = MIN(bytes - consumed, (uint32_t)(i ? RX_ADDITIONAL_PAYLOAD_BYTES : RX_FIRST_PAYLOAD_BYTES));
+
+        memcpy(&mem[offset], &data[consumed], DIVIDE_RND_UP(payload, sizeof(uint32_t)) * sizeof(uint32_t));
+        consumed += payload;
+        port->rx_used[block] = true;
+
+        uint32_t control = payload | (i ? 0 : CONTROL_FIRST);
+        if (i + 1 < blocks)
+        {
+            uint32_t next = port->rx_free.front();
+            port->rx_free.pop_front();
+            control |= CONTROL_NOT_LAST | (next << 7);
+            mem[RX_PORT_IN_ALL_CONTROL_WORD] = control;
+            block = next;
+        }
+        else
+        {
+            mem[RX_PORT_IN_ALL_CONTROL_WORD] = control;
+        }
+    }
+    rx.tail = block;
+
+    port->rx_frames.push_back(rx);
+
+    return true;
+}
+
+unsigned int APEModel_pendingNetworkFrames(unsigned int port)
+{
+    return port < APE_MODEL_PORTS ? gPorts[port].rx_frames.size() : 0;
+}
+
+void APEModel_getStats(ape_model_stats_t *stats)
+{
+    *stats = gStats;
+}
+
+void APEModel_resetStats(void)
+{
+    memset(&gStats, 0, sizeof(gStats));
+}
@@ -75,6 +75,26 @@ void init_bcm5719_SHM(void)
 
     /** @brief Bitmap for @ref SHM_t.LoaderArg1. */
 
+    /** @brief Bitmap for @ref SHM_t.DrainBudget. */
+
+    /** @brief Bitmap for @ref SHM_t.DrainBmcExhausted. */
+
+    /** @brief Bitmap for @ref SHM_t.DrainNetworkExhausted. */
+
+    /** @brief Bitmap for @ref SHM_t.RmuFlowControl. */
+
+    /** @brief Bitmap for @ref SHM_t.RmuRxBacklog. */
+
+    /** @brief Bitmap for @ref SHM_t.RmuFlowAdjustments. */
+
+    /** @brief Bitmap for @ref SHM_t.RmuTxFifoMinFree. */
+
+    /** @brief Bitmap for @ref SHM_t.PowerPolicy. */
+
+    /** @brief Bitmap for @ref SHM_t.PowerPolicySwitches. */
+
+    /** @brief Bitmap for @ref SHM_t.PowerPolicyTime. */
+
     /** @brief Bitmap for @ref SHM_t.RcpuSegSig. */
 
     /** @brief Bitmap for @ref SHM_t.RcpuSegLength. */
@@ -101,6 +121,14 @@ void init_bcm5719_SHM(void)
 
     /** @brief Bitmap for @ref SHM_t.RcpuCpmuStatus. */
 
+    /** @brief Bitmap for @ref SHM_t.NcsiTraceIndex. */
+
+    /** @brief Bitmap for @ref SHM_t.NcsiTraceCommand. */
+
+    /** @brief Bitmap for @ref SHM_t.NcsiTraceStart. */
+
+    /** @brief Bitmap for @ref SHM_t.NcsiTraceEnd. */
+
     /** @brief Bitmap for @ref SHM_t.HostSegSig. */
 
     /** @brief Bitmap for @ref SHM_t.HostSegLen. */
@@ -114,11 +114,10 @@ void init_bcm5719_SHM_CHANNEL1_sim(void *base)
     SHM_CHANNEL1.NcsiChannelVlan.r32.installReadCallback(read_from_ram, (uint8_t *)base);
     SHM_CHANNEL1.NcsiChannelVlan.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
 
-    for(int i = 0; i < 1; i++)
-    {
-        SHM_CHANNEL1.reserved_32[i].installReadCallback(read_from_ram, (uint8_t *)base);
-        SHM_CHANNEL1.reserved_32[i].installWriteCallback(write_to_ram, (uint8_t *)base);
-    }
+    /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelReloadTime. */
+    SHM_CHANNEL1.NcsiChannelReloadTime.r32.installReadCallback(read_from_ram, (uint8_t *)base);
+    SHM_CHANNEL1.NcsiChannelReloadTime.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelAltHostMacHigh. */
     SHM_CHANNEL1.NcsiChannelAltHostMacHigh.r32.installReadCallback(read_from_ram, (uint8_t *)base);
     SHM_CHANNEL1.NcsiChannelAltHostMacHigh.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
@@ -131,11 +130,10 @@ void init_bcm5719_SHM_CHANNEL1_sim(void *base)
     SHM_CHANNEL1.NcsiChannelAltHostMacLow.r32.installReadCallback(read_from_ram, (uint8_t *)base);
     SHM_CHANNEL1.NcsiChannelAltHostMacLow.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
 
-    for(int i = 0; i < 1; i++)
-    {
-        SHM_CHANNEL1.reserved_48[i].installReadCallback(read_from_ram, (uint8_t *)base);
-        SHM_CHANNEL1.reserved_48[i].installWriteCallback(write_to_ram, (uint8_t *)base);
-    }
+    /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelReloadMaxTime. */
+    SHM_CHANNEL1.NcsiChannelReloadMaxTime.r32.installReadCallback(read_from_ram, (uint8_t *)base);
+    SHM_CHANNEL1.NcsiChannelReloadMaxTime.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelMac0High. */
     SHM_CHANNEL1.NcsiChannelMac0High.r32.installReadCallback(read_from_ram, (uint8_t *)base);
     SHM_CHANNEL1.NcsiChannelMac0High.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
@@ -148,11 +146,10 @@ void init_bcm5719_SHM_CHANNEL1_sim(void *base)
     SHM_CHANNEL1.NcsiChannelMac0Low.r32.installReadCallback(read_from_ram, (uint8_t *)base);
     SHM_CHANNEL1.NcsiChannelMac0Low.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
 
-    for(int i = 0; i < 1; i++)
-    {
-        SHM_CHANNEL1.reserved_64[i].installReadCallback(read_from_ram, (uint8_t *)base);
-        SHM_CHANNEL1.reserved_64[i].installWriteCallback(write_to_ram, (uint8_t *)base);
-    }
+    /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelReloadWrites. */
+    SHM_CHANNEL1.NcsiChannelReloadWrites.r32.installReadCallback(read_from_ram, (uint8_t *)base);
+    SHM_CHANNEL1.NcsiChannelReloadWrites.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelMac1High. */
     SHM_CHANNEL1.NcsiChannelMac1High.r32.installReadCallback(read_from_ram, (uint8_t *)base);
     SHM_CHANNEL1.NcsiChannelMac1High.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
@@ -165,11 +162,10 @@ void init_bcm5719_SHM_CHANNEL1_sim(void *base)
     SHM_CHANNEL1.NcsiChannelMac1Low.r32.installReadCallback(read_from_ram, (uint8_t *)base);
     SHM_CHANNEL1.NcsiChannelMac1Low.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
 
-    for(int i = 0; i < 1; i++)
-    {
-        SHM_CHANNEL1.reserved_80[i].installReadCallback(read_from_ram, (uint8_t *)base);
-        SHM_CHANNEL1.reserved_80[i].installWriteCallback(write_to_ram, (uint8_t *)base);
-    }
+    /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelMdioCacheHits. */
+    SHM_CHANNEL1.NcsiChannelMdioCacheHits.r32.installReadCallback(read_from_ram, (uint8_t *)base);
+    SHM_CHANNEL1.NcsiChannelMdioCacheHits.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelMac2High. */
     SHM_CHANNEL1.NcsiChannelMac2High.r32.installReadCallback(read_from_ram, (uint8_t *)base);
     SHM_CHANNEL1.NcsiChannelMac2High.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
@@ -182,11 +178,10 @@ void init_bcm5719_SHM_CHANNEL1_sim(void *base)
     SHM_CHANNEL1.NcsiChannelMac2Low.r32.installReadCallback(read_from_ram, (uint8_t *)base);
     SHM_CHANNEL1.NcsiChannelMac2Low.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
 
-    for(int i = 0; i < 1; i++)
-    {
-        SHM_CHANNEL1.reserved_96[i].installReadCallback(read_from_ram, (uint8_t *)base);
-        SHM_CHANNEL1.reserved_96[i].installWriteCallback(write_to_ram, (uint8_t *)base);
-    }
+    /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelMdioCacheMisses. */
+    SHM_CHANNEL1.NcsiChannelMdioCacheMisses.r32.installReadCallback(read_from_ram, (uint8_t *)base);
+    SHM_CHANNEL1.NcsiChannelMdioCacheMisses.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelMac3High. */
     SHM_CHANNEL1.NcsiChannelMac3High.r32.installReadCallback(read_from_ram, (uint8_t *)base);
     SHM_CHANNEL1.NcsiChannelMac3High.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
@@ -235,20 +230,34 @@ void init_bcm5719_SHM_CHANNEL1_sim(void *base)
     SHM_CHANNEL1.NcsiChannelSlink.r32.installReadCallback(read_from_ram, (uint8_t *)base);
     SHM_CHANNEL1.NcsiChannelSlink.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
 
-    for(int i = 0; i < 3; i++)
-    {
-        SHM_CHANNEL1.reserved_148[i].installReadCallback(read_from_ram, (uint8_t *)base);
-        SHM_CHANNEL1.reserved_148[i].installWriteCallback(write_to_ram, (uint8_t *)base);
-    }
+    /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelNcsiCommands. */
+    SHM_CHANNEL1.NcsiChannelNcsiCommands.r32.installReadCallback(read_from_ram, (uint8_t *)base);
+    SHM_CHANNEL1.NcsiChannelNcsiCommands.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+
+    /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelNcsiCommandErrors. */
+    SHM_CHANNEL1.NcsiChannelNcsiCommandErrors.r32.installReadCallback(read_from_ram, (uint8_t *)base);
+    SHM_CHANNEL1.NcsiChannelNcsiCommandErrors.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+
+    /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelAenTx. */
+    SHM_CHANNEL1.NcsiChannelAenTx.r32.installReadCallback(read_from_ram, (uint8_t *)base);
+    SHM_CHANNEL1.NcsiChannelAenTx.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelDbg. */
     SHM_CHANNEL1.NcsiChannelDbg.r32.installReadCallback(read_from_ram, (uint8_t *)base);
     SHM_CHANNEL1.NcsiChannelDbg.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
 
-    for(int i = 0; i < 3; i++)
-    {
-        SHM_CHANNEL1.reserved_164[i].installReadCallback(read_from_ram, (uint8_t *)base);
-        SHM_CHANNEL1.reserved_164[i].installWriteCallback(write_to_ram, (uint8_t *)base);
-    }
+    /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelNetworkDeferred. */
+    SHM_CHANNEL1.NcsiChannelNetworkDeferred.r32.installReadCallback(read_from_ram, (uint8_t *)base);
+    SHM_CHANNEL1.NcsiChannelNetworkDeferred.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+
+    /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelNetworkErrors. */
+    SHM_CHANNEL1.NcsiChannelNetworkErrors.r32.installReadCallback(read_from_ram, (uint8_t *)base);
+    SHM_CHANNEL1.NcsiChannelNetworkErrors.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+
+    /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelNcsiNoBlocks. */
+    SHM_CHANNEL1.NcsiChannelNcsiNoBlocks.r32.installReadCallback(read_from_ram, (uint8_t *)base);
+    SHM_CHANNEL1.NcsiChannelNcsiNoBlocks.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelNetworkRx. */
     SHM_CHANNEL1.NcsiChannelNetworkRx.r32.installReadCallback(read_from_ram, (uint8_t *)base);
     SHM_CHANNEL1.NcsiChannelNetworkRx.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
@@ -277,5 +286,36 @@ void init_bcm5719_SHM_CHANNEL1_sim(void *base)
     SHM_CHANNEL1.NcsiChannelAen.r32.installReadCallback(read_from_ram, (uint8_t *)base);
     SHM_CHANNEL1.NcsiChannelAen.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
 
+    /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelLinkDown. */
+    SHM_CHANNEL1.NcsiChannelLinkDown.r32.installReadCallback(read_from_ram, (uint8_t *)base);
+    SHM_CHANNEL1.NcsiChannelLinkDown.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+
+    /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelLinkRestarts. */
+    SHM_CHANNEL1.NcsiChannelLinkRestarts.r32.installReadCallback(read_from_ram, (uint8_t *)base);
+    SHM_CHANNEL1.NcsiChannelLinkRestarts.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+
+    /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelLinkReadvertise. */
+    SHM_CHANNEL1.NcsiChannelLinkReadvertise.r32.installReadCallback(read_from_ram, (uint8_t *)base);
+    SHM_CHANNEL1.NcsiChannelLinkReadvertise.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+
+    /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelLinkResets. */
+    SHM_CHANNEL1.NcsiChannelLinkResets.r32.installReadCallback(read_from_ram, (uint8_t *)base);
+    SHM_CHANNEL1.NcsiChannelLinkResets.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+
+    /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelLinkDownMaxTime. */
+    SHM_CHANNEL1.NcsiChannelLinkDownMaxTime.r32.installReadCallback(read_from_ram, (uint8_t *)base);
+    SHM_CHANNEL1.NcsiChannelLinkDownMaxTime.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+
+    /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelLinkDownHistogram. */
+    for(int i = 0; i < 6; i++)
+    {
+        SHM_CHANNEL1.NcsiChannelLinkDownHistogram[i].r32.installReadCallback(read_from_ram, (uint8_t *)base);
+        SHM_CHANNEL1.NcsiChannelLinkDownHistogram[i].r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    }
+
+    /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelNcsiCommandsDropped. */
+    SHM_CHANNEL1.NcsiChannelNcsiCommandsDropped.r32.installReadCallback(read_from_ram, (uint8_t *)base);
+    SHM_CHANNEL1.NcsiChannelNcsiCommandsDropped.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+
 
 }
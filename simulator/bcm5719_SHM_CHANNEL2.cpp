@@ -63,30 +63,40 @@ void init_bcm5719_SHM_CHANNEL2(void)
 
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelVlan. */
 
+    /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelReloadTime. */
+
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelAltHostMacHigh. */
 
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelAltHostMacMid. */
 
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelAltHostMacLow. */
 
+    /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelReloadMaxTime. */
+
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelMac0High. */
 
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelMac0Mid. */
 
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelMac0Low. */
 
+    /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelReloadWrites. */
+
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelMac1High. */
 
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelMac1Mid. */
 
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelMac1Low. */
 
+    /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelMdioCacheHits. */
+
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelMac2High. */
 
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelMac2Mid. */
 
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelMac2Low. */
 
+    /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelMdioCacheMisses. */
+
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelMac3High. */
 
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelMac3Mid. */
@@ -111,8 +121,20 @@ void init_bcm5719_SHM_CHANNEL2(void)
 
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelSlink. */
 
+    /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelNcsiCommands. */
+
+    /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelNcsiCommandErrors. */
+
+    /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelAenTx. */
+
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelDbg. */
 
+    /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelNetworkDeferred. */
+
+    /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelNetworkErrors. */
+
+    /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelNcsiNoBlocks. */
+
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelNetworkRx. */
 
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelNetworkTx. */
@@ -127,5 +149,19 @@ void init_bcm5719_SHM_CHANNEL2(void)
 
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelAen. */
 
+    /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelLinkDown. */
+
+    /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelLinkRestarts. */
+
+    /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelLinkReadvertise. */
+
+    /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelLinkResets. */
+
+    /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelLinkDownMaxTime. */
+
+    /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelLinkDownHistogram. */
+
+    /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelNcsiCommandsDropped. */
+
 
 }
@@ -143,10 +143,53 @@ void init_bcm5719_SHM_sim(void *base)
     SHM.LoaderArg1.r32.installReadCallback(read_from_ram, (uint8_t *)base);
     SHM.LoaderArg1.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
 
-    for(int i = 0; i < 47; i++)
+    /** @brief Bitmap for @ref SHM_t.DrainBudget. */
+    SHM.DrainBudget.r32.installReadCallback(read_from_ram, (uint8_t *)base);
+    SHM.DrainBudget.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+
+    /** @brief Bitmap for @ref SHM_t.DrainBmcExhausted. */
+    SHM.DrainBmcExhausted.r32.installReadCallback(read_from_ram, (uint8_t *)base);
+    SHM.DrainBmcExhausted.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+
+    /** @brief Bitmap for @ref SHM_t.DrainNetworkExhausted. */
+    SHM.DrainNetworkExhausted.r32.installReadCallback(read_from_ram, (uint8_t *)base);
+    SHM.DrainNetworkExhausted.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+
+    /** @brief Bitmap for @ref SHM_t.RmuFlowControl. */
+    SHM.RmuFlowControl.r32.installReadCallback(read_from_ram, (uint8_t *)base);
+    SHM.RmuFlowControl.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+
+    /** @brief Bitmap for @ref SHM_t.RmuRxBacklog. */
+    SHM.RmuRxBacklog.r32.installReadCallback(read_from_ram, (uint8_t *)base);
+    SHM.RmuRxBacklog.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+
+    /** @brief Bitmap for @ref SHM_t.RmuFlowAdjustments. */
+    SHM.RmuFlowAdjustments.r32.installReadCallback(read_from_ram, (uint8_t *)base);
+    SHM.RmuFlowAdjustments.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+
+    /** @brief Bitmap for @ref SHM_t.RmuTxFifoMinFree. */
+    SHM.RmuTxFifoMinFree.r32.installReadCallback(read_from_ram, (uint8_t *)base);
+    SHM.RmuTxFifoMinFree.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+
+    /** @brief Bitmap for @ref SHM_t.PowerPolicy. */
+    SHM.PowerPolicy.r32.installReadCallback(read_from_ram, (uint8_t *)base);
+    SHM.PowerPolicy.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+
+    /** @brief Bitmap for @ref SHM_t.PowerPolicySwitches. */
+    SHM.PowerPolicySwitches.r32.installReadCallback(read_from_ram, (uint8_t *)base);
+    SHM.PowerPolicySwitches.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+
+    /** @brief Bitmap for @ref SHM_t.PowerPolicyTime. */
+    for(int i = 0; i < 3; i++)
+    {
+        SHM.PowerPolicyTime[i].r32.installReadCallback(read_from_ram, (uint8_t *)base);
+        SHM.PowerPolicyTime[i].r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    }
+
+    for(int i = 0; i < 35; i++)
     {
-        SHM.reserved_68[i].installReadCallback(read_from_ram, (uint8_t *)base);
-        SHM.reserved_68[i].installWriteCallback(write_to_ram, (uint8_t *)base);
+        SHM.reserved_116[i].installReadCallback(read_from_ram, (uint8_t *)base);
+        SHM.reserved_116[i].installWriteCallback(write_to_ram, (uint8_t *)base);
     }
     /** @brief Bitmap for @ref SHM_t.RcpuSegSig. */
     SHM.RcpuSegSig.r32.installReadCallback(read_from_ram, (uint8_t *)base);
@@ -200,11 +243,36 @@ void init_bcm5719_SHM_sim(void *base)
     SHM.RcpuCpmuStatus.r32.installReadCallback(read_from_ram, (uint8_t *)base);
     SHM.RcpuCpmuStatus.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
 
-    for(int i = 0; i < 51; i++)
+    /** @brief Bitmap for @ref SHM_t.NcsiTraceIndex. */
+    SHM.NcsiTraceIndex.r32.installReadCallback(read_from_ram, (uint8_t *)base);
+    SHM.NcsiTraceIndex.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+
+    for(int i = 0; i < 2; i++)
+    {
+        SHM.reserved_312[i].installReadCallback(read_from_ram, (uint8_t *)base);
+        SHM.reserved_312[i].installWriteCallback(write_to_ram, (uint8_t *)base);
+    }
+    /** @brief Bitmap for @ref SHM_t.NcsiTraceCommand. */
+    for(int i = 0; i < 16; i++)
+    {
+        SHM.NcsiTraceCommand[i].r32.installReadCallback(read_from_ram, (uint8_t *)base);
+        SHM.NcsiTraceCommand[i].r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    }
+
+    /** @brief Bitmap for @ref SHM_t.NcsiTraceStart. */
+    for(int i = 0; i < 16; i++)
+    {
+        SHM.NcsiTraceStart[i].r32.installReadCallback(read_from_ram, (uint8_t *)base);
+        SHM.NcsiTraceStart[i].r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    }
+
+    /** @brief Bitmap for @ref SHM_t.NcsiTraceEnd. */
+    for(int i = 0; i < 16; i++)
     {
-        SHM.reserved_308[i].installReadCallback(read_from_ram, (uint8_t *)base);
-        SHM.reserved_308[i].installWriteCallback(write_to_ram, (uint8_t *)base);
+        SHM.NcsiTraceEnd[i].r32.installReadCallback(read_from_ram, (uint8_t *)base);
+        SHM.NcsiTraceEnd[i].r32.installWriteCallback(write_to_ram, (uint8_t *)base);
     }
+
     /** @brief Bitmap for @ref SHM_t.HostSegSig. */
     SHM.HostSegSig.r32.installReadCallback(read_from_ram, (uint8_t *)base);
     SHM.HostSegSig.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
@@ -0,0 +1,95 @@
+////////////////////////////////////////////////////////////////////////////////
+///
+/// @file       APEModel.hpp
+///
+/// @project
+///
+/// @brief      In-process model of the APE packet path
+///
+////////////////////////////////////////////////////////////////////////////////
+///
+////////////////////////////////////////////////////////////////////////////////
+///
+/// @copyright Copyright (c) 2020, Evan Lojewski
+/// @cond
+///
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+/// 1. Redistributions of source code must retain the above copyright notice,
+/// this list of conditions and the following disclaimer.
+/// 2. Redistributions in binary form must reproduce the above copyright notice,
+/// this list of conditions and the following disclaimer in the documentation
+/// and/or other materials provided with the distribution.
+/// 3. Neither the name of the copyright holder nor the
+/// names of its contributors may be used to endorse or promote products
+/// derived from this software without specific prior written permission.
+///
+////////////////////////////////////////////////////////////////////////////////
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+/// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+/// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+/// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+/// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+/// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+/// POSSIBILITY OF SUCH DAMAGE.
+/// @endcond
+////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef APE_MODEL_H
+#define APE_MODEL_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define APE_MODEL_PORTS (4)
+
+typedef struct
+{
+    /* Accesses to modelled registers and packet memory. SHM is plain RAM and is not counted. */
+    uint64_t reads;
+    uint64_t writes;
+
+    /* BMC to network */
+    uint64_t bmc_rx_frames;     /* Frames read out of the BMC RX fifo */
+    uint64_t network_tx_frames; /* Frames handed to a TX doorbell */
+    uint64_t network_tx_bytes;  /* Frame length words of the doorbelled frames */
+    uint64_t tx_alloc_failures; /* Allocator requests with an empty TX pool */
+
+    /* Network to BMC */
+    uint64_t network_rx_frames; /* RX frames marked as finished */
+    uint64_t bmc_tx_frames;     /* Frames closed in the BMC TX fifo */
+    uint64_t bmc_tx_bytes;
+
+    uint64_t errors; /* Register usage the hardware would not accept */
+} ape_model_stats_t;
+
+/**
+ * @fn void initAPEModel(void);
+ *
+ * @brief Backs the APE, SHM and port registers with host memory instead of a device.
+ *        The TX allocator and doorbell, the RX pool offset and retire registers and
+ *        the RMU fifos are modelled so that the firmware packet path runs unmodified.
+ *        Transmitted frames complete immediately and the BMC drains the RMU instantly.
+ */
+void initAPEModel(void);
+
+/* Queues a frame, without FCS, in the fifo from the BMC. */
+bool APEModel_queueBMCFrame(const uint8_t *frame, uint32_t length, bool passthrough);
+unsigned int APEModel_pendingBMCFrames(void);
+
+/* Writes a frame, without FCS, into the port's RX pool. Fails if the pool is full. */
+bool APEModel_queueNetworkFrame(unsigned int port, const uint8_t *frame, uint32_t length);
+unsigned int APEModel_pendingNetworkFrames(unsigned int port);
+
+void APEModel_getStats(ape_model_stats_t *stats);
+void APEModel_resetStats(void);
+
+#endif /* APE_MODEL_H */
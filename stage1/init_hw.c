@@ -493,13 +493,14 @@ void init_hw(volatile DEVICE_t *device)
     reportStatus(STATUS_INIT_HW, 0xf0);
 
     // Perform MII init.
-    APE_aquireLock();
+    uint8_t function = DEVICE.Status.bits.FunctionNumber;
+    APE_aquireLock(function);
     init_mii_function0(device);
 
     reportStatus(STATUS_INIT_HW, 0xfe);
 
     init_mii(device);
-    APE_releaseLock();
+    APE_releaseLock(function);
 
     RegDEVICEBufferManagerMode_t bmm;
     bmm.r32 = 0;
@@ -217,9 +217,9 @@ int main()
     {
         // Linux might not reconfigure the advertisement, so enable 1G mode now.
         // Note: The APE does this for NETWORK_PORT as needed.
-        APE_aquireLock();
+        APE_aquireLock(function);
         (void)MII_UpdateAdvertisement(&DEVICE, MII_getPhy(&DEVICE));
-        APE_releaseLock();
+        APE_releaseLock(function);
     }
 
     SHM.RcpuInitCount.r32 = SHM.RcpuInitCount.r32 + 1;
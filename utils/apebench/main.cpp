@@ -0,0 +1,422 @@
+////////////////////////////////////////////////////////////////////////////////
+///
+/// @file       main.cpp
+///
+/// @project
+///
+/// @brief      Host benchmark for the APE passthrough packet path.
+///
+////////////////////////////////////////////////////////////////////////////////
+///
+////////////////////////////////////////////////////////////////////////////////
+///
+/// @copyright Copyright (c) 2020, Evan Lojewski
+/// @cond
+///
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+/// 1. Redistributions of source code must retain the above copyright notice,
+/// this list of conditions and the following disclaimer.
+/// 2. Redistributions in binary form must reproduce the above copyright notice,
+/// this list of conditions and the following disclaimer in the documentation
+/// and/or other materials provided with the distribution.
+/// 3. Neither the name of the copyright holder nor the
+/// names of its contributors may be used to endorse or promote products
+/// derived from this software without specific prior written permission.
+///
+////////////////////////////////////////////////////////////////////////////////
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+/// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+/// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+/// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+/// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+/// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+/// POSSIBILITY OF SUCH DAMAGE.
+/// @endcond
+////////////////////////////////////////////////////////////////////////////////
+
+#include <APEModel.hpp>
+#include <APE_SHM.h>
+#include <NCSI.h>
+#include <Network.h>
+#include <OptionParser.h>
+#include <ape_main.h>
+#include <chrono>
+#include <fcntl.h>
+#include <fstream>
+#include <iostream>
+#include <stdint.h>
+#include <stdio.h>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+#define VERSION_STRING STRINGIFY(VERSION_MAJOR) "." STRINGIFY(VERSION_MINOR) "." STRINGIFY(VERSION_PATCH)
+
+#define PCAP_MAGIC         (0xa1b2c3d4)
+#define PCAP_MAGIC_NSEC    (0xa1b23c4d)
+#define PCAP_HEADER_SIZE   (24)
+#define PCAP_RECORD_SIZE   (16)
+#define PCAP_LINKTYPE_ETHERNET (1)
+
+#define BMC_MAX_FRAME   (0x7FF - 4) /* PacketLength is 11 bits and includes the FCS */
+#define BMC_QUEUE_DEPTH (32)      /* Frames kept pending in the BMC fifo */
+#define MAX_IDLE_PASSES (0x10000) /* Passes without progress before giving up */
+
+using namespace std;
+using optparse::OptionParser;
+
+typedef vector<uint8_t> frame_t;
+
+// The model has no RX CPUs to wait for after a reset.
+void wait_for_all_rx(void)
+{
+}
+
+static uint32_t swap32(uint32_t value, bool swap)
+{
+    return swap ? __builtin_bswap32(value) : value;
+}
+
+static bool loadPcap(const string &filename, vector<frame_t> &frames, uint32_t max_length)
+{
+    ifstream file(filename, ios::binary);
+    vector<uint8_t> data((istreambuf_iterator<char>(file)), istreambuf_iterator<char>());
+
+    if (!file.good() && !file.eof())
+    {
+        cerr << "Unable to read " << filename << endl;
+        return false;
+    }
+
+    if (data.size() < PCAP_HEADER_SIZE)
+    {
+        cerr << filename << " is not a pcap file." << endl;
+        return false;
+    }
+
+    uint32_t *header = (uint32_t *)data.data();
+    bool swap;
+    if (PCAP_MAGIC == header[0] || PCAP_MAGIC_NSEC == header[0])
+    {
+        swap = false;
+    }
+    else if (PCAP_MAGIC == __builtin_bswap32(header[0]) || PCAP_MAGIC_NSEC == __builtin_bswap32(header[0]))
+    {
+        swap = true;
+    }
+    else
+    {
+        cerr << filename << " is not a pcap file." << endl;
+        return false;
+    }
+
+    if (PCAP_LINKTYPE_ETHERNET != swap32(header[5], swap))
+    {
+        cerr << filename << " does not contain ethernet frames." << endl;
+        return false;
+    }
+
+    size_t offset = PCAP_HEADER_SIZE;
+    size_t skipped = 0;
+    while (offset + PCAP_RECORD_SIZE <= data.size())
+    {
+        uint32_t *record = (uint32_t *)&data[offset];
+        uint32_t captured = swap32(record[2], swap);
+        uint32_t original = swap32(record[3], swap);
+        offset += PCAP_RECORD_SIZE;
+
+        if (offset + captured > data.size())
+        {
+            break;
+        }
+
+        // Truncated captures can't be replayed, and the FCS is added by the model.
+        if (captured == original && captured <= max_length && captured)
+        {
+            frames.push_back(frame_t(&data[offset], &data[offset + captured]));
+        }
+        else
+        {
+            skipped++;
+        }
+
+        offset += captured;
+    }
+
+    if (skipped)
+    {
+        cerr << "Skipped " << skipped << " truncated or oversized frames." << endl;
+    }
+
+    return !frames.empty();
+}
+
+static void makeFrames(vector<frame_t> &frames, uint32_t length)
+{
+    frame_t frame(length);
+    for (uint32_t i = 0; i < length; i++)
+    {
+        frame[i] = (uint8_t)i;
+    }
+
+    // Broadcast from a locally administered address.
+    for (uint32_t i = 0; i < 6 && i < length; i++)
+    {
+        frame[i] = 0xFF;
+    }
+
+    frames.push_back(frame);
+}
+
+static int gStdout = -1;
+
+static void quiet(bool enable)
+{
+    fflush(stdout);
+    if (enable)
+    {
+        // The firmware's simulator debug output would dominate the run time.
+        int null = open("/dev/null", O_WRONLY);
+        gStdout = dup(STDOUT_FILENO);
+        dup2(null, STDOUT_FILENO);
+        close(null);
+    }
+    else if (gStdout >= 0)
+    {
+        dup2(gStdout, STDOUT_FILENO);
+        close(gStdout);
+        gStdout = -1;
+    }
+}
+
+static void report(const char *direction, uint64_t frames, uint64_t bytes, uint64_t expected_bytes, double seconds, const ape_model_stats_t &stats)
+{
+    double rate = seconds > 0 ? frames / seconds : 0;
+    double reads = frames ? (double)stats.reads / frames : 0;
+    double writes = frames ? (double)stats.writes / frames : 0;
+
+    cout << direction << ": " << frames << " frames, " << bytes << " bytes in " << seconds << " s" << endl;
+    cout << "    " << (uint64_t)rate << " frames/s, " << reads << " reads/frame, " << writes << " writes/frame" << endl;
+
+    if (stats.tx_alloc_failures)
+    {
+        cout << "    " << stats.tx_alloc_failures << " TX allocation failures" << endl;
+    }
+
+    if (bytes != expected_bytes)
+    {
+        cout << "    Expected " << expected_bytes << " bytes" << endl;
+    }
+}
+
+static bool benchBMCToNetwork(const vector<frame_t> &frames, uint64_t count, RegSHMDrainBudget_t budget, unsigned int ports, bool verbose)
+{
+    ape_model_stats_t stats;
+    uint64_t queued = 0;
+    uint64_t expected_bytes = 0;
+    unsigned int idle = 0;
+
+    APEModel_resetStats();
+    quiet(!verbose);
+
+    auto start = chrono::steady_clock::now();
+    do
+    {
+        while (queued < count && APEModel_pendingBMCFrames() < BMC_QUEUE_DEPTH)
+        {
+            const frame_t &frame = frames[queued++ % frames.size()];
+            (void)APEModel_queueBMCFrame(frame.data(), frame.size(), true);
+            expected_bytes += frame.size();
+        }
+
+        unsigned int pending = APEModel_pendingBMCFrames();
+        drainBMCPackets(budget);
+
+        for (unsigned int i = 0; i < ports; i++)
+        {
+            Network_TX_refillBlocks(Network_getPort(i));
+        }
+
+        idle = (pending == APEModel_pendingBMCFrames()) ? idle + 1 : 0;
+        APEModel_getStats(&stats);
+    } while (stats.bmc_rx_frames < count && idle < MAX_IDLE_PASSES);
+    auto end = chrono::steady_clock::now();
+
+    quiet(false);
+
+    report("BMC to network", stats.network_tx_frames, stats.network_tx_bytes, expected_bytes, chrono::duration<double>(end - start).count(), stats);
+
+    if (idle >= MAX_IDLE_PASSES)
+    {
+        cerr << "BMC fifo stopped draining." << endl;
+    }
+
+    return !stats.errors && idle < MAX_IDLE_PASSES && count == stats.network_tx_frames && expected_bytes == stats.network_tx_bytes;
+}
+
+static bool benchNetworkToBMC(const vector<frame_t> &frames, uint64_t count, RegSHMDrainBudget_t budget, unsigned int ports, bool verbose)
+{
+    ape_model_stats_t stats;
+    uint64_t queued = 0;
+    uint64_t expected_bytes = 0;
+    unsigned int idle = 0;
+
+    APEModel_resetStats();
+    quiet(!verbose);
+
+    auto start = chrono::steady_clock::now();
+    do
+    {
+        // Fill every port's RX pool, the firmware services them round robin.
+        bool queuing = true;
+        while (queued < count && queuing)
+        {
+            const frame_t &frame = frames[queued % frames.size()];
+            queuing = APEModel_queueNetworkFrame(queued % ports, frame.data(), frame.size());
+            if (queuing)
+            {
+                expected_bytes += frame.size();
+                queued++;
+            }
+        }
+
+        uint64_t delivered = stats.network_rx_frames;
+        drainNetworkPackets(budget);
+
+        APEModel_getStats(&stats);
+        idle = (delivered == stats.network_rx_frames) ? idle + 1 : 0;
+    } while (stats.network_rx_frames < count && idle < MAX_IDLE_PASSES);
+    auto end = chrono::steady_clock::now();
+
+    quiet(false);
+
+    report("Network to BMC", stats.bmc_tx_frames, stats.bmc_tx_bytes, expected_bytes, chrono::duration<double>(end - start).count(), stats);
+
+    if (idle >= MAX_IDLE_PASSES)
+    {
+        cerr << "RX pools stopped draining." << endl;
+    }
+
+    return !stats.errors && idle < MAX_IDLE_PASSES && count == stats.bmc_tx_frames && expected_bytes == stats.bmc_tx_bytes;
+}
+
+int main(int argc, char const *argv[])
+{
+    OptionParser parser = OptionParser().description("APE Packet Path Benchmark v" VERSION_STRING);
+
+    parser.version(VERSION_STRING);
+
+    parser.add_option("-n", "--frames").dest("frames").type("int").set_default("100000").metavar("FRAMES").help("Number of frames to send in each direction.");
+
+    parser.add_option("-s", "--size").dest("size").type("int").set_default("1514").metavar("BYTES").help("Frame size, without FCS, of the generated frames.");
+
+    parser.add_option("-p", "--pcap").dest("pcap").metavar("FILE").help("Replay the ethernet frames in the pcap file instead of generated frames.");
+
+    parser.add_option("-d", "--direction")
+        .dest("direction")
+        .set_default("both")
+        .help("Benchmark BMC to network (tx), network to BMC (rx) or both.");
+
+    parser.add_option("--ports").dest("ports").type("int").set_default("1").metavar("PORTS").help("Number of network ports receiving frames.");
+
+    parser.add_option("--budget-frames")
+        .dest("budget_frames")
+        .type("int")
+        .set_default("16")
+        .metavar("FRAMES")
+        .help("Frames handled per drain pass.");
+
+    parser.add_option("--budget-time")
+        .dest("budget_time")
+        .type("int")
+        .set_default("500")
+        .metavar("USEC")
+        .help("Time limit of each drain pass in microseconds.");
+
+    parser.add_option("-v", "--verbose").dest("verbose").action("store_true").set_default("0").help("Show the firmware debug output.");
+
+    optparse::Values options = parser.parse_args(argc, argv);
+
+    int count = (int)options.get("frames");
+    int ports = (int)options.get("ports");
+    string direction = options["direction"];
+    bool verbose = options.get("verbose");
+
+    if (count < 1 || ports < 1 || ports > APE_MODEL_PORTS)
+    {
+        cerr << "Invalid frame or port count." << endl;
+        exit(-1);
+    }
+
+    if ("tx" != direction && "rx" != direction && "both" != direction)
+    {
+        cerr << "Unknown direction " << direction << endl;
+        exit(-1);
+    }
+
+    // Both directions must fit the BMC fifo and the TX pool.
+    uint32_t max_length = MIN(Network_TX_maxFrameSize(), BMC_MAX_FRAME);
+    vector<frame_t> frames;
+    if (options.is_set("pcap"))
+    {
+        if (!loadPcap(options["pcap"], frames, max_length))
+        {
+            exit(-1);
+        }
+    }
+    else
+    {
+        int size = (int)options.get("size");
+        if (size < 1 || (uint32_t)size > max_length)
+        {
+            cerr << "Frame size must be between 1 and " << max_length << " bytes." << endl;
+            exit(-1);
+        }
+        makeFrames(frames, size);
+    }
+
+    initAPEModel();
+
+    for (int i = 0; i < ports; i++)
+    {
+        NetworkPort_t *port = Network_getPort(i);
+        NCSI_usePort(port);
+
+        // Set the fields individually, the firmware copies the register and reads the cached bit values.
+        port->shm_channel->NcsiChannelInfo.bits.Enabled = 1;
+        port->shm_channel->NcsiChannelInfo.bits.Ready = 1;
+        port->shm_channel->NcsiChannelInfo.bits.TXPassthrough = (0 == i);
+    }
+
+    RegSHMDrainBudget_t budget;
+    budget.r32 = 0;
+    budget.bits.Frames = (int)options.get("budget_frames");
+    budget.bits.Time = (int)options.get("budget_time");
+
+    bool passed = true;
+    if ("rx" != direction)
+    {
+        passed &= benchBMCToNetwork(frames, count, budget, ports, verbose);
+    }
+
+    if ("tx" != direction)
+    {
+        passed &= benchNetworkToBMC(frames, count, budget, ports, verbose);
+    }
+
+    if (!passed)
+    {
+        cerr << "Packet path validation failed." << endl;
+        exit(-1);
+    }
+
+    return 0;
+}
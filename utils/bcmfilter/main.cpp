@@ -0,0 +1,711 @@
+////////////////////////////////////////////////////////////////////////////////
+///
+/// @file       main.cpp
+///
+/// @project
+///
+/// @brief      Compiles RX filter descriptions into NVM filter tables.
+///
+////////////////////////////////////////////////////////////////////////////////
+///
+////////////////////////////////////////////////////////////////////////////////
+///
+/// @copyright Copyright (c) 2020, Evan Lojewski
+/// @cond
+///
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+/// 1. Redistributions of source code must retain the above copyright notice,
+/// this list of conditions and the following disclaimer.
+/// 2. Redistributions in binary form must reproduce the above copyright notice,
+/// this list of conditions and the following disclaimer in the documentation
+/// and/or other materials provided with the distribution.
+/// 3. Neither the name of the copyright holder nor the
+/// names of its contributors may be used to endorse or promote products
+/// derived from this software without specific prior written permission.
+///
+////////////////////////////////////////////////////////////////////////////////
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+/// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+/// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+/// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+/// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+/// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+/// POSSIBILITY OF SUCH DAMAGE.
+/// @endcond
+////////////////////////////////////////////////////////////////////////////////
+
+#include <APE_FILTERS0.h>
+#include <NVRam.h>
+#include <NetworkFilters.h>
+#include <OptionParser.h>
+#include <bcm5719-endian.h>
+#include <bcm5719_eeprom.h>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+
+#define VERSION_STRING STRINGIFY(VERSION_MAJOR) "." STRINGIFY(VERSION_MINOR) "." STRINGIFY(VERSION_PATCH)
+
+/*
+ * Filter descriptions are line based, '#' starts a comment:
+ *
+ *  flags ncsi
+ *      The table keeps the NC-SI slot layout from NetworkFilters.h, the
+ *      firmware enables those elements and rule sets based on the NC-SI
+ *      filter commands.
+ *
+ *  element <n> [name=<name>] header=<header> [op=<op>] pattern=<value>[/<mask>]
+ *          [offset=<bytes>] [class=<n>] [and] [map] [discard] [p1] [p2] [p3] [enable]
+ *      Element n (0-31). header is one of sof, ip, tcp, udp, data, icmpv4,
+ *      icmpv6 or vlan, op is one of eq (default), ne, gt or lt. A value/mask
+ *      pattern compares the 16 bit value under the 16 bit mask, otherwise the
+ *      whole 32 bit word is compared. 'and' chains the element with element n+1.
+ *
+ *  rule <n> action=<action> match=<element>[&<element>...][|<element>...] [count=<n>] [enable]
+ *      Rule set S-n (1-31). action is one of to_ape, to_ape_and_host or
+ *      discard. A rule set matches when all of its elements match; each '|'
+ *      alternative is placed in the next rule set with the same action.
+ */
+
+using namespace std;
+using optparse::OptionParser;
+
+typedef struct
+{
+    bool defined;
+    string name;
+    int line;
+    uint32_t config;
+    uint32_t pattern;
+} element_t;
+
+typedef struct
+{
+    bool defined;
+    int line;
+    uint32_t set;
+    uint32_t mask;
+} rule_t;
+
+static const char *gHeaders[] = {"sof", "ip", "tcp", "udp", "data", "icmpv4", "icmpv6", "vlan"};
+static const char *gOps[] = {"eq", "ne", "gt", "lt"};
+static const char *gActions[] = {"to_ape", "to_ape_and_host", "discard"};
+
+static string gFilename;
+static int gErrors;
+
+static element_t gElements[NETWORK_FILTER_NUM_ELEMENTS];
+static rule_t gRules[NETWORK_FILTER_NUM_RULES + 1]; /* Indexed by rule set number, [0] is unused */
+static uint32_t gFlags;
+
+static void error(int line, const string &message)
+{
+    cerr << gFilename << ":" << line << ": error: " << message << endl;
+    gErrors++;
+}
+
+static void warning(int line, const string &message)
+{
+    cerr << gFilename << ":" << line << ": warning: " << message << endl;
+}
+
+static bool parse_number(const string &str, uint32_t max, uint32_t *value)
+{
+    char *end = NULL;
+    unsigned long long parsed = strtoull(str.c_str(), &end, 0);
+    if (str.empty() || *end || parsed > max)
+    {
+        return false;
+    }
+
+    *value = (uint32_t)parsed;
+    return true;
+}
+
+static int lookup(const string &str, const char *names[], size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        if (str == names[i])
+        {
+            return (int)i;
+        }
+    }
+
+    return -1;
+}
+
+static int find_element(const string &str)
+{
+    uint32_t index;
+    if (parse_number(str, NETWORK_FILTER_NUM_ELEMENTS - 1, &index))
+    {
+        return gElements[index].defined ? (int)index : -1;
+    }
+
+    for (size_t i = 0; i < NETWORK_FILTER_NUM_ELEMENTS; i++)
+    {
+        if (gElements[i].defined && gElements[i].name == str)
+        {
+            return (int)i;
+        }
+    }
+
+    return -1;
+}
+
+static vector<string> split(const string &str, char sep)
+{
+    vector<string> parts;
+    stringstream stream(str);
+    string part;
+    while (getline(stream, part, sep))
+    {
+        parts.push_back(part);
+    }
+
+    return parts;
+}
+
+static void parse_element(int line, const vector<string> &tokens)
+{
+    uint32_t index;
+    if (tokens.size() < 2 || !parse_number(tokens[1], NETWORK_FILTER_NUM_ELEMENTS - 1, &index))
+    {
+        error(line, "expected an element number from 0 to 31");
+        return;
+    }
+
+    element_t *element = &gElements[index];
+    if (element->defined)
+    {
+        error(line, "element " + tokens[1] + " was already defined on line " + to_string(element->line));
+        return;
+    }
+
+    bool have_header = false;
+    bool have_pattern = false;
+    element->defined = true;
+    element->line = line;
+    element->config = 0;
+    element->pattern = 0;
+
+    for (size_t i = 2; i < tokens.size(); i++)
+    {
+        size_t eq = tokens[i].find('=');
+        string key = tokens[i].substr(0, eq);
+        string value = (eq == string::npos) ? "" : tokens[i].substr(eq + 1);
+        uint32_t number;
+        int found;
+
+        if ("name" == key && !value.empty())
+        {
+            if (parse_number(value, UINT32_MAX, &number) || find_element(value) >= 0)
+            {
+                error(line, "element name '" + value + "' is a number or already in use");
+            }
+            element->name = value;
+        }
+        else if ("header" == key && (found = lookup(value, gHeaders, ARRAY_ELEMENTS(gHeaders))) >= 0)
+        {
+            element->config |= SET_FILTERS0_ELEMENT_CONFIG_RULE_HEADER((uint32_t)found);
+            have_header = true;
+        }
+        else if ("op" == key && (found = lookup(value, gOps, ARRAY_ELEMENTS(gOps))) >= 0)
+        {
+            element->config |= SET_FILTERS0_ELEMENT_CONFIG_RULE_OP((uint32_t)found);
+        }
+        else if ("offset" == key && parse_number(value, GET_FILTERS0_ELEMENT_CONFIG_RULE_OFFSET(~0u), &number))
+        {
+            element->config |= SET_FILTERS0_ELEMENT_CONFIG_RULE_OFFSET(number);
+        }
+        else if ("class" == key && parse_number(value, GET_FILTERS0_ELEMENT_CONFIG_RULE_CLASS(~0u), &number))
+        {
+            element->config |= SET_FILTERS0_ELEMENT_CONFIG_RULE_CLASS(number);
+        }
+        else if ("pattern" == key)
+        {
+            vector<string> parts = split(value, '/');
+            uint32_t mask;
+            if (1 == parts.size() && parse_number(parts[0], UINT32_MAX, &number))
+            {
+                element->pattern = number;
+            }
+            else if (2 == parts.size() && parse_number(parts[0], 0xFFFF, &number) && parse_number(parts[1], 0xFFFF, &mask))
+            {
+                element->pattern = (number << 16) | mask;
+                element->config |= SET_FILTERS0_ELEMENT_CONFIG_RULE_MASK(1);
+                if (number & ~mask)
+                {
+                    warning(line, "pattern value has bits outside of the mask");
+                }
+            }
+            else
+            {
+                error(line, "invalid pattern '" + value + "', expected a 32 bit value or a 16 bit value/mask");
+            }
+            have_pattern = true;
+        }
+        else if ("and" == tokens[i])
+        {
+            element->config |= SET_FILTERS0_ELEMENT_CONFIG_RULE_AND(1);
+        }
+        else if ("map" == tokens[i])
+        {
+            element->config |= SET_FILTERS0_ELEMENT_CONFIG_RULE_MAP(1);
+        }
+        else if ("discard" == tokens[i])
+        {
+            element->config |= SET_FILTERS0_ELEMENT_CONFIG_RULE_DISCARD(1);
+        }
+        else if ("p1" == tokens[i])
+        {
+            element->config |= SET_FILTERS0_ELEMENT_CONFIG_RULE_P1(1);
+        }
+        else if ("p2" == tokens[i])
+        {
+            element->config |= SET_FILTERS0_ELEMENT_CONFIG_RULE_P2(1);
+        }
+        else if ("p3" == tokens[i])
+        {
+            element->config |= SET_FILTERS0_ELEMENT_CONFIG_RULE_P3(1);
+        }
+        else if ("enable" == tokens[i])
+        {
+            element->config |= SET_FILTERS0_ELEMENT_CONFIG_RULE_ENABLE(1);
+        }
+        else
+        {
+            error(line, "unknown or invalid element option '" + tokens[i] + "'");
+        }
+    }
+
+    if (!have_header || !have_pattern)
+    {
+        error(line, "element " + tokens[1] + " needs a header and a pattern");
+    }
+}
+
+static void parse_rule(int line, const vector<string> &tokens)
+{
+    uint32_t index;
+    if (tokens.size() < 2 || !parse_number(tokens[1], NETWORK_FILTER_NUM_RULES, &index) || !index)
+    {
+        error(line, "expected a rule set number from 1 to 31");
+        return;
+    }
+
+    uint32_t set = 0;
+    bool have_action = false;
+    vector<string> alternatives;
+
+    for (size_t i = 2; i < tokens.size(); i++)
+    {
+        size_t eq = tokens[i].find('=');
+        string key = tokens[i].substr(0, eq);
+        string value = (eq == string::npos) ? "" : tokens[i].substr(eq + 1);
+        uint32_t number;
+        int found;
+
+        if ("action" == key && (found = lookup(value, gActions, ARRAY_ELEMENTS(gActions))) >= 0)
+        {
+            set |= SET_FILTERS0_RULE_SET_ACTION((uint32_t)found);
+            have_action = true;
+        }
+        else if ("count" == key && parse_number(value, GET_FILTERS0_RULE_SET_COUNT(~0u), &number))
+        {
+            set |= SET_FILTERS0_RULE_SET_COUNT(number);
+        }
+        else if ("match" == key && !value.empty())
+        {
+            alternatives = split(value, '|');
+        }
+        else if ("enable" == tokens[i])
+        {
+            set |= SET_FILTERS0_RULE_SET_ENABLE(1);
+        }
+        else
+        {
+            error(line, "unknown or invalid rule option '" + tokens[i] + "'");
+        }
+    }
+
+    if (!have_action || alternatives.empty())
+    {
+        error(line, "rule set " + tokens[1] + " needs an action and a match");
+        return;
+    }
+
+    for (const string &alternative : alternatives)
+    {
+        if (index > NETWORK_FILTER_NUM_RULES)
+        {
+            error(line, "'|' alternatives run past rule set S-31");
+            return;
+        }
+
+        rule_t *rule = &gRules[index];
+        if (rule->defined)
+        {
+            error(line, "rule set S-" + to_string(index) + " was already defined on line " + to_string(rule->line));
+            return;
+        }
+
+        rule->defined = true;
+        rule->line = line;
+        rule->set = set;
+        rule->mask = 0;
+        for (const string &name : split(alternative, '&'))
+        {
+            int element = find_element(name);
+            if (element < 0)
+            {
+                error(line, "unknown element '" + name + "', elements must be defined before use");
+            }
+            else
+            {
+                rule->mask |= (1u << element);
+            }
+        }
+
+        index++;
+    }
+}
+
+static void check_table(void)
+{
+    uint32_t ncsi_elements = (gFlags & NETWORK_FILTER_FLAG_NCSI) ? FILTER_NCSI_ELEMENTS : 0;
+    uint32_t ncsi_rules = (gFlags & NETWORK_FILTER_FLAG_NCSI) ? FILTER_NCSI_RULES : 0;
+    uint32_t used = 0;
+
+    for (uint32_t i = 0; i < NETWORK_FILTER_NUM_ELEMENTS; i++)
+    {
+        const element_t *element = &gElements[i];
+        if (!element->defined || !GET_FILTERS0_ELEMENT_CONFIG_RULE_AND(element->config))
+        {
+            continue;
+        }
+
+        // AND chains continue with the next element, which has to exist and be enabled with it.
+        if (NETWORK_FILTER_NUM_ELEMENTS - 1 == i || !gElements[i + 1].defined)
+        {
+            error(element->line, "element " + to_string(i) + " is chained with an undefined element");
+        }
+        else if (GET_FILTERS0_ELEMENT_CONFIG_RULE_ENABLE(element->config) && !GET_FILTERS0_ELEMENT_CONFIG_RULE_ENABLE(gElements[i + 1].config) &&
+                 !(ncsi_elements & (1u << (i + 1))))
+        {
+            error(element->line, "element " + to_string(i) + " is chained with disabled element " + to_string(i + 1));
+        }
+    }
+
+    for (uint32_t i = 1; i <= NETWORK_FILTER_NUM_RULES; i++)
+    {
+        const rule_t *rule = &gRules[i];
+        if (!rule->defined)
+        {
+            continue;
+        }
+
+        used |= rule->mask;
+        if (!GET_FILTERS0_RULE_SET_ENABLE(rule->set) && !(ncsi_rules & (1u << i)))
+        {
+            continue;
+        }
+
+        for (uint32_t j = 0; j < NETWORK_FILTER_NUM_ELEMENTS; j++)
+        {
+            if ((rule->mask & (1u << j)) && !GET_FILTERS0_ELEMENT_CONFIG_RULE_ENABLE(gElements[j].config) && !(ncsi_elements & (1u << j)))
+            {
+                warning(rule->line, "rule set S-" + to_string(i) + " uses disabled element " + to_string(j));
+            }
+        }
+    }
+
+    for (uint32_t i = 0; i < NETWORK_FILTER_NUM_ELEMENTS; i++)
+    {
+        const element_t *element = &gElements[i];
+        bool chained = i && GET_FILTERS0_ELEMENT_CONFIG_RULE_AND(gElements[i - 1].config);
+        if (element->defined && GET_FILTERS0_ELEMENT_CONFIG_RULE_ENABLE(element->config) && !(used & (1u << i)) && !chained)
+        {
+            warning(element->line, "element " + to_string(i) + " is enabled but not used by any rule set");
+        }
+    }
+}
+
+static bool parse_file(const string &filename)
+{
+    ifstream in(filename);
+    if (!in)
+    {
+        cerr << "Unable to open " << filename << " for reading." << endl;
+        return false;
+    }
+
+    gFilename = filename;
+    string text;
+    int line = 0;
+    while (getline(in, text))
+    {
+        line++;
+        text = text.substr(0, text.find('#'));
+
+        vector<string> tokens;
+        stringstream stream(text);
+        string token;
+        while (stream >> token)
+        {
+            tokens.push_back(token);
+        }
+
+        if (tokens.empty())
+        {
+            continue;
+        }
+        else if ("element" == tokens[0])
+        {
+            parse_element(line, tokens);
+        }
+        else if ("rule" == tokens[0])
+        {
+            parse_rule(line, tokens);
+        }
+        else if ("flags" == tokens[0] && 2 == tokens.size() && "ncsi" == tokens[1])
+        {
+            gFlags |= NETWORK_FILTER_FLAG_NCSI;
+        }
+        else
+        {
+            error(line, "unknown statement '" + tokens[0] + "'");
+        }
+    }
+
+    check_table();
+
+    return 0 == gErrors;
+}
+
+static void build_table(NetworkFilterTable_t *table)
+{
+    table->magic = NETWORK_FILTER_MAGIC;
+    table->version = NETWORK_FILTER_VERSION;
+    table->flags = gFlags;
+
+    for (size_t i = 0; i < NETWORK_FILTER_NUM_ELEMENTS; i++)
+    {
+        table->element_config[i] = gElements[i].config;
+        table->element_pattern[i] = gElements[i].pattern;
+    }
+
+    for (size_t i = 0; i < NETWORK_FILTER_NUM_RULES; i++)
+    {
+        table->rule_set[i] = gRules[i + 1].set;
+        table->rule_mask[i] = gRules[i + 1].mask;
+    }
+}
+
+static void print_table(const NetworkFilterTable_t *table)
+{
+    if (table->flags & NETWORK_FILTER_FLAG_NCSI)
+    {
+        printf("flags ncsi\n");
+    }
+
+    uint32_t used = 0;
+    for (size_t i = 0; i < NETWORK_FILTER_NUM_RULES; i++)
+    {
+        used |= table->rule_mask[i];
+    }
+
+    for (size_t i = 0; i < NETWORK_FILTER_NUM_ELEMENTS; i++)
+    {
+        uint32_t config = table->element_config[i];
+        uint32_t pattern = table->element_pattern[i];
+        if (!config && !pattern && !(used & (1u << i)))
+        {
+            continue;
+        }
+
+        printf("element %zu header=%s op=%s", i, gHeaders[GET_FILTERS0_ELEMENT_CONFIG_RULE_HEADER(config)], gOps[GET_FILTERS0_ELEMENT_CONFIG_RULE_OP(config)]);
+        if (GET_FILTERS0_ELEMENT_CONFIG_RULE_MASK(config))
+        {
+            printf(" pattern=0x%04X/0x%04X", pattern >> 16, pattern & 0xFFFF);
+        }
+        else
+        {
+            printf(" pattern=0x%08X", pattern);
+        }
+        printf(" offset=%u", GET_FILTERS0_ELEMENT_CONFIG_RULE_OFFSET(config));
+        if (GET_FILTERS0_ELEMENT_CONFIG_RULE_CLASS(config))
+        {
+            printf(" class=%u", GET_FILTERS0_ELEMENT_CONFIG_RULE_CLASS(config));
+        }
+        printf("%s%s%s%s%s%s%s\n", GET_FILTERS0_ELEMENT_CONFIG_RULE_AND(config) ? " and" : "", GET_FILTERS0_ELEMENT_CONFIG_RULE_MAP(config) ? " map" : "",
+               GET_FILTERS0_ELEMENT_CONFIG_RULE_DISCARD(config) ? " discard" : "", GET_FILTERS0_ELEMENT_CONFIG_RULE_P1(config) ? " p1" : "",
+               GET_FILTERS0_ELEMENT_CONFIG_RULE_P2(config) ? " p2" : "", GET_FILTERS0_ELEMENT_CONFIG_RULE_P3(config) ? " p3" : "",
+               GET_FILTERS0_ELEMENT_CONFIG_RULE_ENABLE(config) ? " enable" : "");
+    }
+
+    for (size_t i = 0; i < NETWORK_FILTER_NUM_RULES; i++)
+    {
+        uint32_t set = table->rule_set[i];
+        uint32_t mask = table->rule_mask[i];
+        uint32_t action = GET_FILTERS0_RULE_SET_ACTION(set);
+        if (!mask)
+        {
+            continue;
+        }
+
+        printf("rule %zu action=%s match=", i + 1, action < ARRAY_ELEMENTS(gActions) ? gActions[action] : "invalid");
+        const char *sep = "";
+        for (uint32_t j = 0; j < NETWORK_FILTER_NUM_ELEMENTS; j++)
+        {
+            if (mask & (1u << j))
+            {
+                printf("%s%u", sep, j);
+                sep = "&";
+            }
+        }
+        if (GET_FILTERS0_RULE_SET_COUNT(set))
+        {
+            printf(" count=%u", GET_FILTERS0_RULE_SET_COUNT(set));
+        }
+        printf("%s\n", GET_FILTERS0_RULE_SET_ENABLE(set) ? " enable" : "");
+    }
+}
+
+static uint32_t table_crc(const uint32_t *be_words, size_t words)
+{
+    // Stored like the other code directory entries, see bcmflash.
+    return ~NVRam_crc((const uint8_t *)be_words, words * sizeof(uint32_t), 0xffffffff);
+}
+
+static bool save_table(const char *filename, const NetworkFilterTable_t *table)
+{
+    uint32_t words[NETWORK_FILTER_TABLE_WORDS];
+    const uint32_t *native = (const uint32_t *)table;
+    for (size_t i = 0; i < NETWORK_FILTER_TABLE_WORDS - 1; i++)
+    {
+        words[i] = htobe32(native[i]);
+    }
+    words[NETWORK_FILTER_TABLE_WORDS - 1] = htole32(table_crc(words, NETWORK_FILTER_TABLE_WORDS - 1));
+
+    FILE *out = fopen(filename, "w+");
+    if (!out)
+    {
+        cerr << "Unable to open " << filename << " for writing." << endl;
+        return false;
+    }
+
+    fwrite(words, sizeof(words), 1, out);
+    fclose(out);
+
+    cout << "Wrote " << sizeof(words) << " bytes to " << filename << ", code directory info 0x" << hex
+         << BCM_CODE_DIRECTORY_SET_TYPE(BCM_CODE_DIRECTORY_SET_CPU(NETWORK_FILTER_TABLE_WORDS, BCM_CODE_DIRECTORY_CPU_APE), BCM_CODE_DIRECTORY_TYPE_USER_BLOCK)
+         << dec << "." << endl;
+    return true;
+}
+
+static bool load_table(const char *filename, NetworkFilterTable_t *table)
+{
+    uint32_t words[NETWORK_FILTER_TABLE_WORDS];
+    FILE *in = fopen(filename, "r");
+    if (!in)
+    {
+        cerr << "Unable to open " << filename << " for reading." << endl;
+        return false;
+    }
+
+    size_t read = fread(words, 1, sizeof(words), in);
+    fclose(in);
+
+    uint32_t *native = (uint32_t *)table;
+    for (size_t i = 0; i < NETWORK_FILTER_TABLE_WORDS - 1; i++)
+    {
+        native[i] = be32toh(words[i]);
+    }
+
+    if (sizeof(words) != read || NETWORK_FILTER_MAGIC != table->magic || NETWORK_FILTER_VERSION != table->version)
+    {
+        cerr << filename << " is not a version " << NETWORK_FILTER_VERSION << " filter table." << endl;
+        return false;
+    }
+
+    if (le32toh(words[NETWORK_FILTER_TABLE_WORDS - 1]) != table_crc(words, NETWORK_FILTER_TABLE_WORDS - 1))
+    {
+        cerr << filename << " has an invalid CRC." << endl;
+        return false;
+    }
+
+    return true;
+}
+
+int main(int argc, char const *argv[])
+{
+    NetworkFilterTable_t table;
+
+    OptionParser parser = OptionParser().description("BCM RX Filter Compiler v" VERSION_STRING);
+
+    parser.version(VERSION_STRING);
+
+    parser.add_option("-i", "--input").dest("input").help("Filter description to compile").metavar("FILE");
+
+    parser.add_option("-o", "--output").dest("output").help("Output filter table").metavar("OUTPUT");
+
+    parser.add_option("-d", "--decode").dest("decode").help("Print the description of a compiled filter table").metavar("TABLE");
+
+    optparse::Values options = parser.parse_args(argc, argv);
+
+    if (options.is_set("decode"))
+    {
+        if (!load_table(options["decode"].c_str(), &table))
+        {
+            exit(-1);
+        }
+
+        print_table(&table);
+        exit(0);
+    }
+
+    if (!options.is_set("input"))
+    {
+        cerr << "Please specify a filter description to compile." << endl;
+        parser.print_help();
+        exit(-1);
+    }
+
+    if (!parse_file(options["input"]))
+    {
+        cerr << gErrors << " error(s), no filter table written." << endl;
+        exit(-1);
+    }
+
+    build_table(&table);
+
+    if (options.is_set("output"))
+    {
+        if (!save_table(options["output"].c_str(), &table))
+        {
+            exit(-1);
+        }
+    }
+    else
+    {
+        print_table(&table);
+    }
+
+    return 0;
+}
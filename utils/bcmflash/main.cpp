@@ -50,6 +50,7 @@
 
 #include <../bcm5719_NVM.h>
 #include <NVRam.h>
+#include <NetworkFilters.h>
 #include <OptionParser.h>
 #include <bcm5719-endian.h>
 #include <bcm5719_DEVICE.h>
@@ -281,6 +282,98 @@ bool set_mac(uint32_t dest[2], const char *mac_str)
     return true;
 }
 
+bool install_filters(const char *filename, NVRAMContents_t *contents, uint8_t *nvram, uint32_t free_offset, uint32_t *nvram_size, bool grow)
+{
+    uint32_t words[NETWORK_FILTER_TABLE_WORDS];
+    uint32_t length = sizeof(words);
+
+    if (length != bcmflash_file_size(filename) || !bcmflash_file_read(filename, words, length))
+    {
+        cerr << "Unable to read a filter table from '" << filename << "'." << endl;
+        return false;
+    }
+
+    // Same checks as bcmfilter -d.
+    if (NETWORK_FILTER_MAGIC != be32toh(words[0]) || NETWORK_FILTER_VERSION != be32toh(words[1]) ||
+        le32toh(words[NETWORK_FILTER_TABLE_WORDS - 1]) != ~NVRam_crc((uint8_t *)words, length - sizeof(uint32_t), 0xffffffff))
+    {
+        cerr << "'" << filename << "' is not a valid filter table." << endl;
+        return false;
+    }
+
+    uint32_t info = 0;
+    info = BCM_CODE_DIRECTORY_SET_LENGTH(info, NETWORK_FILTER_TABLE_WORDS);
+    info = BCM_CODE_DIRECTORY_SET_CPU(info, BCM_CODE_DIRECTORY_CPU_APE);
+    info = BCM_CODE_DIRECTORY_SET_TYPE(info, BCM_CODE_DIRECTORY_TYPE_USER_BLOCK);
+
+    // Replace an existing table in place, otherwise use the first free directory entry.
+    NVRAMCodeDirectory_t *cd = NULL;
+    for (size_t i = 0; i < ARRAY_ELEMENTS(contents->directory); i++)
+    {
+        NVRAMCodeDirectory_t *entry = &contents->directory[i];
+        uint32_t entry_info = be32toh(entry->codeInfo);
+        if (info == entry_info)
+        {
+            cd = entry;
+            break;
+        }
+        else if (!entry_info && !cd)
+        {
+            cd = entry;
+        }
+        else if (entry_info)
+        {
+            // New entries go after everything already in use.
+            uint32_t end = be32toh(entry->directoryOffset) + BCM_CODE_DIRECTORY_GET_LENGTH(entry_info) * sizeof(uint32_t);
+            free_offset = MAX(free_offset, end);
+        }
+    }
+
+    if (!cd)
+    {
+        cerr << "No free code directory entry for the filter table." << endl;
+        return false;
+    }
+
+    uint32_t offset;
+    if (info == be32toh(cd->codeInfo))
+    {
+        offset = be32toh(cd->directoryOffset);
+    }
+    else
+    {
+        offset = DIVIDE_RND_UP(free_offset, sizeof(uint32_t)) * sizeof(uint32_t);
+        if (grow && offset + length <= MAX_NVRAM_SIZE)
+        {
+            *nvram_size = MAX(*nvram_size, offset + length);
+        }
+
+        if (offset + length > *nvram_size)
+        {
+            cerr << "The filter table does not fit in the NVM." << endl;
+            return false;
+        }
+
+        for (uint32_t i = 0; i < length; i++)
+        {
+            if (0xFF != nvram[offset + i])
+            {
+                cerr << "The NVM is not erased at 0x" << hex << offset + i << dec << ", unable to add the filter table." << endl;
+                return false;
+            }
+        }
+    }
+
+    printf("Installing filter table from %s at 0x%08X\n", filename, offset);
+    memcpy(&nvram[offset], words, length);
+
+    cd->codeInfo = htobe32(info);
+    cd->codeAddress = htobe32(0);
+    cd->directoryOffset = htobe32(offset);
+
+    return true;
+}
+
 void dump_info(NVRAMInfo_t *info, NVRAMInfo2_t *info2)
 {
     RegGENGenCfgHw_t hw;
@@ -530,6 +623,8 @@ int main(int argc, char const *argv[])
 
     parser.add_option("-a", "--ape").dest("ape").help("Update the target with the specified ape image, if possible.").metavar("APE");
 
+    parser.add_option("-f", "--filters").dest("filters").help("Add or replace the RX filter table built with bcmfilter.").metavar("FILTERS");
+
     parser.add_option("-u", "--unlock")
         .dest("unlock")
         .action("store_true")
@@ -840,6 +935,17 @@ int main(int argc, char const *argv[])
         }
     }
 
+    if (options.is_set("filters"))
+    {
+        uint32_t stage2_end = (uint8_t *)stage2->words - nvram.bytes + be32toh(stage2->header.length);
+        if (!install_filters(options["filters"].c_str(), &nvram.contents, nvram.bytes, stage2_end, &nvram_size, options.is_set("create")))
+        {
+            exit(-1);
+        }
+
+        should_write = true;
+    }
+
     for (size_t i = 0; i < ARRAY_ELEMENTS(mac_table); i++)
     {
         if (options.is_set(mac_table[i].option))
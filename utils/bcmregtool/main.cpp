@@ -58,13 +58,17 @@
 #include <bcm5719_SHM.h>
 #include <bcm5719_SHM_CHANNEL0.h>
 #include <bcm5719_SHM_CHANNEL1.h>
+#include <bcm5719_SHM_CHANNEL2.h>
+#include <bcm5719_SHM_CHANNEL3.h>
 #include <bcm5719_eeprom.h>
 #include <elfio/elfio.hpp>
 #include <iostream>
+#include <map>
 #include <stdbool.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <string>
+#include <unistd.h>
 #include <vector>
 
 #define VERSION_STRING STRINGIFY(VERSION_MAJOR) "." STRINGIFY(VERSION_MINOR) "." STRINGIFY(VERSION_PATCH)
@@ -314,6 +318,172 @@ void step(void)
     }
 }
 
+#define NCSI_TRACE_BUCKETS (16u)
+
+typedef struct
+{
+    uint32_t count;
+    uint32_t failed;
+    uint32_t min;
+    uint32_t max;
+    uint64_t total;
+    uint32_t buckets[NCSI_TRACE_BUCKETS];
+} ncsi_trace_stats_t;
+
+typedef struct
+{
+    uint32_t sequence; /* Trace index of the entry, the slot is sequence % entries */
+    uint32_t command;  /* NcsiTraceCommand */
+    uint32_t elapsed;
+} ncsi_trace_sample_t;
+
+static ncsi_trace_sample_t ncsi_trace_read(uint32_t sequence)
+{
+    const uint32_t slot = sequence % ARRAY_ELEMENTS(SHM.NcsiTraceStart);
+    ncsi_trace_sample_t sample;
+
+    sample.sequence = sequence;
+    sample.command = (uint32_t)SHM.NcsiTraceCommand[slot].r32;
+    sample.elapsed = (uint32_t)SHM.NcsiTraceEnd[slot].r32 - (uint32_t)SHM.NcsiTraceStart[slot].r32;
+
+    return sample;
+}
+
+static void ncsi_trace_record(map<uint8_t, ncsi_trace_stats_t> &stats, const ncsi_trace_sample_t &sample)
+{
+    RegSHMNcsiTraceCommand_t entry;
+    entry.r32 = sample.command;
+    uint32_t elapsed = sample.elapsed;
+
+    uint8_t command = (uint8_t)entry.bits.Command;
+    if (stats.find(command) == stats.end())
+    {
+        ncsi_trace_stats_t empty = {};
+        empty.min = UINT32_MAX;
+        stats[command] = empty;
+    }
+    ncsi_trace_stats_t &cmd = stats[command];
+
+    cmd.count++;
+    if (0 != entry.bits.ResponseCode)
+    {
+        cmd.failed++;
+    }
+    cmd.total += elapsed;
+    cmd.min = min(cmd.min, elapsed);
+    cmd.max = max(cmd.max, elapsed);
+
+    // Power of two buckets: [0, 1], [2, 3], [4, 7], ...
+    uint32_t bucket = 0;
+    while (elapsed > 1 && bucket < NCSI_TRACE_BUCKETS - 1)
+    {
+        elapsed >>= 1;
+        bucket++;
+    }
+    cmd.buckets[bucket]++;
+}
+
+void print_ncsi_trace(int polls)
+{
+    const uint32_t entries = ARRAY_ELEMENTS(SHM.NcsiTraceStart);
+    map<uint8_t, ncsi_trace_stats_t> stats;
+    uint32_t dropped = 0;
+
+    // Start with whatever is currently in the ring.
+    uint32_t index = (uint32_t)SHM.NcsiTraceIndex.r32;
+    uint32_t last = (index > entries) ? (index - entries) : 0;
+
+    for (int poll = 0; poll < polls; poll++)
+    {
+        if (poll)
+        {
+            usleep(10000);
+            index = (uint32_t)SHM.NcsiTraceIndex.r32;
+        }
+
+        if (index < last)
+        {
+            // The APE was reset, start over.
+            last = 0;
+        }
+        if (index - last > entries)
+        {
+            dropped += (index - last) - entries;
+            last = index - entries;
+        }
+
+        vector<ncsi_trace_sample_t> batch;
+        for (; last != index; last++)
+        {
+            batch.push_back(ncsi_trace_read(last));
+        }
+
+        // The APE keeps writing while the batch is read. Drop every entry whose slot may have been reused
+        // since, including the slot that is being written for the next index.
+        uint32_t current = (uint32_t)SHM.NcsiTraceIndex.r32;
+        uint32_t oldest = (current >= entries) ? (current - entries + 1) : 0;
+        for (auto const &sample : batch)
+        {
+            if (current < index || sample.sequence < oldest)
+            {
+                dropped++;
+            }
+            else
+            {
+                ncsi_trace_record(stats, sample);
+            }
+        }
+    }
+
+    printf("NC-SI commands traced: %u (%u not sampled)\n", (uint32_t)SHM.NcsiTraceIndex.r32, dropped);
+    for (auto const &it : stats)
+    {
+        const ncsi_trace_stats_t &cmd = it.second;
+        printf("\nCommand 0x%02X: %u samples, %u failed, min %uus, avg %uus, max %uus\n", it.first, cmd.count, cmd.failed, cmd.min,
+               (uint32_t)(cmd.total / cmd.count), cmd.max);
+        for (uint32_t i = 0; i < NCSI_TRACE_BUCKETS; i++)
+        {
+            if (cmd.buckets[i])
+            {
+                uint32_t low = i ? (1u << i) : 0;
+                uint32_t high = (i == NCSI_TRACE_BUCKETS - 1) ? UINT32_MAX : ((2u << i) - 1);
+                printf("  %6u - %10uus: %u\n", low, high, cmd.buckets[i]);
+            }
+        }
+    }
+}
+
+void print_drain_stats(int seconds)
+{
+    VOLATILE SHM_CHANNEL_t *channels[] = { &SHM_CHANNEL0, &SHM_CHANNEL1, &SHM_CHANNEL2, &SHM_CHANNEL3 };
+    uint32_t to_network = 0;
+    uint32_t to_bmc = 0;
+
+    printf("Drain budget: %u frames, %uus\n", (uint32_t)SHM.DrainBudget.bits.Frames, (uint32_t)SHM.DrainBudget.bits.Time);
+
+    uint32_t bmc_exhausted = (uint32_t)SHM.DrainBmcExhausted.r32;
+    uint32_t network_exhausted = (uint32_t)SHM.DrainNetworkExhausted.r32;
+    for (size_t i = 0; i < ARRAY_ELEMENTS(channels); i++)
+    {
+        // NcsiRx also counts NC-SI commands, only pass-through frames go to the network.
+        to_network -= (uint32_t)channels[i]->NcsiChannelNcsiRx.r32 - (uint32_t)channels[i]->NcsiChannelNcsiCommands.r32;
+        to_bmc -= (uint32_t)channels[i]->NcsiChannelNetworkRx.r32;
+    }
+
+    sleep(seconds);
+
+    bmc_exhausted = (uint32_t)SHM.DrainBmcExhausted.r32 - bmc_exhausted;
+    network_exhausted = (uint32_t)SHM.DrainNetworkExhausted.r32 - network_exhausted;
+    for (size_t i = 0; i < ARRAY_ELEMENTS(channels); i++)
+    {
+        to_network += (uint32_t)channels[i]->NcsiChannelNcsiRx.r32 - (uint32_t)channels[i]->NcsiChannelNcsiCommands.r32;
+        to_bmc += (uint32_t)channels[i]->NcsiChannelNetworkRx.r32;
+    }
+
+    printf("BMC to network: %u frames/s, budget exhausted %u times/s\n", to_network / seconds, bmc_exhausted / seconds);
+    printf("Network to BMC: %u frames/s, budget exhausted %u times/s\n", to_bmc / seconds, network_exhausted / seconds);
+}
+
 int main(int argc, char const *argv[])
 {
     OptionParser parser = OptionParser().description("BCM Register Utility v" VERSION_STRING);
@@ -369,6 +539,10 @@ int main(int argc, char const *argv[])
 
     parser.add_option("-m", "--mii").dest("mii").set_default("0").action("store_true").help("Print MII information registers.");
 
+    parser.add_option("--ncsitrace").dest("ncsitrace").metavar("POLLS").help("Print NC-SI command latency histograms, sampling POLLS times.");
+
+    parser.add_option("--drainstats").dest("drainstats").metavar("SECONDS").help("Measure passthrough frames per second over SECONDS.");
+
     parser.add_option("-d", "--dumpregs").dest("dumpregs").set_default("0").action("store_true").help("Dump main device and APE registers.");
 
     optparse::Values options = parser.parse_args(argc, argv);
@@ -743,6 +917,20 @@ int main(int argc, char const *argv[])
         exit(0);
     }
 
+    if (options.is_set("drainstats"))
+    {
+        print_drain_stats(max(1, stoi(options["drainstats"], nullptr, 0)));
+
+        exit(0);
+    }
+
+    if (options.is_set("ncsitrace"))
+    {
+        print_ncsi_trace(max(1, stoi(options["ncsitrace"], nullptr, 0)));
+
+        exit(0);
+    }
+
     if (options.get("dumpregs"))
     {
         DEVICE.print();
@@ -790,7 +978,8 @@ int main(int argc, char const *argv[])
         RegMIIStatus_t stat;
 
         uint8_t phy = MII_getPhy(&DEVICE);
-        APE_aquireLock();
+        uint8_t function = DEVICE.Status.bits.FunctionNumber;
+        APE_aquireLock(function);
         uint16_t status_value = MII_readRegister(&DEVICE, phy, (mii_reg_t)REG_MII_STATUS);
         stat.r16 = status_value;
         stat.print();
@@ -802,7 +991,7 @@ int main(int argc, char const *argv[])
             ext_stat.print();
         }
 
-        APE_releaseLock();
+        APE_releaseLock(function);
 
         exit(0);
     }